@@ -60,13 +60,29 @@ public:
         EventQueue::Priority priority, const std::shared_ptr<FileDescriptorListener>& listener);
     LOCAL_API void EraseFileDescriptorMap(int32_t fileDescriptor);
     LOCAL_API std::shared_ptr<FileDescriptorInfo> GetFileDescriptorMap(int32_t fileDescriptor) override;
+
+    /**
+     * Wake up at the exact nanosecond instead of rounding the timeout up to milliseconds.
+     * Use epoll_pwait2 if the kernel supports it, otherwise arm a timerfd.
+     *
+     * @param enable Enable high resolution or not.
+     */
+    LOCAL_API void SetHighResolution(bool enable) final;
 private:
     LOCAL_API void DrainAwakenPipe() const;
+    LOCAL_API int32_t WaitEpoll(struct epoll_event *events, int32_t maxEvents, int64_t nanoseconds);
+    LOCAL_API int32_t WaitEpollWithTimer(struct epoll_event *events, int32_t maxEvents, int64_t nanoseconds);
+    LOCAL_API void DrainTimer() const;
 
     // File descriptor for epoll.
     int32_t epollFd_{-1};
     // File descriptor used to wake up epoll.
     int32_t awakenFd_{-1};
+    // Timer used to wake up epoll in high resolution mode, created on demand.
+    int32_t timerFd_{-1};
+    std::atomic<bool> highResolution_{false};
+    // Cleared once epoll_pwait2 fails with ENOSYS.
+    bool pwait2Supported_{true};
     std::mutex fileDescriptorMapLock;
     FileDescriptorEventCallback callback_;
     std::atomic<int32_t> waitingCount_{0};
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BASE_EVENTHANDLER_FRAMEWORKS_EVENTHANDLER_INCLUDE_EVENT_DUMP_SNAPSHOT_H
+#define BASE_EVENTHANDLER_FRAMEWORKS_EVENTHANDLER_INCLUDE_EVENT_DUMP_SNAPSHOT_H
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <vector>
+
+#include "inner_event.h"
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+/*
+ * Formats times in the same way as 'InnerEvent::DumpTimeToString'.
+ * The offset between steady clock and system clock is taken once, and localtime is only called when the second
+ * changes, which makes formatting times of many events with nearby times cheap.
+ */
+class DumpTimeFormatter final {
+public:
+    DumpTimeFormatter();
+    ~DumpTimeFormatter() = default;
+    DISALLOW_COPY_AND_MOVE(DumpTimeFormatter);
+
+    /**
+     * Format a time point of steady clock.
+     *
+     * @param time Time point to format.
+     * @return Returns the formatted time, such as '2026-01-01 08:00:00.123'.
+     */
+    std::string Format(const InnerEvent::TimePoint &time);
+
+private:
+    std::chrono::system_clock::time_point systemNow_;
+    InnerEvent::TimePoint steadyNow_;
+    std::time_t cachedSecond_ {0};
+    bool cached_ {false};
+    std::string cachedPrefix_;
+};
+
+/*
+ * Copy of pending events taken under the queue lock, so that they could be formatted after the lock is released.
+ * Records are plain values, names of tasks and string event ids are packed into one buffer.
+ */
+class EventDumpSnapshot final {
+public:
+    // VIP, IMMEDIATE, HIGH, LOW and IDLE.
+    static constexpr uint32_t QUEUE_NUM = 5;
+
+    enum : uint32_t {
+        FLAG_HAS_OWNER = 1u << 0,
+        FLAG_HAS_TASK = 1u << 1,
+        FLAG_STRING_EVENT_ID = 1u << 2,
+    };
+
+    struct Record {
+        uint64_t senderKernelThreadId;
+        InnerEvent::TimePoint sendTime;
+        InnerEvent::TimePoint handleTime;
+        int64_t param;
+        uint64_t uniqueId;
+        Caller caller;
+        uint32_t innerEventId;
+        // Task name or string event id, in the name buffer.
+        uint32_t nameOffset;
+        uint32_t nameLength;
+        uint32_t flags;
+    };
+
+    /**
+     * Create an empty snapshot.
+     *
+     * @param maxEventsPerQueue Max number of events recorded for each queue.
+     * @param maxEvents Max number of events recorded for all queues, in the order of queues.
+     */
+    EventDumpSnapshot(uint32_t maxEventsPerQueue, uint32_t maxEvents);
+    ~EventDumpSnapshot() = default;
+    DISALLOW_COPY_AND_MOVE(EventDumpSnapshot);
+
+    /**
+     * Count an event and record it if limits are not reached, called under the queue lock.
+     *
+     * @param queue Index of the queue which holds the event.
+     * @param event The event.
+     */
+    void Add(uint32_t queue, InnerEvent &event);
+
+    inline uint32_t GetCount(uint32_t queue) const
+    {
+        return counts_[queue];
+    }
+
+    inline const std::vector<Record> &GetRecords(uint32_t queue) const
+    {
+        return records_[queue];
+    }
+
+    inline uint32_t GetTotalCount() const
+    {
+        return totalCount_;
+    }
+
+    /**
+     * Format a record, the result is the same as 'InnerEvent::Dump' of the event.
+     *
+     * @param record Record to format.
+     * @param formatter Formatter of times.
+     * @return Returns the formatted event, ending with a line separator.
+     */
+    std::string Format(const Record &record, DumpTimeFormatter &formatter) const;
+
+private:
+    void AppendName(Record &record, const std::string &name);
+
+    uint32_t maxEventsPerQueue_;
+    uint32_t maxEvents_;
+    uint32_t totalCount_ {0};
+    uint32_t recordedCount_ {0};
+    uint32_t counts_[QUEUE_NUM] {};
+    std::vector<Record> records_[QUEUE_NUM];
+    std::string names_;
+};
+}  // namespace AppExecFwk
+}  // namespace OHOS
+
+#endif  // #ifndef BASE_EVENTHANDLER_FRAMEWORKS_EVENTHANDLER_INCLUDE_EVENT_DUMP_SNAPSHOT_H
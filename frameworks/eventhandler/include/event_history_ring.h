@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BASE_EVENTHANDLER_FRAMEWORKS_EVENTHANDLER_INCLUDE_EVENT_HISTORY_RING_H
+#define BASE_EVENTHANDLER_FRAMEWORKS_EVENTHANDLER_INCLUDE_EVENT_HISTORY_RING_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+/*
+ * Ring of fixed size records about dispatched events, written by the runner thread without any lock,
+ * and read by dumping threads.
+ * Each slot is a seqlock, readers retry or skip a slot which is being written. Names are interned into ids by the
+ * writer, so that recording an event never formats or copies strings, except for the first time a name is seen.
+ * Once MAX_NAME_NUM names are interned, new names are copied into the record, truncated to MAX_INLINE_NAME_LEN.
+ */
+class EventHistoryRing final {
+public:
+    static constexpr uint32_t MAX_DEPTH = 4096;
+    static constexpr uint32_t MAX_NAME_NUM = 1024;
+    static constexpr uint32_t MAX_INLINE_NAME_LEN = 39;
+    static constexpr int64_t NOT_COMPLETED = INT64_MAX;
+
+    enum : uint32_t {
+        FLAG_HAS_TASK = 1u << 0,
+        FLAG_STRING_EVENT_ID = 1u << 1,
+        // Name is kept in 'inlineName' instead of the interned names.
+        FLAG_INLINE_NAME = 1u << 2,
+    };
+
+    // Times are counts of InnerEvent::Clock since its epoch.
+    struct Record {
+        uint64_t senderKernelThreadId;
+        int64_t sendTime;
+        int64_t handleTime;
+        int64_t triggerTime;
+        int64_t completeTime;
+        uint32_t innerEventId;
+        // Task name or string event id.
+        uint32_t nameId;
+        // Caller strings are literals or interned for the whole process, so pointers are kept as is.
+        const char *callerFile;
+        const char *callerFunc;
+        const char *callerDfxName;
+        int32_t callerLine;
+        int32_t priority;
+        uint32_t flags;
+        uint32_t reserved;
+        char inlineName[MAX_INLINE_NAME_LEN + 1];
+    };
+
+    /**
+     * Create a ring.
+     *
+     * @param depth Number of records, rounded up to power of 2 and limited by MAX_DEPTH.
+     */
+    explicit EventHistoryRing(uint32_t depth);
+    ~EventHistoryRing() = default;
+    DISALLOW_COPY_AND_MOVE(EventHistoryRing);
+
+    inline uint32_t Depth() const
+    {
+        return mask_ + 1;
+    }
+
+    /**
+     * Record an event which starts running, only called by the writer.
+     *
+     * @param record Record of the event.
+     */
+    void Begin(const Record &record);
+
+    /**
+     * Set complete time of the event recorded by the last 'Begin', only called by the writer.
+     *
+     * @param completeTime Complete time of the event.
+     */
+    void Complete(int64_t completeTime);
+
+    /**
+     * Read a consistent copy of a record, may be called by any thread.
+     *
+     * @param index Index of the slot.
+     * @param record Copy of the record.
+     * @return Returns false if the slot is never written or it is always being written while reading.
+     */
+    bool Read(uint32_t index, Record &record) const;
+
+    /**
+     * Get id of a string, only called by the writer.
+     * Empty string and strings after MAX_NAME_NUM ones are interned take id 0, which is empty string.
+     *
+     * @param name String to intern.
+     * @return Returns id of the string.
+     */
+    uint32_t Intern(const std::string &name);
+
+    /**
+     * Set name of a record, only called by the writer.
+     * The name is interned if possible, otherwise a truncated copy is kept in the record.
+     *
+     * @param name Task name or string event id.
+     * @param record Record of the event.
+     */
+    void SetName(const std::string &name, Record &record);
+
+    /**
+     * Get name of a record set by 'SetName', may be called by any thread.
+     *
+     * @param record Record read by 'Read'.
+     * @return Returns the name.
+     */
+    std::string GetName(const Record &record) const;
+
+    /**
+     * Get string of an id, may be called by any thread.
+     *
+     * @param id Id returned by 'Intern'.
+     * @return Returns the interned string.
+     */
+    std::string GetName(uint32_t id) const;
+
+private:
+    static constexpr size_t RECORD_WORDS = sizeof(Record) / sizeof(uint64_t);
+    static_assert(sizeof(Record) % sizeof(uint64_t) == 0, "Record must be made of whole words");
+
+    // Fields are copied word by word with relaxed atomics, so that a racing read is not undefined behavior.
+    struct Slot {
+        std::atomic<uint32_t> sequence {0};
+        std::atomic<uint64_t> words[RECORD_WORDS];
+    };
+
+    void Store(Slot &slot, const Record &record);
+
+    std::unique_ptr<Slot[]> slots_;
+    uint32_t mask_ {0};
+    // Only accessed by the writer.
+    uint32_t writeIndex_ {0};
+    Record current_ {};
+    std::unordered_map<std::string, uint32_t> nameIds_;
+    // Names are only appended by the writer under the lock, readers look them up under the lock.
+    mutable std::mutex namesLock_;
+    std::vector<std::string> names_;
+};
+}  // namespace AppExecFwk
+}  // namespace OHOS
+
+#endif  // #ifndef BASE_EVENTHANDLER_FRAMEWORKS_EVENTHANDLER_INCLUDE_EVENT_HISTORY_RING_H
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BASE_EVENTHANDLER_FRAMEWORKS_EVENTHANDLER_INCLUDE_EVENT_INBOX_H
+#define BASE_EVENTHANDLER_FRAMEWORKS_EVENTHANDLER_INCLUDE_EVENT_INBOX_H
+
+#include <atomic>
+#include <functional>
+
+#include "inner_event.h"
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+/*
+ * Lock free inbox of events, any thread may push events into it.
+ * Events are linked into a stack by compare and swap, and the consumer takes the whole stack at once and reverses it,
+ * so events are drained in the order of pushing and there is never a half linked event to wait for.
+ */
+class EventInbox final {
+public:
+    using Consumer = std::function<void(InnerEvent::Pointer &)>;
+
+    EventInbox() = default;
+    ~EventInbox();
+    DISALLOW_COPY_AND_MOVE(EventInbox);
+
+    /**
+     * Push an event, the event is moved into the inbox.
+     *
+     * @param event Event to push.
+     * @return Returns true if the inbox was empty before pushing.
+     */
+    bool Push(InnerEvent::Pointer &event);
+
+    /**
+     * Take out all events in the order of pushing.
+     *
+     * @param consumer Consumer of events, events not moved out by the consumer are released.
+     * @return Returns the number of events.
+     */
+    size_t Drain(const Consumer &consumer);
+
+    inline bool Empty() const
+    {
+        return head_.load(std::memory_order_acquire) == nullptr;
+    }
+
+private:
+    std::atomic<InnerEvent *> head_ {nullptr};
+};
+}  // namespace AppExecFwk
+}  // namespace OHOS
+
+#endif  // #ifndef BASE_EVENTHANDLER_FRAMEWORKS_EVENTHANDLER_INCLUDE_EVENT_INBOX_H
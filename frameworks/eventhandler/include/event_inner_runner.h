@@ -16,6 +16,8 @@
 #ifndef BASE_EVENTHANDLER_FRAMEWORKS_EVENTHANDLER_INCLUDE_EVENT_INNER_RUNNER_H
 #define BASE_EVENTHANDLER_FRAMEWORKS_EVENTHANDLER_INCLUDE_EVENT_INNER_RUNNER_H
 
+#include <thread>
+
 #include "event_handler_utils.h"
 #include "event_queue.h"
 #include "event_runner.h"
@@ -61,6 +63,17 @@ public:
         return kernelThreadId_;
     }
 
+    LOCAL_API virtual bool IsCurrentThread()
+    {
+        return std::this_thread::get_id() == threadId_;
+    }
+
+    // Events of different handlers are distributed by several threads at the same time.
+    LOCAL_API virtual bool IsConcurrent() const
+    {
+        return false;
+    }
+
 protected:
     std::shared_ptr<EventQueue> queue_;
     std::weak_ptr<EventRunner> owner_;
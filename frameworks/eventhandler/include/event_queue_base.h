@@ -17,11 +17,18 @@
 #define BASE_EVENTHANDLER_INTERFACES_INNER_API_EVENT_QUEUE_BASE_H
 
 #include <array>
+#include <deque>
 #include <list>
 #include <map>
 #include <mutex>
+#include <unordered_set>
+#include <vector>
 
+#include "event_dump_snapshot.h"
+#include "event_history_ring.h"
+#include "event_inbox.h"
 #include "event_queue.h"
+#include "pending_event_store.h"
 
 #define LOCAL_API __attribute__((visibility ("hidden")))
 namespace OHOS {
@@ -40,7 +47,7 @@ struct CurrentRunningEvent {
     int64_t param_{0};
     bool hasTask_{false};
     std::string taskName_;
-    std::string callerInfo_;
+    Caller caller_;
     InnerEvent::EventId innerEventId_ = 0u;
     CurrentRunningEvent();
     CurrentRunningEvent(InnerEvent::TimePoint time, InnerEvent::Pointer &event);
@@ -70,6 +77,51 @@ public:
         EventInsertType insertType = EventInsertType::AT_END,
         VsyncBarrierOption option = VsyncBarrierOption::NO_BARRIER) override;
 
+    /**
+     * Insert events into event queue at the end, with one lock acquisition and at most one wakeup.
+     *
+     * @param items Events and their priority, inserted events are moved out of items.
+     * @return Returns true if all events are inserted.
+     */
+    bool InsertEvents(std::vector<InsertItem> &items) override;
+
+    /**
+     * Insert an event, or merge it into the pending event with the same key from the same handler.
+     * Coalesced events skip the inbox, since the pending event must be looked up under the lock.
+     *
+     * @param event Event instance which should be added into event queue, released if merged.
+     * @param priority Priority of the event.
+     * @param key Key of the event, shared by events and tasks of the handler.
+     * @param policy How to merge the event into the pending one.
+     * @return Returns true if the event is inserted or merged.
+     */
+    bool InsertCoalesced(InnerEvent::Pointer &event, Priority priority, uint64_t key, CoalescePolicy policy) override;
+
+    /**
+     * Remove a pending event which a task handle is returned for, without scanning the queue.
+     *
+     * @param eventUniqueId Unique id of the event.
+     * @return Returns true if the event is removed.
+     */
+    bool CancelByHandle(uint64_t eventUniqueId) override;
+
+    /**
+     * Check whether an event which a task handle is returned for is still pending.
+     *
+     * @param eventUniqueId Unique id of the event.
+     * @return Returns true if the event is pending.
+     */
+    bool IsPendingByHandle(uint64_t eventUniqueId) override;
+
+    /**
+     * Move a pending event which a task handle is returned for into another priority.
+     *
+     * @param eventUniqueId Unique id of the event.
+     * @param priority New priority of the event.
+     * @return Returns true if the event is pending and moved.
+     */
+    bool ReprioritizeByHandle(uint64_t eventUniqueId, Priority priority) override;
+
     /**
      * Remove events if its owner is invalid.
      */
@@ -184,6 +236,20 @@ public:
 
     LOCAL_API void PushHistoryQueueAfterDistribute() override;
 
+    /**
+     * Set depth of the dispatch history, takes effect when the runner dispatches the next event.
+     *
+     * @param depth Number of events kept in the history, 0 disables the history.
+     */
+    LOCAL_API void SetHistoryDepth(uint32_t depth) override;
+
+    /**
+     * Set how many pending events of each priority are dumped by 'Dump' and 'DumpQueueInfo'.
+     *
+     * @param maxEvents Max number of events of each priority, the rest are only counted.
+     */
+    LOCAL_API void SetMaxDumpEventsPerPriority(uint32_t maxEvents) override;
+
     LOCAL_API bool HasPreferEvent(int basePrio) override;
 
     LOCAL_API std::string DumpCurrentQueueSize() override;
@@ -249,6 +315,9 @@ public:
     void HandleFileDescriptorEvent(int32_t fileDescriptor, uint32_t events, const std::string &name,
         Priority priority);
 
+    bool RecordReadyFileDescriptor(int32_t fileDescriptor, uint32_t events,
+        const std::shared_ptr<FileDescriptorListener> &listener, Priority priority) override;
+
     /**
      * notify observer current vip events is done.
      *
@@ -283,9 +352,44 @@ public:
      * @param usable current usable.
      */
     void SetUsable(bool usable);
+
+    /**
+     * Enable or disable the lock free inbox.
+     *
+     * @param enable Enable or not.
+     */
+    void SetInboxEnabled(bool enable) override;
+
+    /**
+     * Let several threads get events from the queue, must be called before any of them starts.
+     * Events of one owner are still handled one by one in order: while an event of the owner is being handled,
+     * other events of the owner are not picked until {@link #ReleaseOwner} is called. File descriptor listeners
+     * are not supported and the distribute history is not recorded, both of them expect a single thread.
+     *
+     * @param enable Enable or not.
+     */
+    void SetMultiConsumer(bool enable);
+
+    /**
+     * Called after an event is handled in multi consumer mode, so that the next event of its owner can be picked.
+     *
+     * @param ownerId Id of the owner of the handled event.
+     */
+    void ReleaseOwner(uint64_t ownerId);
+
+    /**
+     * Take an owner in multi consumer mode if it is not busy, to handle its events out of the queue, such as a sync
+     * event sent from a consumer. Call {@link #ReleaseOwner} after that.
+     *
+     * @param ownerId Id of the owner.
+     * @return Returns true if the owner is taken.
+     */
+    bool TryAcquireOwner(uint64_t ownerId);
 private:
-    using RemoveFilter = std::function<bool(const InnerEvent::Pointer &)>;
-    using HasFilter = std::function<bool(const InnerEvent::Pointer &)>;
+    using RemoveFilter = PendingEventStore::IndexFilter;
+    // Move out events from a store through its owner index, returns the number of removed events.
+    using StoreRemover = std::function<size_t(PendingEventStore &, std::list<InnerEvent::Pointer> &)>;
+    using StoreMatcher = std::function<bool(const PendingEventStore &)>;
 
     /**
      * Confirm whether it can enter barrier mode
@@ -307,7 +411,7 @@ private:
         InnerEvent::TimePoint triggerTime;
         InnerEvent::TimePoint completeTime;
         int32_t priority = -1;
-        std::string callerInfo_;
+        Caller caller;
     };
 
     /*
@@ -320,29 +424,62 @@ private:
     static const uint32_t SUB_EVENT_QUEUE_NUM = static_cast<uint32_t>(Priority::IDLE);
 
     struct SubEventQueue {
-        std::list<InnerEvent::Pointer> queue;
+        std::unique_ptr<PendingEventStore> queue {PendingEventStore::Create()};
         uint32_t handledEventsCount{0};
         uint32_t maxHandledEventsCount{DEFAULT_MAX_HANDLED_EVENT_COUNT};
         uint64_t frontEventHandleTime = UINT64_MAX;
     };
 
-    LOCAL_API void Remove(const RemoveFilter &filter);
+    LOCAL_API bool InsertIntoInbox(InnerEvent::Pointer &event, Priority priority);
+    LOCAL_API bool InsertLocked(InnerEvent::Pointer &event, Priority priority, EventInsertType insertType);
+    LOCAL_API void OnVipTaskInsertedLocked();
+    LOCAL_API PendingEventStore *GetStoreLocked(Priority priority);
+    LOCAL_API InnerEvent *FindWithHandleLocked(uint64_t eventUniqueId, Priority &priority);
+    LOCAL_API InnerEvent::Pointer RemoveFromStoreLocked(InnerEvent &event, Priority priority);
+    LOCAL_API void DrainInboxLocked();
+    LOCAL_API InnerEvent::Pointer PickReadyFileDescriptorEventLocked(const InnerEvent::TimePoint &now);
+    LOCAL_API size_t Remove(const StoreRemover &remover);
     LOCAL_API void RemoveOrphan(const RemoveFilter &filter);
-    LOCAL_API bool HasInnerEvent(const HasFilter &filter);
+    LOCAL_API bool HasInnerEvent(const StoreMatcher &matcher);
     LOCAL_API InnerEvent::Pointer PickFirstVsyncEventLocked();
     LOCAL_API InnerEvent::Pointer PickEventLocked(const InnerEvent::TimePoint &now,
         InnerEvent::TimePoint &nextWakeUpTime);
     LOCAL_API InnerEvent::Pointer GetExpiredEventLocked(InnerEvent::TimePoint &nextExpiredTime);
-    LOCAL_API std::string HistoryQueueDump(const HistoryEvent &historyEvent);
-    LOCAL_API std::string DumpCurrentRunning();
+    LOCAL_API bool IsMultiConsumerLocked() const override;
+    LOCAL_API bool IsOwnerBusyLocked(const InnerEvent &event) const;
+    LOCAL_API void AcquireOwnerLocked(const InnerEvent &event);
+    LOCAL_API bool CheckIdleOwnerEventInListLocked(const PendingEventStore &events, const InnerEvent::TimePoint &now,
+        InnerEvent::TimePoint &nextWakeUpTime);
+    LOCAL_API InnerEvent::Pointer PopFirstIdleOwnerEventLocked(PendingEventStore &events,
+        const InnerEvent::TimePoint &now);
+    LOCAL_API void ApplyHistoryDepth();
+    LOCAL_API void DecodeHistoryRecord(const EventHistoryRing::Record &record, HistoryEvent &historyEvent);
+    LOCAL_API std::string HistoryQueueDump(const HistoryEvent &historyEvent, DumpTimeFormatter &formatter);
+    LOCAL_API std::string DumpCurrentRunning(const CurrentRunningEvent &running, DumpTimeFormatter &formatter);
     LOCAL_API void DumpCurrentRunningEventId(const InnerEvent::EventId &innerEventId, std::string &content);
-    LOCAL_API void DumpCurentQueueInfo(Dumper &dumper, uint32_t dumpMaxSize);
+    LOCAL_API void CaptureEventsLocked(EventDumpSnapshot &snapshot);
+    LOCAL_API void DumpCurentQueueInfo(Dumper &dumper, const EventDumpSnapshot &snapshot,
+        DumpTimeFormatter &formatter);
 
     // Sub event queues for different priority.
     std::array<SubEventQueue, SUB_EVENT_QUEUE_NUM> subEventQueues_;
 
     // Event queue for IDLE events.
-    std::list<InnerEvent::Pointer> idleEvents_;
+    std::unique_ptr<PendingEventStore> idleEvents_ {PendingEventStore::Create()};
+
+    // Pending events of listeners in direct dispatch mode, kept after dispatching to avoid allocation next time.
+    struct ReadyFileDescriptor {
+        std::weak_ptr<FileDescriptorListener> listener;
+        uint32_t events {0};
+        Priority priority {Priority::HIGH};
+    };
+    std::map<int32_t, ReadyFileDescriptor> readyFileDescriptors_;
+    // File descriptors with pending events, in the order of readiness.
+    std::deque<int32_t> readyOrder_;
+
+    // Events sent from other threads, not inserted into sub event queues yet.
+    EventInbox inbox_;
+    std::atomic<bool> inboxEnabled_ {false};
 
     // Next wake up time when block in 'GetEvent'.
     InnerEvent::TimePoint wakeUpTime_ { InnerEvent::TimePoint::max() };
@@ -355,13 +492,24 @@ private:
     // current running event info
     CurrentRunningEvent currentRunningEvent_;
 
-    static const uint8_t HISTORY_EVENT_NUM_POWER = 32; // 必须是2的幂次，使用位运算取余
-    std::vector<HistoryEvent> historyEvents_;
-    uint8_t historyEventIndex_ = 0;
+    static const uint32_t DEFAULT_HISTORY_DEPTH = 32;
+    static const uint32_t NO_HISTORY_DEPTH_REQUEST = UINT32_MAX;
+    // Written by the runner thread without lock, replaced by the runner thread under the queue lock.
+    std::unique_ptr<EventHistoryRing> historyRing_;
+    std::atomic<uint32_t> historyDepthRequest_ {NO_HISTORY_DEPTH_REQUEST};
+    std::atomic<uint32_t> maxDumpEventsPerPriority_ {UINT32_MAX};
+
+    // Number of coalesced events which replaced a pending one, or were dropped, modified under the queue lock.
+    uint64_t coalescedReplacedCount_ {0};
+    uint64_t coalescedDroppedCount_ {0};
 
     bool isExistVipTask_ {false};
 
-    std::mutex historyLock_;
+    // Owners with an event being handled by one of the consumers, only used in multi consumer mode.
+    bool multiConsumer_ {false};
+    std::unordered_set<uint64_t> busyOwners_;
+    // Set if due events are skipped for busy owners, so that releasing an owner wakes up a consumer.
+    bool waitingForOwner_ {false};
 };
 }  // namespace AppExecFwk
 }  // namespace OHOS
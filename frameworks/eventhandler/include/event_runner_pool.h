@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BASE_EVENTHANDLER_FRAMEWORKS_EVENTHANDLER_INCLUDE_EVENT_RUNNER_POOL_H
+#define BASE_EVENTHANDLER_FRAMEWORKS_EVENTHANDLER_INCLUDE_EVENT_RUNNER_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <vector>
+
+#include "inner_event.h"
+#include "io_waiter.h"
+#include "nocopyable.h"
+
+#define LOCAL_API __attribute__((visibility ("hidden")))
+namespace OHOS {
+namespace AppExecFwk {
+/*
+ * Work which runs on the workers of 'EventRunnerPool' in slices, such as a runner of 'ThreadMode::POOL'.
+ * A runnable is queued at most once, and runs on one worker at a time, so its work stays serial.
+ */
+class PoolRunnable : public std::enable_shared_from_this<PoolRunnable> {
+public:
+    PoolRunnable() = default;
+    virtual ~PoolRunnable() = default;
+    DISALLOW_COPY_AND_MOVE(PoolRunnable);
+
+    /**
+     * Ask for a slice, because new work has arrived. Called by any thread.
+     */
+    LOCAL_API void Wake();
+
+protected:
+    /**
+     * Run due work on the current worker, for a bounded number of steps.
+     *
+     * @param hasMore Set to true if the budget is used up while work is still due.
+     * @return Returns the time when work is due next, or 'TimePoint::max()' if there is none.
+     */
+    LOCAL_API virtual InnerEvent::TimePoint RunSlice(bool &hasMore) = 0;
+
+private:
+    friend class EventRunnerPool;
+
+    // States of 'state_'.
+    static constexpr uint32_t STATE_IDLE = 0;
+    static constexpr uint32_t STATE_QUEUED = 1;
+    static constexpr uint32_t STATE_RUNNING = 2;
+    // Woken up while running, so queue it again after the slice.
+    static constexpr uint32_t STATE_RUNNING_WOKEN = 3;
+
+    LOCAL_API bool MarkQueued();
+
+    std::atomic<uint32_t> state_ {STATE_IDLE};
+    // Earliest armed timer of this runnable, guarded by the lock of the pool.
+    InnerEvent::TimePoint timerDeadline_ {InnerEvent::TimePoint::max()};
+};
+
+/*
+ * Bounded pool of worker threads shared by all runners of 'ThreadMode::POOL'.
+ * Runnables are queued in FIFO order while they have due work, and delayed work arms a timer of the pool instead of
+ * keeping a thread asleep. The pool lives until the process exits.
+ */
+class EventRunnerPool final {
+public:
+    DISALLOW_COPY_AND_MOVE(EventRunnerPool);
+
+    LOCAL_API static EventRunnerPool &GetInstance();
+
+    /**
+     * Get the number of worker threads.
+     *
+     * @return Returns the number of worker threads.
+     */
+    LOCAL_API inline size_t GetWorkerNum() const
+    {
+        return workerNum_;
+    }
+
+    /**
+     * Mark the current worker blocked in waiting for other work, such as a sync event sent to another runner.
+     * Another worker is started if needed meanwhile, so that runners in the pool waiting for each other in a chain
+     * do not use up the workers. Not applied to threads out of the pool.
+     *
+     * @return Returns true if the current thread is a worker of the pool, then call {@link #EndBlocking} later.
+     */
+    LOCAL_API static bool BeginBlocking();
+
+    /**
+     * Mark the current worker not blocked any longer, the workers started meanwhile quit after a while.
+     */
+    LOCAL_API static void EndBlocking();
+
+private:
+    friend class PoolRunnable;
+
+    struct Timer {
+        InnerEvent::TimePoint deadline;
+        std::weak_ptr<PoolRunnable> runnable;
+
+        bool operator>(const Timer &other) const
+        {
+            return deadline > other.deadline;
+        }
+    };
+
+    EventRunnerPool();
+    ~EventRunnerPool() = default;
+
+    LOCAL_API void Enqueue(std::shared_ptr<PoolRunnable> runnable);
+    LOCAL_API void StartWorkerLocked();
+    LOCAL_API void WorkerMain(size_t index);
+    LOCAL_API bool WaitAsSpareLocked(std::unique_lock<std::mutex> &lock);
+    LOCAL_API bool RunLocked(std::shared_ptr<PoolRunnable> &runnable, std::unique_lock<std::mutex> &lock);
+    LOCAL_API void ArmTimerLocked(const std::shared_ptr<PoolRunnable> &runnable, InnerEvent::TimePoint deadline);
+    LOCAL_API void FireTimersLocked(InnerEvent::TimePoint now, std::vector<std::shared_ptr<PoolRunnable>> &released);
+
+    size_t workerNum_ {1};
+    // Guarded by 'lock_'. Workers not blocked are kept no less than 'workerNum_'.
+    size_t threadNum_ {0};
+    size_t blockedNum_ {0};
+    size_t nextWorkerIndex_ {0};
+    std::mutex lock_;
+    std::condition_variable condition_;
+    std::deque<std::shared_ptr<PoolRunnable>> ready_;
+    std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> timers_;
+};
+
+/*
+ * Marks the current worker of the pool blocked during its lifetime, see 'EventRunnerPool::BeginBlocking'.
+ */
+class PoolBlockingScope final {
+public:
+    PoolBlockingScope() : blocking_(EventRunnerPool::BeginBlocking()) {}
+    ~PoolBlockingScope()
+    {
+        if (blocking_) {
+            EventRunnerPool::EndBlocking();
+        }
+    }
+    DISALLOW_COPY_AND_MOVE(PoolBlockingScope);
+
+private:
+    bool blocking_;
+};
+
+/*
+ * Io waiter of a runner in the pool, the runner never waits on it, waking up the runner queues it in the pool.
+ * File descriptors are not listened, use a runner of its own thread for that.
+ */
+class PoolIoWaiter final : public IoWaiter {
+public:
+    PoolIoWaiter() = default;
+    ~PoolIoWaiter() final = default;
+    DISALLOW_COPY_AND_MOVE(PoolIoWaiter);
+
+    LOCAL_API void Bind(const std::weak_ptr<PoolRunnable> &runnable)
+    {
+        runnable_ = runnable;
+    }
+
+    LOCAL_API bool WaitFor(UniqueLockBase &lock, int64_t nanoseconds, bool vsyncOnly = false) final
+    {
+        (void)lock;
+        (void)nanoseconds;
+        (void)vsyncOnly;
+        return true;
+    }
+
+    LOCAL_API void NotifyOne() final;
+
+    LOCAL_API void NotifyAll() final
+    {
+        NotifyOne();
+    }
+
+    // Reported as supported, so that the queue does not switch to epoll, adding a file descriptor fails instead.
+    LOCAL_API bool SupportListeningFileDescriptor() const final
+    {
+        return true;
+    }
+
+    bool AddFileDescriptor(int32_t fileDescriptor, uint32_t events, const std::string &taskName,
+        const std::shared_ptr<FileDescriptorListener>& listener, EventQueue::Priority priority) final;
+
+    void RemoveFileDescriptor(int32_t fileDescriptor) final
+    {
+        (void)fileDescriptor;
+    }
+
+    void SetFileDescriptorEventCallback(const FileDescriptorEventCallback &callback) final
+    {
+        (void)callback;
+    }
+
+private:
+    std::weak_ptr<PoolRunnable> runnable_;
+};
+}  // namespace AppExecFwk
+}  // namespace OHOS
+
+#endif  // #ifndef BASE_EVENTHANDLER_FRAMEWORKS_EVENTHANDLER_INCLUDE_EVENT_RUNNER_POOL_H
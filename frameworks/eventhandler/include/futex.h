@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BASE_EVENTHANDLER_FRAMEWORKS_EVENTHANDLER_INCLUDE_FUTEX_H
+#define BASE_EVENTHANDLER_FRAMEWORKS_EVENTHANDLER_INCLUDE_FUTEX_H
+
+#include <atomic>
+#include <cstdint>
+#include <ctime>
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace OHOS {
+namespace AppExecFwk {
+/**
+ * Block while the word equals to 'expected', until woken up, timed out or interrupted.
+ *
+ * @param word Futex word, only shared by threads of this process.
+ * @param expected Value of the word to block on.
+ * @param timeout Relative timeout, nullptr to block forever.
+ */
+inline void FutexWait(std::atomic<uint32_t> &word, uint32_t expected, const struct timespec *timeout = nullptr)
+{
+    (void)syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAIT_PRIVATE, expected, timeout, nullptr, 0);
+}
+
+/**
+ * Wake up threads blocked on the word.
+ *
+ * @param word Futex word, only shared by threads of this process.
+ * @param count Max number of threads to wake up.
+ */
+inline void FutexWake(std::atomic<uint32_t> &word, int32_t count)
+{
+    (void)syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+}
+}  // namespace AppExecFwk
+}  // namespace OHOS
+
+#endif  // #ifndef BASE_EVENTHANDLER_FRAMEWORKS_EVENTHANDLER_INCLUDE_FUTEX_H
@@ -104,6 +104,13 @@ public:
 
     LOCAL_API virtual std::shared_ptr<FileDescriptorInfo> GetFileDescriptorMap(int32_t fileDescriptor)
         { return nullptr; }
+
+    /**
+     * Wait with the precision of nanoseconds or milliseconds, only matters for waiters using epoll.
+     *
+     * @param enable Enable high resolution or not.
+     */
+    LOCAL_API virtual void SetHighResolution(bool enable) { (void)enable; }
 };
 }  // namespace AppExecFwk
 }  // namespace OHOS
@@ -16,7 +16,9 @@
 #ifndef BASE_EVENTHANDLER_FRAMEWORKS_EVENTHANDLER_INCLUDE_NONE_IO_WAITER_H
 #define BASE_EVENTHANDLER_FRAMEWORKS_EVENTHANDLER_INCLUDE_NONE_IO_WAITER_H
 
+#include <atomic>
 #include <condition_variable>
+#include <cstdint>
 #include <mutex>
 
 #include "io_waiter.h"
@@ -29,6 +31,7 @@ namespace AppExecFwk {
 class NoneIoWaiter final : public IoWaiter {
 public:
     NoneIoWaiter() = default;
+    explicit NoneIoWaiter(WaitStrategy strategy) : strategy_(strategy) {}
     ~NoneIoWaiter() final;
     DISALLOW_COPY_AND_MOVE(NoneIoWaiter);
 
@@ -39,6 +42,13 @@ public:
 
     LOCAL_API bool SupportListeningFileDescriptor() const final;
 
+    /**
+     * Get the number of threads waiting on this waiter.
+     *
+     * @return Returns the number of waiting threads.
+     */
+    LOCAL_API uint32_t GetWaiterNum();
+
     bool AddFileDescriptor(int32_t fileDescriptor, uint32_t events, const std::string &taskName,
         const std::shared_ptr<FileDescriptorListener>& listener, EventQueue::Priority priority) final;
     void RemoveFileDescriptor(int32_t fileDescriptor) final;
@@ -46,9 +56,26 @@ public:
     void SetFileDescriptorEventCallback(const FileDescriptorEventCallback &callback) final;
 
 private:
+    // States of 'state_', which is also the futex word.
+    static constexpr uint32_t STATE_EMPTY = 0;
+    static constexpr uint32_t STATE_NOTIFIED = 1;
+    static constexpr uint32_t STATE_PARKED = 2;
+
+    LOCAL_API void Park(int64_t nanoseconds);
+    LOCAL_API bool Spin(int64_t nanoseconds);
+    LOCAL_API bool TakeNotification();
+    LOCAL_API void Unpark(int32_t count);
+
+    WaitStrategy strategy_ {WaitStrategy::BLOCK};
     std::condition_variable condition_;
-    bool pred_ {false};
+    // Notifications not taken yet, at most one for each waiter and one for the runner not waiting yet.
+    uint32_t pendingNotifications_ {0};
+    uint32_t waiterNum_ {0};
+    // Changed by 'NotifyAll', so that all waiters wake up even if the pending notifications are taken by others.
+    uint64_t notifyAllCount_ {0};
     std::mutex waitLock_;
+    // Used instead of the condition variable if the runner parks on a futex.
+    std::atomic<uint32_t> state_ {STATE_EMPTY};
 };
 }  // namespace AppExecFwk
 }  // namespace OHOS
@@ -0,0 +1,280 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BASE_EVENTHANDLER_FRAMEWORKS_EVENTHANDLER_INCLUDE_PENDING_EVENT_STORE_H
+#define BASE_EVENTHANDLER_FRAMEWORKS_EVENTHANDLER_INCLUDE_PENDING_EVENT_STORE_H
+
+#include <functional>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+#include "event_queue.h"
+#include "inner_event.h"
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+// Intrusive list of pending events, linked through InnerEvent::PendingLink.
+struct InnerEvent::PendingChain {
+    InnerEvent *head {nullptr};
+    size_t count {0};
+};
+
+/*
+ * Container of pending events in one priority, ordered by handle time.
+ * Events with the same handle time keep the order of insertion, events inserted at front go before all others.
+ * Events are also indexed by owner and by (owner, event id), so that operations on one owner only touch its events.
+ */
+class PendingEventStore {
+public:
+    enum class Type {
+        // Sorted list, insertion scans backward from the tail.
+        LIST = 0,
+        // FIFO for events arriving in handle time order, plus a 4-ary heap for the others.
+        HEAP,
+    };
+
+    using Filter = std::function<bool(const InnerEvent::Pointer &)>;
+    using Visitor = std::function<void(const InnerEvent::Pointer &)>;
+    using IndexFilter = std::function<bool(InnerEvent &)>;
+
+    /**
+     * Create a pending event store.
+     *
+     * @param type Type of the store.
+     * @return Returns the created store.
+     */
+    static std::unique_ptr<PendingEventStore> Create(Type type = Type::HEAP);
+
+    PendingEventStore() = default;
+    virtual ~PendingEventStore() = default;
+    DISALLOW_COPY_AND_MOVE(PendingEventStore);
+
+    /**
+     * Insert an event, the event is moved into the store.
+     *
+     * @param event Event to insert.
+     * @param insertType Insert at the end of the events with the same handle time, or before all events.
+     */
+    virtual void Insert(InnerEvent::Pointer &event, EventInsertType insertType) = 0;
+
+    virtual bool Empty() const = 0;
+
+    virtual size_t Size() const = 0;
+
+    /**
+     * Get the event which should be handled first, the store must not be empty.
+     *
+     * @return Returns the first event.
+     */
+    virtual const InnerEvent::Pointer &Front() const = 0;
+
+    /**
+     * Remove and return the event which should be handled first, the store must not be empty.
+     *
+     * @return Returns the first event.
+     */
+    virtual InnerEvent::Pointer PopFront() = 0;
+
+    /**
+     * Remove and return the first event matching the filter in handling order.
+     *
+     * @param filter Filter to match events.
+     * @return Returns the matched event, or nullptr if not found.
+     */
+    virtual InnerEvent::Pointer PopFirstIf(const Filter &filter) = 0;
+
+    /**
+     * Check whether any event whose handle time is not after 'now' matches the filter.
+     *
+     * @param now Current time.
+     * @param filter Filter to match events.
+     * @return Returns true if found.
+     */
+    virtual bool HasExpiredIf(const InnerEvent::TimePoint &now, const Filter &filter) const = 0;
+
+    /**
+     * Get the earliest handle time after 'now'.
+     *
+     * @param now Current time.
+     * @return Returns the earliest handle time after 'now', or the max time point if not found.
+     */
+    virtual InnerEvent::TimePoint FirstHandleTimeAfter(const InnerEvent::TimePoint &now) const = 0;
+
+    virtual bool AnyOf(const Filter &filter) const = 0;
+
+    virtual void RemoveIf(const Filter &filter) = 0;
+
+    /**
+     * Move out all events matching the filter.
+     *
+     * @param filter Filter to match events.
+     * @param extracted Container to receive the removed events.
+     */
+    virtual void ExtractIf(const Filter &filter, std::list<InnerEvent::Pointer> &extracted) = 0;
+
+    /**
+     * Visit all events in handling order.
+     *
+     * @param visitor Visitor of events.
+     */
+    virtual void ForEach(const Visitor &visitor) const = 0;
+
+    virtual void Clear() = 0;
+
+    /**
+     * Check whether any event of the owner matches the filter.
+     *
+     * @param ownerId Id of the owner.
+     * @param filter Filter to match events.
+     * @return Returns true if found.
+     */
+    bool AnyOfOwner(uint64_t ownerId, const IndexFilter &filter) const;
+
+    /**
+     * Check whether any event without task of the owner with the event id matches the filter.
+     *
+     * @param ownerId Id of the owner.
+     * @param innerEventId Id of the event.
+     * @param filter Filter to match events.
+     * @return Returns true if found.
+     */
+    bool AnyOfOwnerEvent(uint64_t ownerId, uint32_t innerEventId, const IndexFilter &filter) const;
+
+    /**
+     * Move out events of the owner matching the filter.
+     *
+     * @param ownerId Id of the owner.
+     * @param filter Filter to match events.
+     * @param extracted Container to receive the removed events.
+     * @return Returns the number of removed events.
+     */
+    size_t ExtractOwnerIf(uint64_t ownerId, const IndexFilter &filter, std::list<InnerEvent::Pointer> &extracted);
+
+    /**
+     * Move out events without task of the owner with the event id matching the filter.
+     *
+     * @param ownerId Id of the owner.
+     * @param innerEventId Id of the event.
+     * @param filter Filter to match events.
+     * @param extracted Container to receive the removed events.
+     * @return Returns the number of removed events.
+     */
+    size_t ExtractOwnerEventIf(uint64_t ownerId, uint32_t innerEventId, const IndexFilter &filter,
+        std::list<InnerEvent::Pointer> &extracted);
+
+    /**
+     * Move out events matching the filter whose owner is released, events of alive owners are not visited.
+     *
+     * @param filter Filter to match events.
+     * @param extracted Container to receive the removed events.
+     */
+    void ExtractOrphansIf(const IndexFilter &filter, std::list<InnerEvent::Pointer> &extracted);
+
+    /**
+     * Mark an event as coalesced with the key, before it is inserted, so that it could be found by 'FindCoalesced'.
+     *
+     * @param event Event to insert.
+     * @param key Key of the event, unique among events of the same owner.
+     */
+    static void SetCoalesceKey(InnerEvent &event, uint64_t key);
+
+    /**
+     * Find the pending coalesced event of the owner with the key.
+     *
+     * @param ownerId Id of the owner.
+     * @param key Key of the event.
+     * @return Returns the event, or nullptr if not found.
+     */
+    InnerEvent *FindCoalesced(uint64_t ownerId, uint64_t key) const;
+
+    /**
+     * Merge a new event into a pending coalesced event, the pending event keeps its position in the store.
+     * Only two tasks, or two events with the same event id, could be merged.
+     *
+     * @param pending Pending event found by 'FindCoalesced'.
+     * @param latest New event, which should be released after merged.
+     * @param replace Replace content of the pending event with the new one, otherwise keep the pending one.
+     * @return Returns false if the events could not be merged.
+     */
+    static bool Merge(InnerEvent &pending, InnerEvent &latest, bool replace);
+
+    /**
+     * Find a pending event which a task handle is returned for.
+     *
+     * @param eventUniqueId Unique id of the event.
+     * @return Returns the event, or nullptr if not found.
+     */
+    InnerEvent *FindWithHandle(uint64_t eventUniqueId) const;
+
+    /**
+     * Remove an event found by the index from the store.
+     *
+     * @param event Event in the store.
+     * @return Returns the removed event.
+     */
+    InnerEvent::Pointer Remove(InnerEvent &event);
+
+protected:
+    using PendingLink = InnerEvent::PendingLink;
+
+    static inline PendingLink &LinkOf(InnerEvent &event)
+    {
+        return event.pendingLink_;
+    }
+
+    // Add an inserted event into the index.
+    void Track(InnerEvent &event);
+
+    // Remove an event from the index, must be called before the event leaves the store.
+    void Untrack(InnerEvent &event);
+
+    void ClearIndex();
+
+    /**
+     * Remove an event which is already untracked from the store.
+     *
+     * @param event Event in the store.
+     * @return Returns the removed event.
+     */
+    virtual InnerEvent::Pointer Erase(InnerEvent &event) = 0;
+
+private:
+    using PendingChain = InnerEvent::PendingChain;
+    using ChainField = PendingChain *PendingLink::*;
+    using LinkField = InnerEvent *PendingLink::*;
+
+    struct OwnerEvents {
+        PendingChain all;
+        std::unordered_map<uint32_t, PendingChain> byId;
+        std::unordered_map<uint64_t, InnerEvent *> coalesced;
+    };
+
+    static void PushChain(PendingChain &chain, InnerEvent &event, ChainField chainField, LinkField prev,
+        LinkField next);
+    static void UnlinkChain(InnerEvent &event, ChainField chainField, LinkField prev, LinkField next);
+    static bool AnyOfChain(const PendingChain &chain, LinkField next, const IndexFilter &filter);
+    size_t ExtractChainIf(const PendingChain &chain, LinkField next, const IndexFilter &filter,
+        std::list<InnerEvent::Pointer> &extracted);
+
+    std::unordered_map<uint64_t, OwnerEvents> owners_;
+    // Events with task handles, by unique id.
+    std::unordered_map<uint64_t, InnerEvent *> withHandle_;
+};
+}  // namespace AppExecFwk
+}  // namespace OHOS
+
+#endif  // #ifndef BASE_EVENTHANDLER_FRAMEWORKS_EVENTHANDLER_INCLUDE_PENDING_EVENT_STORE_H
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BASE_EVENTHANDLER_FRAMEWORKS_EVENTHANDLER_INCLUDE_SYNC_WAITER_H
+#define BASE_EVENTHANDLER_FRAMEWORKS_EVENTHANDLER_INCLUDE_SYNC_WAITER_H
+
+#include <atomic>
+#include <climits>
+#include <cstdint>
+
+#include "futex.h"
+#include "inner_event.h"
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+/*
+ * Waiter of sync events, which blocks on a single futex word instead of a mutex and a condition variable.
+ * A thread sends sync events one by one, so it reuses one waiter for all of them, see 'InnerEvent::UseThreadWaiter'.
+ * Results written by the task before the event is released are visible to the woken up sender.
+ */
+class SyncWaiter final : public InnerEvent::Waiter {
+public:
+    SyncWaiter() = default;
+    ~SyncWaiter() final = default;
+    DISALLOW_COPY_AND_MOVE(SyncWaiter);
+
+    // Make the waiter ready for the next event, only called by the thread owning it.
+    inline void Reset()
+    {
+        state_.store(STATE_WAITING, std::memory_order_relaxed);
+    }
+
+    void Wait() final
+    {
+        uint32_t expected = STATE_WAITING;
+        (void)state_.compare_exchange_strong(expected, STATE_PARKED, std::memory_order_acquire);
+        // Check again if woken up spuriously, or by a late wake up for the previous event of this waiter.
+        while (state_.load(std::memory_order_acquire) == STATE_PARKED) {
+            FutexWait(state_, STATE_PARKED);
+        }
+    }
+
+    void Notify() final
+    {
+        // No system call if the sender is not blocked yet.
+        if (state_.exchange(STATE_DONE, std::memory_order_release) == STATE_PARKED) {
+            FutexWake(state_, INT_MAX);
+        }
+    }
+
+private:
+    static constexpr uint32_t STATE_WAITING = 0;
+    static constexpr uint32_t STATE_PARKED = 1;
+    static constexpr uint32_t STATE_DONE = 2;
+
+    std::atomic<uint32_t> state_ {STATE_DONE};
+};
+}  // namespace AppExecFwk
+}  // namespace OHOS
+
+#endif  // #ifndef BASE_EVENTHANDLER_FRAMEWORKS_EVENTHANDLER_INCLUDE_SYNC_WAITER_H
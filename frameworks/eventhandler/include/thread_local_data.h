@@ -16,9 +16,9 @@
 #ifndef BASE_EVENTHANDLER_FRAMEWORKS_EVENTHANDLER_INCLUDE_THREAD_LOCAL_DATA_H
 #define BASE_EVENTHANDLER_FRAMEWORKS_EVENTHANDLER_INCLUDE_THREAD_LOCAL_DATA_H
 
-#include <mutex>
-#include <thread>
-#include <unordered_map>
+#include <atomic>
+#include <cstdint>
+#include <vector>
 
 #include "nocopyable.h"
 
@@ -26,11 +26,12 @@ namespace OHOS {
 namespace AppExecFwk {
 /*
  * Tool class, used to save thread local data.
+ * Data is kept in thread local storage, so reading data of current thread takes no lock.
  */
 template<typename T>
 class ThreadLocalData {
 public:
-    ThreadLocalData() = default;
+    ThreadLocalData() : id_(NextId()) {}
     ~ThreadLocalData() = default;
     DISALLOW_COPY_AND_MOVE(ThreadLocalData);
 
@@ -61,31 +62,104 @@ public:
     }
 
 private:
+    struct Entry {
+        // Id of the instance, which is never reused, so data left by a destroyed instance is never found again.
+        uint64_t id;
+        T data;
+    };
+
+    // Data saved by current thread for all instances with the same type.
+    struct LocalEntries {
+        LocalEntries() = default;
+        ~LocalEntries()
+        {
+            // Destructors of other thread local objects, or of the data itself, may still access the data.
+            IsDestroyed() = true;
+            std::vector<Entry> released;
+            released.swap(entries);
+        }
+        DISALLOW_COPY_AND_MOVE(LocalEntries);
+
+        std::vector<Entry> entries;
+    };
+
+    static inline uint64_t NextId()
+    {
+        static std::atomic<uint64_t> nextId {0};
+        return nextId.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // It is trivially destructible, so still usable while thread is exiting.
+    static inline bool &IsDestroyed()
+    {
+        static thread_local bool destroyed = false;
+        return destroyed;
+    }
+
+    // Returns nullptr after the entries are destroyed while thread exiting.
+    static inline std::vector<Entry> *GetLocalEntries()
+    {
+        if (IsDestroyed()) {
+            return nullptr;
+        }
+        static thread_local LocalEntries localEntries;
+        return &localEntries.entries;
+    }
+
+    inline Entry *FindEntry() const
+    {
+        auto entries = GetLocalEntries();
+        if (entries == nullptr) {
+            return nullptr;
+        }
+        for (auto &entry : *entries) {
+            if (entry.id == id_) {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
     inline T Current() const
     {
-        std::lock_guard<std::mutex> lock(mapLock_);
-        auto it = dataMap_.find(std::this_thread::get_id());
-        if (it == dataMap_.end()) {
+        Entry *entry = FindEntry();
+        if (entry == nullptr) {
             return T();
         } else {
-            return it->second;
+            return entry->data;
         }
     }
 
     inline void Save(const T &data)
     {
-        std::lock_guard<std::mutex> lock(mapLock_);
-        dataMap_[std::this_thread::get_id()] = data;
+        Entry *entry = FindEntry();
+        if (entry != nullptr) {
+            entry->data = data;
+            return;
+        }
+        auto entries = GetLocalEntries();
+        if (entries != nullptr) {
+            entries->emplace_back(Entry {id_, data});
+        }
     }
 
     inline void Discard()
     {
-        std::lock_guard<std::mutex> lock(mapLock_);
-        (void)dataMap_.erase(std::this_thread::get_id());
+        auto entries = GetLocalEntries();
+        if (entries == nullptr) {
+            return;
+        }
+        for (auto it = entries->begin(); it != entries->end(); ++it) {
+            if (it->id == id_) {
+                // Release the data after it is removed, in case its destructor accesses this instance.
+                T data = std::move(it->data);
+                (void)entries->erase(it);
+                return;
+            }
+        }
     }
 
-    mutable std::mutex mapLock_;
-    std::unordered_map<std::thread::id, T> dataMap_;
+    const uint64_t id_;
 };
 }  // namespace AppExecFwk
 }  // namespace OHOS
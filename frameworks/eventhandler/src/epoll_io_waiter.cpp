@@ -20,6 +20,8 @@
 #include <mutex>
 #include <sys/epoll.h>
 #include <sys/eventfd.h>
+#include <sys/syscall.h>
+#include <sys/timerfd.h>
 #include <unistd.h>
 
 #include "event_handler_utils.h"
@@ -56,6 +58,11 @@ EpollIoWaiter::~EpollIoWaiter()
         fdsan_close_with_tag(awakenFd_, EH_LOG_DOMAIN);
         awakenFd_ = -1;
     }
+
+    if (timerFd_ >= 0) {
+        fdsan_close_with_tag(timerFd_, EH_LOG_DOMAIN);
+        timerFd_ = -1;
+    }
 }
 
 bool EpollIoWaiter::Init()
@@ -128,7 +135,7 @@ bool EpollIoWaiter::WaitFor(UniqueLockBase &externLock, int64_t nanoseconds, boo
 
     // Block on epoll_wait outside of the lock.
     struct epoll_event epollEvents[MAX_EPOLL_EVENTS_SIZE];
-    int32_t retVal = epoll_wait(epollFd_, epollEvents, MAX_EPOLL_EVENTS_SIZE, NanosecondsToTimeout(nanoseconds));
+    int32_t retVal = WaitEpoll(epollEvents, MAX_EPOLL_EVENTS_SIZE, nanoseconds);
     // Decrease waiting count after block at once.
     --waitingCount_;
     if (waitingCount_ < 0) {
@@ -150,6 +157,10 @@ bool EpollIoWaiter::WaitFor(UniqueLockBase &externLock, int64_t nanoseconds, boo
                 DrainAwakenPipe();
                 continue;
             }
+            if (epollEvents[i].data.fd == timerFd_) {
+                DrainTimer();
+                continue;
+            }
 
             // Transform epoll events into file descriptor listener events.
             uint32_t events = 0;
@@ -179,6 +190,80 @@ bool EpollIoWaiter::WaitFor(UniqueLockBase &externLock, int64_t nanoseconds, boo
     return result;
 }
 
+int32_t EpollIoWaiter::WaitEpoll(struct epoll_event *events, int32_t maxEvents, int64_t nanoseconds)
+{
+    // Milliseconds are exact enough if there is no remainder.
+    if (!highResolution_.load(std::memory_order_relaxed) || (nanoseconds <= 0) ||
+        ((nanoseconds % NANOSECONDS_PER_ONE_MILLISECOND) == 0)) {
+        return epoll_wait(epollFd_, events, maxEvents, NanosecondsToTimeout(nanoseconds));
+    }
+#ifdef SYS_epoll_pwait2
+    if (pwait2Supported_) {
+        struct timespec timeout = {
+            .tv_sec = static_cast<time_t>(nanoseconds / NANOSECONDS_PER_ONE_SECOND),
+            .tv_nsec = static_cast<long>(nanoseconds % NANOSECONDS_PER_ONE_SECOND),
+        };
+        int32_t retVal = static_cast<int32_t>(syscall(SYS_epoll_pwait2, epollFd_, events, maxEvents, &timeout,
+            nullptr, 0));
+        if ((retVal >= 0) || (errno != ENOSYS)) {
+            return retVal;
+        }
+        HILOGW("epoll_pwait2 is not supported, use timerfd instead");
+        pwait2Supported_ = false;
+    }
+#endif
+    return WaitEpollWithTimer(events, maxEvents, nanoseconds);
+}
+
+int32_t EpollIoWaiter::WaitEpollWithTimer(struct epoll_event *events, int32_t maxEvents, int64_t nanoseconds)
+{
+    if (timerFd_ < 0) {
+        int32_t timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+        if (timerFd < 0) {
+            char errmsg[MAX_ERRORMSG_LEN] = {0};
+            GetLastErr(errmsg, MAX_ERRORMSG_LEN);
+            HILOGE("Failed to create timer fd, %{public}s", errmsg);
+            highResolution_.store(false);
+            return epoll_wait(epollFd_, events, maxEvents, NanosecondsToTimeout(nanoseconds));
+        }
+        fdsan_exchange_owner_tag(timerFd, 0, EH_LOG_DOMAIN);
+        if (EpollCtrl(epollFd_, EPOLL_CTL_ADD, timerFd, EPOLLIN) < 0) {
+            char errmsg[MAX_ERRORMSG_LEN] = {0};
+            GetLastErr(errmsg, MAX_ERRORMSG_LEN);
+            HILOGE("Failed to add timer fd into epoll, %{public}s", errmsg);
+            fdsan_close_with_tag(timerFd, EH_LOG_DOMAIN);
+            highResolution_.store(false);
+            return epoll_wait(epollFd_, events, maxEvents, NanosecondsToTimeout(nanoseconds));
+        }
+        timerFd_ = timerFd;
+    }
+
+    struct itimerspec timeout = {
+        .it_interval = {0, 0},
+        .it_value = {
+            .tv_sec = static_cast<time_t>(nanoseconds / NANOSECONDS_PER_ONE_SECOND),
+            .tv_nsec = static_cast<long>(nanoseconds % NANOSECONDS_PER_ONE_SECOND),
+        },
+    };
+    (void)timerfd_settime(timerFd_, 0, &timeout, nullptr);
+    /*
+     * The timer wakes up epoll before the timeout in milliseconds.
+     * If woken up by others, the timer will be armed again or fire once for nothing, which is harmless.
+     */
+    return epoll_wait(epollFd_, events, maxEvents, NanosecondsToTimeout(nanoseconds));
+}
+
+void EpollIoWaiter::DrainTimer() const
+{
+    uint64_t expirations = 0;
+    (void)read(timerFd_, &expirations, sizeof(expirations));
+}
+
+void EpollIoWaiter::SetHighResolution(bool enable)
+{
+    highResolution_.store(enable);
+}
+
 void EpollIoWaiter::NotifyOne()
 {
     // Epoll only support wake up all waiting thread.
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "event_dump_snapshot.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+namespace {
+static constexpr int DATETIME_STRING_LENGTH = 80;
+static constexpr int MAX_MS_LENGTH = 3;
+static constexpr int64_t MS_PER_SECOND = 1000;
+}  // unnamed namespace
+
+DumpTimeFormatter::DumpTimeFormatter()
+    : systemNow_(std::chrono::system_clock::now()), steadyNow_(InnerEvent::Clock::now())
+{}
+
+std::string DumpTimeFormatter::Format(const InnerEvent::TimePoint &time)
+{
+    auto systemTime = systemNow_ + std::chrono::duration_cast<std::chrono::milliseconds>(time - steadyNow_);
+    auto ms = std::chrono::time_point_cast<std::chrono::milliseconds>(systemTime).time_since_epoch().count() %
+        MS_PER_SECOND;
+    std::time_t second = std::chrono::system_clock::to_time_t(systemTime);
+    if (!cached_ || second != cachedSecond_) {
+        struct tm curTime = {0};
+        localtime_r(&second, &curTime);
+        char sysTime[DATETIME_STRING_LENGTH];
+        std::strftime(sysTime, sizeof(sysTime), "%Y-%m-%d %H:%M:%S.", &curTime);
+        cachedPrefix_ = sysTime;
+        cachedSecond_ = second;
+        cached_ = true;
+    }
+    std::string msString = std::to_string(ms);
+    std::string result;
+    result.reserve(cachedPrefix_.size() + MAX_MS_LENGTH);
+    result.append(cachedPrefix_);
+    if (msString.length() < MAX_MS_LENGTH) {
+        result.append(MAX_MS_LENGTH - msString.length(), '0');
+    }
+    result.append(msString);
+    return result;
+}
+
+EventDumpSnapshot::EventDumpSnapshot(uint32_t maxEventsPerQueue, uint32_t maxEvents)
+    : maxEventsPerQueue_(maxEventsPerQueue), maxEvents_(maxEvents)
+{}
+
+void EventDumpSnapshot::Add(uint32_t queue, InnerEvent &event)
+{
+    if (queue >= QUEUE_NUM) {
+        return;
+    }
+    ++totalCount_;
+    uint32_t count = counts_[queue]++;
+    // Keep the same order as before, events after the first 'maxEvents_' ones of all queues are only counted.
+    if ((totalCount_ > maxEvents_) || (count >= maxEventsPerQueue_)) {
+        return;
+    }
+
+    Record record {};
+    record.senderKernelThreadId = event.GetSenderKernelThreadId();
+    record.sendTime = event.GetSendTime();
+    record.handleTime = event.GetHandleTime();
+    record.param = event.GetParam();
+    record.uniqueId = event.GetEventUniqueId();
+    record.caller = event.GetCaller();
+    if (!event.GetWeakOwner().expired()) {
+        record.flags |= FLAG_HAS_OWNER;
+    }
+    if (event.HasTask()) {
+        record.flags |= FLAG_HAS_TASK;
+        AppendName(record, event.GetTaskName());
+    } else {
+        auto eventId = event.GetInnerEventIdEx();
+        if (eventId.index() == TYPE_U32_INDEX) {
+            record.innerEventId = std::get<uint32_t>(eventId);
+        } else {
+            record.flags |= FLAG_STRING_EVENT_ID;
+            AppendName(record, std::get<std::string>(eventId));
+        }
+    }
+    records_[queue].emplace_back(record);
+}
+
+void EventDumpSnapshot::AppendName(Record &record, const std::string &name)
+{
+    record.nameOffset = static_cast<uint32_t>(names_.size());
+    record.nameLength = static_cast<uint32_t>(name.size());
+    names_.append(name);
+}
+
+std::string EventDumpSnapshot::Format(const Record &record, DumpTimeFormatter &formatter) const
+{
+    std::string content("Event { ");
+    if ((record.flags & FLAG_HAS_OWNER) != 0) {
+        content.append("send thread = " + std::to_string(record.senderKernelThreadId));
+        content.append(", send time = " + formatter.Format(record.sendTime));
+        content.append(", handle time = " + formatter.Format(record.handleTime));
+        if ((record.flags & FLAG_HAS_TASK) != 0) {
+            content.append(", task name = ").append(names_, record.nameOffset, record.nameLength);
+        } else if ((record.flags & FLAG_STRING_EVENT_ID) != 0) {
+            content.append(", id = ").append(names_, record.nameOffset, record.nameLength);
+        } else {
+            content.append(", id = " + std::to_string(record.innerEventId));
+        }
+        if (record.param != 0) {
+            content.append(", param = " + std::to_string(record.param));
+        }
+        content.append(", caller = " + record.caller.ToString());
+        if (record.uniqueId != 0) {
+            content.append(", unique id = " + std::to_string(record.uniqueId));
+        }
+    } else {
+        content.append("No handler");
+    }
+    content.append(" }" + std::string(LINE_SEPARATOR));
+    return content;
+}
+}  // namespace AppExecFwk
+}  // namespace OHOS
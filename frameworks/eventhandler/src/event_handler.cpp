@@ -18,7 +18,10 @@
 #include <unistd.h>
 #include <sys/syscall.h>
 #include "event_handler_utils.h"
+#include "event_inner_runner.h"
 #include "event_logger.h"
+#include "event_queue_base.h"
+#include "event_runner_pool.h"
 #ifdef HAS_HICHECKER_NATIVE_PART
 #include "hichecker.h"
 #endif // HAS_HICHECKER_NATIVE_PART
@@ -46,6 +49,14 @@ static const uint64_t PENDING_JOB_TIMEOUT[3] = {
     system::GetIntParameter("const.sys.notification.pending_higher_event_high", 400)
 };
 DEFINE_EH_HILOG_LABEL("EventHandler");
+
+// Handlers whose events are distributed up the stack of this thread, outer of the sync events handled on the
+// thread of a concurrent runner. Only compared, never used.
+struct OuterHandler {
+    const EventHandler *handler;
+    const OuterHandler *next;
+};
+thread_local const OuterHandler *g_outerHandlers = nullptr;
 }
 thread_local std::weak_ptr<EventHandler> EventHandler::currentEventHandler;
 thread_local int32_t EventHandler::currentEventPriority = -1;
@@ -70,14 +81,13 @@ std::shared_ptr<EventHandler> EventHandler::Current()
 EventHandler::EventHandler(const std::shared_ptr<EventRunner> &runner) : eventRunner_(runner)
 {
     static std::atomic<uint64_t> handlerCount = 1;
-    handlerId_ = std::to_string(handlerCount.load()) + "_" + std::to_string(GetTimeStamp());
-    handlerCount.fetch_add(1);
-    HILOGD("Create eventHandler %{public}s", handlerId_.c_str());
+    handlerId_ = handlerCount.fetch_add(1, std::memory_order_relaxed);
+    HILOGD("Create eventHandler %{public}llu", static_cast<unsigned long long>(handlerId_));
 }
 
 EventHandler::~EventHandler()
 {
-    HILOGD("~EventHandler enter %{public}s", handlerId_.c_str());
+    HILOGD("~EventHandler enter %{public}llu", static_cast<unsigned long long>(handlerId_));
     if (eventRunner_) {
         HILOGD("eventRunner is alive");
         /*
@@ -87,7 +97,7 @@ EventHandler::~EventHandler()
          */
 #ifdef FFRT_USAGE_ENABLE
         if (eventRunner_->threadMode_ == ThreadMode::FFRT) {
-            eventRunner_->GetEventQueue()->RemoveOrphanByHandlerId(handlerId_);
+            eventRunner_->GetEventQueue()->RemoveOrphanByHandlerId(std::to_string(handlerId_));
         } else {
             eventRunner_->GetEventQueue()->RemoveOrphan();
         }
@@ -98,6 +108,37 @@ EventHandler::~EventHandler()
 }
 
 bool EventHandler::SendEvent(InnerEvent::Pointer &event, int64_t delayTime, Priority priority)
+{
+    return SendEvent(event, std::chrono::milliseconds(delayTime), priority);
+}
+
+bool EventHandler::SendEvent(InnerEvent::Pointer &event, std::chrono::nanoseconds delay, Priority priority)
+{
+    uint64_t eventUniqueId = 0;
+    return SendEvent(event, delay, priority, eventUniqueId);
+}
+
+TaskHandle EventHandler::SendEventWithHandle(InnerEvent::Pointer &event, int64_t delayTime, Priority priority)
+{
+    if (!event) {
+        HILOGE("Could not send an invalid event");
+        return TaskHandle();
+    }
+    // Let the queue index the event by its unique id, which is assigned while sending.
+    event->pendingLink_.withHandle = true;
+    uint64_t eventUniqueId = 0;
+    if (!SendEvent(event, std::chrono::milliseconds(delayTime), priority, eventUniqueId)) {
+        // The event is kept by the caller, which may send it again without a handle.
+        if (event) {
+            event->pendingLink_.withHandle = false;
+        }
+        return TaskHandle();
+    }
+    return TaskHandle(eventRunner_->GetEventQueue(), eventUniqueId);
+}
+
+bool EventHandler::SendEvent(InnerEvent::Pointer &event, std::chrono::nanoseconds delay, Priority priority,
+    uint64_t &eventUniqueId)
 {
     if (!event) {
         HILOGE("Could not send an invalid event");
@@ -109,17 +150,67 @@ bool EventHandler::SendEvent(InnerEvent::Pointer &event, int64_t delayTime, Prio
         return false;
     }
 
-    InnerEvent::TimePoint now = InnerEvent::Clock::now();
+    PrepareToSend(event, delay, InnerEvent::Clock::now());
+    // get traceId from event, if HiTraceChain::begin has been called, would get a valid trace id.
+    auto traceId = event->GetOrCreateTraceId();
+    // if traceId is valid, out put trace information
+    bool isAllowHiTrace = AllowHiTraceOutPut(traceId, event->HasWaiter());
+    if (isAllowHiTrace) {
+        HiTracePointerOutPut(traceId, event, "SendEvent", HiTraceTracepointType::HITRACE_TP_CS);
+    }
+    eventUniqueId = event->GetEventUniqueId();
+    HILOGD("Current event id is %{public}llu .", static_cast<unsigned long long>(eventUniqueId));
+    bool ret = eventRunner_->GetEventQueue()->Insert(event, priority);
+    if (isAllowHiTrace) {
+        HiTraceChain::Tracepoint(HiTraceTracepointType::HITRACE_TP_CR, *traceId, "SendEvent over");
+    }
+    return ret;
+}
+
+bool EventHandler::SendCoalescedEvent(InnerEvent::Pointer &event, uint64_t key, CoalescePolicy policy,
+    int64_t delayTime, Priority priority)
+{
+    if (!event) {
+        HILOGE("Could not send an invalid event");
+        return false;
+    }
+
+    if (!eventRunner_) {
+        HILOGE("MUST Set event runner before sending events");
+        return false;
+    }
+
+    PrepareToSend(event, std::chrono::milliseconds(delayTime), InnerEvent::Clock::now());
+    HILOGD("Current coalesced event id is %{public}llu .", static_cast<unsigned long long>(event->GetEventUniqueId()));
+    return eventRunner_->GetEventQueue()->InsertCoalesced(event, priority, key, policy);
+}
+
+bool EventHandler::SendCoalescedEvent(InnerEvent::Pointer &event, CoalescePolicy policy, int64_t delayTime,
+    Priority priority)
+{
+    if (!event || event->HasTask()) {
+        HILOGE("Could not coalesce an invalid event or a task without key");
+        return false;
+    }
+    auto innerEventId = event->GetInnerEventIdEx();
+    uint64_t key = (innerEventId.index() == TYPE_U32_INDEX) ? std::get<uint32_t>(innerEventId) :
+        std::hash<std::string>()(std::get<std::string>(innerEventId));
+    return SendCoalescedEvent(event, key, policy, delayTime, priority);
+}
+
+void EventHandler::PrepareToSend(InnerEvent::Pointer &event, std::chrono::nanoseconds delay,
+    const InnerEvent::TimePoint &now)
+{
     event->SetSendTime(now);
     event->SetSenderKernelThreadId(getproctid());
     event->SetEventUniqueId();
-    if (delayTime > 0) {
-        event->SetHandleTime(now + std::chrono::milliseconds(delayTime));
+    if (delay.count() > 0) {
+        event->SetHandleTime(now + delay);
     } else {
         event->SetHandleTime(now);
     }
     event->SetOwnerId(handlerId_);
-    event->SetDelayTime(delayTime);
+    event->SetDelayTime(std::chrono::duration_cast<std::chrono::milliseconds>(delay).count());
     event->SetOwner(shared_from_this());
 #ifdef FFRT_USAGE_ENABLE
     if (eventRunner_->threadMode_ != ThreadMode::FFRT) {
@@ -130,21 +221,58 @@ bool EventHandler::SendEvent(InnerEvent::Pointer &event, int64_t delayTime, Prio
     uint64_t trackId = AsyncStackAdapter::GetInstance().EventCollectAsyncStack(ASYNC_TYPE_EVENTHANDLER);
     event->SetStackId(trackId);
 #endif
-    // get traceId from event, if HiTraceChain::begin has been called, would get a valid trace id.
-    auto traceId = event->GetOrCreateTraceId();
-    // if traceId is valid, out put trace information
-    bool isAllowHiTrace = AllowHiTraceOutPut(traceId, event->HasWaiter());
-    if (isAllowHiTrace) {
-        HiTracePointerOutPut(traceId, event, "SendEvent", HiTraceTracepointType::HITRACE_TP_CS);
+}
+
+bool EventHandler::SendEvents(std::vector<EventItem> &items)
+{
+    if (!eventRunner_) {
+        HILOGE("MUST Set event runner before sending events");
+        return false;
     }
-    HILOGD("Current event id is %{public}s .", (event->GetEventUniqueId()).c_str());
-    bool ret = eventRunner_->GetEventQueue()->Insert(event, priority);
-    if (isAllowHiTrace) {
-        HiTraceChain::Tracepoint(HiTraceTracepointType::HITRACE_TP_CR, *traceId, "SendEvent over");
+    for (const auto &item : items) {
+        if (!item.event) {
+            HILOGE("Could not send an invalid event");
+            return false;
+        }
+    }
+
+    InnerEvent::TimePoint now = InnerEvent::Clock::now();
+    std::vector<EventQueue::InsertItem> events;
+    events.reserve(items.size());
+    // Events are moved into the queue, so keep the trace ids to trace the end of sending.
+    std::vector<std::shared_ptr<HiTraceId>> traceIds;
+    for (auto &item : items) {
+        PrepareToSend(item.event, std::chrono::milliseconds(item.delayTime), now);
+        auto traceId = item.event->GetOrCreateTraceId();
+        if (AllowHiTraceOutPut(traceId, item.event->HasWaiter())) {
+            HiTracePointerOutPut(traceId, item.event, "SendEvents", HiTraceTracepointType::HITRACE_TP_CS);
+            traceIds.emplace_back(traceId);
+        }
+        events.push_back({std::move(item.event), item.priority});
+    }
+    bool ret = eventRunner_->GetEventQueue()->InsertEvents(events);
+    for (const auto &traceId : traceIds) {
+        HiTraceChain::Tracepoint(HiTraceTracepointType::HITRACE_TP_CR, *traceId, "SendEvents over");
+    }
+    // Give back the events which are not inserted.
+    for (size_t i = 0; i < items.size(); ++i) {
+        if (events[i].event) {
+            items[i].event = std::move(events[i].event);
+        }
     }
     return ret;
 }
 
+bool EventHandler::PostTasks(const std::vector<TaskItem> &items, const Caller &caller)
+{
+    std::vector<EventItem> events;
+    events.reserve(items.size());
+    for (const auto &item : items) {
+        events.push_back({InnerEvent::Get(item.callback, item.name, caller), item.delayTime, item.priority});
+    }
+    return SendEvents(events);
+}
+
 InnerEvent::Pointer EventHandler::CreateTask(const Callback &callback, const std::string &name, Priority priority,
     const Caller &caller)
 {
@@ -182,7 +310,7 @@ bool EventHandler::PostTaskAtFront(const Callback &callback, const std::string &
     if (isAllowHiTrace) {
         HiTracePointerOutPut(traceId, event, "PostTaskAtFront", HiTraceTracepointType::HITRACE_TP_CS);
     }
-    HILOGD("Current front event id is %{public}s .", (event->GetEventUniqueId()).c_str());
+    HILOGD("Current front event id is %{public}llu .", static_cast<unsigned long long>(event->GetEventUniqueId()));
     bool ret = eventRunner_->GetEventQueue()->Insert(event, priority, EventInsertType::AT_FRONT, option);
     if (isAllowHiTrace) {
         HiTraceChain::Tracepoint(HiTraceTracepointType::HITRACE_TP_CR, *traceId, "PostTaskAtFront over");
@@ -202,7 +330,7 @@ bool EventHandler::PostTaskAtTail(const Callback &callback, const std::string &n
     if (isAllowHiTrace) {
         HiTracePointerOutPut(traceId, event, "PostTaskAtTail", HiTraceTracepointType::HITRACE_TP_CS);
     }
-    HILOGD("Current front event id is %{public}s .", (event->GetEventUniqueId()).c_str());
+    HILOGD("Current front event id is %{public}llu .", static_cast<unsigned long long>(event->GetEventUniqueId()));
     bool ret = eventRunner_->GetEventQueue()->Insert(event, priority, EventInsertType::AT_END, option);
     if (isAllowHiTrace) {
         HiTraceChain::Tracepoint(HiTraceTracepointType::HITRACE_TP_CR, *traceId, "PostTaskAtTail over");
@@ -224,6 +352,18 @@ bool EventHandler::SendTimingEvent(InnerEvent::Pointer &event, int64_t taskTime,
     return SendEvent(event, delayTime, priority);
 }
 
+bool EventHandler::SendTimingEvent(InnerEvent::Pointer &event, const InnerEvent::TimePoint &taskTime,
+    Priority priority)
+{
+    auto delay = std::chrono::duration_cast<std::chrono::nanoseconds>(taskTime - InnerEvent::Clock::now());
+    if (delay.count() < 0) {
+        HILOGW("SendTime is before now, change to 0 delaytime Event");
+        return SendEvent(event, 0, priority);
+    }
+
+    return SendEvent(event, delay, priority);
+}
+
 bool EventHandler::SendSyncEvent(InnerEvent::Pointer &event, Priority priority)
 {
     if ((!event) || (priority == Priority::IDLE)) {
@@ -239,8 +379,14 @@ bool EventHandler::SendSyncEvent(InnerEvent::Pointer &event, Priority priority)
     bool result = true;
 #ifdef FFRT_USAGE_ENABLE
     if ((ffrt_this_task_get_id() && eventRunner_->threadMode_ == ThreadMode::FFRT) ||
-        eventRunner_ == EventRunner::Current()) {
+        CanDistributeOnCurrentThread()) {
+        // The outer event goes on after this one, so it is the current one again.
+        std::weak_ptr<EventHandler> current = currentEventHandler;
         DistributeEvent(event);
+        currentEventHandler = current;
+        return true;
+    }
+    if (DistributeOnIdleConcurrentThread(event)) {
         return true;
     }
 
@@ -253,31 +399,43 @@ bool EventHandler::SendSyncEvent(InnerEvent::Pointer &event, Priority priority)
         event->SetOwner(shared_from_this());
         result = eventRunner_->GetEventQueue()->InsertSyncEvent(event, priority);
     } else {
-        // Create waiter, used to block.
-        auto waiter = event->CreateWaiter();
+        // Use waiter of this thread, used to block.
+        auto waiter = event->UseThreadWaiter();
         // Send this event as normal one.
         if (!SendEvent(event, 0, priority)) {
             HILOGE("SendEvent is failed");
+            // Waiter is reused by the next sync event of this thread, so it must not be notified by this event.
+            event->waiter_.reset();
             return false;
         }
         // Wait until event is processed(recycled).
+        PoolBlockingScope blocking;
         waiter->Wait();
     }
 #else
     // If send a sync event in same event runner, distribute here.
-    if (eventRunner_ == EventRunner::Current()) {
+    if (CanDistributeOnCurrentThread()) {
+        // The outer event goes on after this one, so it is the current one again.
+        std::weak_ptr<EventHandler> current = currentEventHandler;
         DistributeEvent(event);
+        currentEventHandler = current;
+        return true;
+    }
+    if (DistributeOnIdleConcurrentThread(event)) {
         return true;
     }
 
-    // Create waiter, used to block.
-    auto waiter = event->CreateWaiter();
+    // Use waiter of this thread, used to block.
+    auto waiter = event->UseThreadWaiter();
     // Send this event as normal one.
     if (!SendEvent(event, 0, priority)) {
         HILOGE("SendEvent is failed");
+        // Waiter is reused by the next sync event of this thread, so it must not be notified by this event.
+        event->waiter_.reset();
         return false;
     }
-    // Wait until event is processed(recycled).
+    // Wait until event is processed(recycled), another worker runs the pool meanwhile if this is one of it.
+    PoolBlockingScope blocking;
     waiter->Wait();
 #endif
 
@@ -473,6 +631,46 @@ void EventHandler::DistributeTimeAction(const InnerEvent::Pointer &event, InnerE
 #endif // HAS_HICHECKER_NATIVE_PART
 }
 
+void EventHandler::RecordLatency(const InnerEvent::Pointer &event, InnerEvent::TimePoint nowStart)
+{
+    bool runnerEnabled = (eventRunner_ != nullptr) &&
+        eventRunner_->latencyStatsEnabled_.load(std::memory_order_acquire);
+    bool handlerEnabled = latencyStatsEnabled_.load(std::memory_order_acquire);
+    if (!runnerEnabled && !handlerEnabled) {
+        return;
+    }
+    InnerEvent::TimePoint nowEnd = InnerEvent::Clock::now();
+    int64_t delivery = std::chrono::duration_cast<std::chrono::nanoseconds>(nowStart - event->GetHandleTime()).count();
+    int64_t distribute = std::chrono::duration_cast<std::chrono::nanoseconds>(nowEnd - nowStart).count();
+    int32_t priority = event->GetEventPriority();
+    if (runnerEnabled) {
+        eventRunner_->latencyStats_->Record(priority, delivery, distribute);
+    }
+    if (handlerEnabled) {
+        latencyStats_->Record(priority, delivery, distribute);
+    }
+}
+
+void EventHandler::SetLatencyStatsEnabled(bool enable)
+{
+    if (enable) {
+        std::call_once(latencyStatsOnce_, [this]() {
+            latencyStats_ = std::make_unique<LatencyStats>();
+            latencyStatsCreated_.store(true, std::memory_order_release);
+        });
+    }
+    latencyStatsEnabled_.store(enable, std::memory_order_release);
+}
+
+LatencySnapshot EventHandler::GetLatencySnapshot() const
+{
+    // Histograms are kept after disabled.
+    if (!latencyStatsCreated_.load(std::memory_order_acquire)) {
+        return LatencySnapshot();
+    }
+    return latencyStats_->GetSnapshot();
+}
+
 void EventHandler::DistributeTimeoutHandler(const InnerEvent::TimePoint& beginTime)
 {
     int64_t distributeTimeout = EventRunner::GetMainEventRunner()->GetTimeout();
@@ -515,8 +713,8 @@ void EventHandler::DistributeEvent(const InnerEvent::Pointer &event) __attribute
 
     InnerEvent::TimePoint nowStart = InnerEvent::Clock::now();
     DeliveryTimeAction(event, nowStart);
-    HILOGD("EventName: %{public}s, eventId: %{public}s, priority: %{public}d", GetEventName(event).c_str(),
-        (event->GetEventUniqueId()).c_str(), event->GetEventPriority());
+    HILOGD("EventName: %{public}s, eventId: %{public}llu, priority: %{public}d", GetEventName(event).c_str(),
+        static_cast<unsigned long long>(event->GetEventUniqueId()), event->GetEventPriority());
 
     SetCurrentEventPriority(event->GetEventPriority());
     std::string eventName = GetEventName(event);
@@ -553,6 +751,7 @@ void EventHandler::DistributeEvent(const InnerEvent::Pointer &event) __attribute
     }
 
     DistributeTimeAction(event, nowStart);
+    RecordLatency(event, nowStart);
 
     if (allowTraceOutPut) {
         HiTraceChain::Tracepoint(HiTraceTracepointType::HITRACE_TP_SS, *spanId, "Event Distribute over");
@@ -665,6 +864,44 @@ bool EventHandler::IsIdle()
     return eventRunner_->GetEventQueue()->IsIdle();
 }
 
+bool EventHandler::CanDistributeOnCurrentThread()
+{
+    if ((!eventRunner_) || (eventRunner_ != EventRunner::Current())) {
+        return false;
+    }
+    // Other threads of a concurrent runner may be distributing events of this handler, unless it is running here.
+    if ((!eventRunner_->innerRunner_->IsConcurrent()) || (Current().get() == this)) {
+        return true;
+    }
+    for (auto outer = g_outerHandlers; outer != nullptr; outer = outer->next) {
+        if (outer->handler == this) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool EventHandler::DistributeOnIdleConcurrentThread(const InnerEvent::Pointer &event)
+{
+    if ((!eventRunner_) || (!eventRunner_->innerRunner_->IsConcurrent()) ||
+        (eventRunner_ != EventRunner::Current())) {
+        return false;
+    }
+    // Take this handler as the queue does for its events, so that other threads do not distribute them meanwhile.
+    auto queue = std::static_pointer_cast<EventQueueBase>(eventRunner_->GetEventQueue());
+    if (!queue->TryAcquireOwner(handlerId_)) {
+        return false;
+    }
+    std::weak_ptr<EventHandler> current = currentEventHandler;
+    OuterHandler outer {current.lock().get(), g_outerHandlers};
+    g_outerHandlers = &outer;
+    DistributeEvent(event);
+    g_outerHandlers = outer.next;
+    currentEventHandler = current;
+    queue->ReleaseOwner(handlerId_);
+    return true;
+}
+
 void EventHandler::ProcessEvent(const InnerEvent::Pointer &)
 {}
 
@@ -733,7 +970,7 @@ extern "C" bool PostTaskByFFRT(void* handler, const std::function<void()>& callb
     }
     std::shared_ptr<EventHandler>* ptr = reinterpret_cast<std::shared_ptr<EventHandler>*>(handler);
     Caller caller = {};
-    caller.dfxName_ = task.dfxName_;
+    caller.dfxName_ = Caller::Intern(task.dfxName_);
     return (*ptr)->PostTask(callback, std::to_string(task.taskId_), task.delayTime_, task.priority_, caller);
 }
 
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "event_history_ring.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace OHOS {
+namespace AppExecFwk {
+namespace {
+const int32_t MAX_READ_RETRY_TIMES = 3;
+}  // unnamed namespace
+
+EventHistoryRing::EventHistoryRing(uint32_t depth)
+{
+    uint32_t size = 1;
+    depth = std::min(depth, MAX_DEPTH);
+    while (size < depth) {
+        size <<= 1;
+    }
+    slots_ = std::make_unique<Slot[]>(size);
+    for (uint32_t i = 0; i < size; ++i) {
+        for (auto &word : slots_[i].words) {
+            word.store(0, std::memory_order_relaxed);
+        }
+    }
+    mask_ = size - 1;
+    nameIds_.emplace(std::string(), 0);
+    names_.emplace_back();
+}
+
+void EventHistoryRing::Store(Slot &slot, const Record &record)
+{
+    uint64_t words[RECORD_WORDS];
+    (void)memcpy(words, &record, sizeof(words));
+    // An odd sequence marks the slot as being written.
+    uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < RECORD_WORDS; ++i) {
+        slot.words[i].store(words[i], std::memory_order_relaxed);
+    }
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+void EventHistoryRing::Begin(const Record &record)
+{
+    current_ = record;
+    current_.completeTime = NOT_COMPLETED;
+    Store(slots_[writeIndex_], current_);
+}
+
+void EventHistoryRing::Complete(int64_t completeTime)
+{
+    current_.completeTime = completeTime;
+    Store(slots_[writeIndex_], current_);
+    writeIndex_ = (writeIndex_ + 1) & mask_;
+}
+
+bool EventHistoryRing::Read(uint32_t index, Record &record) const
+{
+    const Slot &slot = slots_[index & mask_];
+    for (int32_t i = 0; i < MAX_READ_RETRY_TIMES; ++i) {
+        uint32_t before = slot.sequence.load(std::memory_order_acquire);
+        if (before == 0) {
+            return false;
+        }
+        if ((before & 1) != 0) {
+            continue;
+        }
+        uint64_t words[RECORD_WORDS];
+        for (size_t j = 0; j < RECORD_WORDS; ++j) {
+            words[j] = slot.words[j].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) == before) {
+            (void)memcpy(&record, words, sizeof(words));
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t EventHistoryRing::Intern(const std::string &name)
+{
+    if (name.empty()) {
+        return 0;
+    }
+    auto it = nameIds_.find(name);
+    if (it != nameIds_.end()) {
+        return it->second;
+    }
+    if (nameIds_.size() >= MAX_NAME_NUM) {
+        return 0;
+    }
+    uint32_t id = 0;
+    {
+        std::lock_guard<std::mutex> lock(namesLock_);
+        id = static_cast<uint32_t>(names_.size());
+        names_.push_back(name);
+    }
+    nameIds_.emplace(name, id);
+    return id;
+}
+
+void EventHistoryRing::SetName(const std::string &name, Record &record)
+{
+    record.nameId = Intern(name);
+    if ((record.nameId != 0) || name.empty()) {
+        return;
+    }
+    // Name table is full, keep the name in the record, so that it is still shown in the dump.
+    size_t length = std::min(name.size(), static_cast<size_t>(MAX_INLINE_NAME_LEN));
+    (void)memcpy(record.inlineName, name.data(), length);
+    record.inlineName[length] = '\0';
+    record.flags |= FLAG_INLINE_NAME;
+}
+
+std::string EventHistoryRing::GetName(const Record &record) const
+{
+    if ((record.flags & FLAG_INLINE_NAME) != 0) {
+        return std::string(record.inlineName, strnlen(record.inlineName, MAX_INLINE_NAME_LEN));
+    }
+    return GetName(record.nameId);
+}
+
+std::string EventHistoryRing::GetName(uint32_t id) const
+{
+    std::lock_guard<std::mutex> lock(namesLock_);
+    return (id < names_.size()) ? names_[id] : std::string();
+}
+}  // namespace AppExecFwk
+}  // namespace OHOS
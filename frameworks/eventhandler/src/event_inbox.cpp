@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "event_inbox.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+EventInbox::~EventInbox()
+{
+    (void)Drain([](InnerEvent::Pointer &) {});
+}
+
+bool EventInbox::Push(InnerEvent::Pointer &event)
+{
+    auto deleter = event.get_deleter();
+    InnerEvent *node = event.release();
+    node->pendingLink_.inboxDeleter = deleter;
+    InnerEvent *head = head_.load(std::memory_order_relaxed);
+    do {
+        node->pendingLink_.inboxNext = head;
+    } while (!head_.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+    return head == nullptr;
+}
+
+size_t EventInbox::Drain(const Consumer &consumer)
+{
+    InnerEvent *node = head_.exchange(nullptr, std::memory_order_acquire);
+    // Reverse the stack into the order of pushing.
+    InnerEvent *ordered = nullptr;
+    while (node != nullptr) {
+        InnerEvent *next = node->pendingLink_.inboxNext;
+        node->pendingLink_.inboxNext = ordered;
+        ordered = node;
+        node = next;
+    }
+
+    size_t count = 0;
+    while (ordered != nullptr) {
+        InnerEvent *next = ordered->pendingLink_.inboxNext;
+        ordered->pendingLink_.inboxNext = nullptr;
+        InnerEvent::Pointer event(ordered, ordered->pendingLink_.inboxDeleter);
+        consumer(event);
+        ++count;
+        ordered = next;
+    }
+    return count;
+}
+}  // namespace AppExecFwk
+}  // namespace OHOS
@@ -132,11 +132,39 @@ void EventQueue::WaitUntilLocked(const InnerEvent::TimePoint &when, UniqueLockBa
     auto ioWaiterHolder = ioWaiter_;
     if (!ioWaiterHolder->WaitFor(lock, TimePointToTimeOut(when), vsyncOnly)) {
         HILOGE("Failed to call wait, reset IO waiter");
-        ioWaiter_ = std::make_shared<NoneIoWaiter>();
+        ioWaiter_ = std::make_shared<NoneIoWaiter>(waitStrategy_);
         listeners_.clear();
     }
 }
 
+bool EventQueue::SetWaitStrategy(WaitStrategy strategy)
+{
+    LockGuardBase lock(*queueLock_);
+    bool noneIoWaiter = ioWaiter_ && !ioWaiter_->SupportListeningFileDescriptor();
+    if ((strategy != WaitStrategy::BLOCK) && (IsMultiConsumerLocked() ||
+        (noneIoWaiter && (std::static_pointer_cast<NoneIoWaiter>(ioWaiter_)->GetWaiterNum() > 1)))) {
+        HILOGE("Only one waiting thread is supported by wait strategy %{public}u", static_cast<uint32_t>(strategy));
+        return false;
+    }
+    waitStrategy_ = strategy;
+    if (!noneIoWaiter) {
+        return true;
+    }
+    // Wake up the runner waiting on the old waiter, it waits on the new one next time.
+    ioWaiter_->NotifyAll();
+    ioWaiter_ = std::make_shared<NoneIoWaiter>(strategy);
+    return true;
+}
+
+void EventQueue::SetHighResolutionWait(bool enable)
+{
+    LockGuardBase lock(*queueLock_);
+    highResolutionWait_ = enable;
+    if (ioWaiter_) {
+        ioWaiter_->SetHighResolution(enable);
+    }
+}
+
 void EventQueue::CheckFileDescriptorEvent()
 {
     InnerEvent::TimePoint now = InnerEvent::Clock::now();
@@ -192,6 +220,7 @@ bool EventQueue::EnsureIoWaiterLocked(const std::shared_ptr<FileDescriptorListen
     newIoWaiter->SetFileDescriptorEventCallback(
         std::bind(&EventQueue::HandleFileDescriptorEvent, this, std::placeholders::_1, std::placeholders::_2,
         std::placeholders::_3, std::placeholders::_4));
+    newIoWaiter->SetHighResolution(highResolutionWait_);
 
     ioWaiter_->NotifyAll();
     ioWaiter_ = newIoWaiter;
@@ -271,6 +300,10 @@ void EventQueue::HandleFileDescriptorEvent(int32_t fileDescriptor, uint32_t even
     }
 
     bool isVsyncTask = handler->GetEventRunner() && listener->IsVsyncListener();
+    if (!isVsyncTask && listener->IsDirectDispatch() &&
+        RecordReadyFileDescriptor(fileDescriptor, events, listener, priority)) {
+        return;
+    }
     std::weak_ptr<FileDescriptorListener> wp = listener;
     auto f = [fileDescriptor, events, wp, isVsyncTask]() {
         auto queue = EventRunner::Current()->GetEventQueue();
@@ -284,21 +317,7 @@ void EventQueue::HandleFileDescriptorEvent(int32_t fileDescriptor, uint32_t even
             return;
         }
 
-        if ((events & FILE_DESCRIPTOR_INPUT_EVENT) != 0) {
-            listener->OnReadable(fileDescriptor);
-        }
-
-        if ((events & FILE_DESCRIPTOR_OUTPUT_EVENT) != 0) {
-            listener->OnWritable(fileDescriptor);
-        }
-
-        if ((events & FILE_DESCRIPTOR_SHUTDOWN_EVENT) != 0) {
-            listener->OnShutdown(fileDescriptor);
-        }
-
-        if ((events & FILE_DESCRIPTOR_EXCEPTION_EVENT) != 0) {
-            listener->OnException(fileDescriptor);
-        }
+        DispatchFileDescriptorEvents(listener, fileDescriptor, events);
 
         if (isVsyncTask) {
             queue->HandleVsyncTaskCompletely();
@@ -314,6 +333,26 @@ void EventQueue::HandleFileDescriptorEvent(int32_t fileDescriptor, uint32_t even
     }
 }
 
+void EventQueue::DispatchFileDescriptorEvents(const std::shared_ptr<FileDescriptorListener> &listener,
+    int32_t fileDescriptor, uint32_t events) __attribute__((no_sanitize("cfi")))
+{
+    if ((events & FILE_DESCRIPTOR_INPUT_EVENT) != 0) {
+        listener->OnReadable(fileDescriptor);
+    }
+
+    if ((events & FILE_DESCRIPTOR_OUTPUT_EVENT) != 0) {
+        listener->OnWritable(fileDescriptor);
+    }
+
+    if ((events & FILE_DESCRIPTOR_SHUTDOWN_EVENT) != 0) {
+        listener->OnShutdown(fileDescriptor);
+    }
+
+    if ((events & FILE_DESCRIPTOR_EXCEPTION_EVENT) != 0) {
+        listener->OnException(fileDescriptor);
+    }
+}
+
 void EventQueue::RemoveListenerByOwner(const std::shared_ptr<EventHandler> &owner)
 {
     if (!usable_.load()) {
@@ -47,44 +47,12 @@ static const int32_t VSYNC_TASK_DELAYMS_NO_BARRIER = system::GetIntParameter("co
 static const int32_t VSYNC_TASK_DELAYMS_DEFAULT_BARRIER = system::GetIntParameter("const.sys.param_vsync_delayms", 50);
 static const int32_t VSYNC_BARRIER_TIMEOUT = system::GetIntParameter("const.sys.param_vsync_barrier_timeout", 100);
 static constexpr int64_t MILLISECONDS_TO_NANOSECONDS_RATIO = 1000000;
-// Help to insert events into the event queue sorted by handle time.
-void InsertEventsLocked(std::list<InnerEvent::Pointer> &events, InnerEvent::Pointer &event,
-    EventInsertType insertType)
-{
-    if (insertType == EventInsertType::AT_FRONT) {
-        if (!events.empty()) {
-            // Ensure that events queue is in ordered
-            auto headEvent = events.begin();
-            if ((*headEvent)->GetHandleTime() < event->GetHandleTime()) {
-                event->SetHandleTime((*headEvent)->GetHandleTime());
-            }
-        }
-        events.emplace_front(std::move(event));
-        return;
-    }
-
-    auto it = events.end();
-    auto eventTime = event->GetHandleTime();
-    while (it != events.begin()) {
-        auto prevIt = std::prev(it);
-        if ((*prevIt) == nullptr) {
-            it = prevIt;
-            continue;
-        }
-        if ((*prevIt)->GetHandleTime() <= eventTime) {
-            break;
-        }
-        it = prevIt;
-    }
-    events.insert(it, std::move(event));
-}
-
 // Help to check whether there is a valid event in list and update wake up time.
-inline bool CheckEventInListLocked(const std::list<InnerEvent::Pointer> &events, const InnerEvent::TimePoint &now,
+inline bool CheckEventInListLocked(const PendingEventStore &events, const InnerEvent::TimePoint &now,
     InnerEvent::TimePoint &nextWakeUpTime)
 {
-    if (!events.empty()) {
-        const auto &handleTime = events.front()->GetHandleTime();
+    if (!events.Empty()) {
+        const auto &handleTime = events.Front()->GetHandleTime();
         if (handleTime < nextWakeUpTime) {
             nextWakeUpTime = handleTime;
             return handleTime <= now;
@@ -93,64 +61,48 @@ inline bool CheckEventInListLocked(const std::list<InnerEvent::Pointer> &events,
     return false;
 }
 
-inline bool CheckBarrierTaskInListLocked(const std::list<InnerEvent::Pointer> &events, const InnerEvent::TimePoint &now,
+inline bool CheckBarrierTaskInListLocked(const PendingEventStore &events, const InnerEvent::TimePoint &now,
     InnerEvent::TimePoint &nextWakeUpTime)
 {
-    if (events.empty()) return false;
-    for (auto it = events.begin(); it != events.end(); it++) {
-        const auto &handleTime = (*it)->GetHandleTime();
-        if (handleTime < nextWakeUpTime) nextWakeUpTime = handleTime;
-        if (handleTime > now) break;
-        if ((*it)->IsBarrierTask()) return true;
-    }
-    return false;
-}
-
-inline InnerEvent::Pointer PopFrontEventFromListLocked(std::list<InnerEvent::Pointer> &events)
-{
-    InnerEvent::Pointer event = std::move(events.front());
-    events.pop_front();
-    return event;
+    if (events.Empty()) return false;
+    const auto &handleTime = events.Front()->GetHandleTime();
+    if (handleTime < nextWakeUpTime) nextWakeUpTime = handleTime;
+    if (handleTime > now) return false;
+    return events.HasExpiredIf(now, [](const InnerEvent::Pointer &p) { return p->IsBarrierTask(); });
 }
 
-inline InnerEvent::Pointer PopFrontBarrierEventFromListLocked(std::list<InnerEvent::Pointer> &events)
+inline InnerEvent::Pointer PopFrontBarrierEventFromListLocked(PendingEventStore &events)
 {
     auto filter = [](const InnerEvent::Pointer &p) {
         return p->IsBarrierTask();
     };
-    std::list<InnerEvent::Pointer>::iterator iter = std::find_if(events.begin(), events.end(), filter);
-    if (iter != events.end()) {
-        std::list<InnerEvent::Pointer> tempList;
-        tempList.splice(tempList.begin(), events, iter);
-        return PopFrontEventFromListLocked(tempList);
-    }
-    return InnerEvent::Pointer(nullptr, nullptr);
+    return events.PopFirstIf(filter);
 }
 
-inline InnerEvent::Pointer PopFrontBarrierEventFromListWithTimeLocked(std::list<InnerEvent::Pointer> &events,
+inline InnerEvent::Pointer PopFrontBarrierEventFromListWithTimeLocked(PendingEventStore &events,
     const InnerEvent::TimePoint &sendTime, const InnerEvent::TimePoint &handleTime)
 {
     auto filter = [&sendTime, &handleTime](const InnerEvent::Pointer &p) {
         return p->IsBarrierTask() && (p->GetSendTime() <= sendTime) && (p->GetHandleTime() <= handleTime);
     };
-    std::list<InnerEvent::Pointer>::iterator iter = std::find_if(events.begin(), events.end(), filter);
-    if (iter != events.end()) {
-        std::list<InnerEvent::Pointer> tempList;
-        tempList.splice(tempList.begin(), events, iter);
-        return PopFrontEventFromListLocked(tempList);
-    }
-    return InnerEvent::Pointer(nullptr, nullptr);
+    return events.PopFirstIf(filter);
+}
+
+inline uint64_t GetFrontEventHandleTime(const PendingEventStore &events)
+{
+    return events.Empty() ? UINT64_MAX :
+        static_cast<uint64_t>(events.Front()->GetHandleTime().time_since_epoch().count());
 }
 }  // unnamed namespace
 
 EventQueueBase::EventQueueBase(EventLockType lockType)
-    : EventQueue(lockType), historyEvents_(std::vector<HistoryEvent>(HISTORY_EVENT_NUM_POWER))
+    : EventQueue(lockType), historyRing_(std::make_unique<EventHistoryRing>(DEFAULT_HISTORY_DEPTH))
 {
     HILOGD("enter");
 }
 
 EventQueueBase::EventQueueBase(const std::shared_ptr<IoWaiter> &ioWaiter, EventLockType lockType)
-    : EventQueue(ioWaiter, lockType), historyEvents_(std::vector<HistoryEvent>(HISTORY_EVENT_NUM_POWER))
+    : EventQueue(ioWaiter, lockType), historyRing_(std::make_unique<EventHistoryRing>(DEFAULT_HISTORY_DEPTH))
 {
     HILOGD("enter");
 }
@@ -159,6 +111,7 @@ EventQueueBase::~EventQueueBase()
 {
     LockGuardBase lock(*queueLock_);
     usable_.store(false);
+    DrainInboxLocked();
     ioWaiter_ = nullptr;
     ClearObserver();
     HILOGD("EventQueueBase is unavailable hence");
@@ -195,13 +148,213 @@ bool EventQueueBase::Insert(InnerEvent::Pointer &event, Priority priority, Event
         HILOGE("Could not insert an invalid event");
         return false;
     }
-    HILOGD("Insert task: %{public}s %{public}d.", (event->GetEventUniqueId()).c_str(), insertType);
+    HILOGD("Insert task: %{public}llu %{public}d.", static_cast<unsigned long long>(event->GetEventUniqueId()),
+        insertType);
     MarkBarrierTaskIfNeed(event, option, vsyncPolicy_);
+    if (inboxEnabled_.load(std::memory_order_relaxed) && (insertType == EventInsertType::AT_END) &&
+        ((priority == Priority::IMMEDIATE) || (priority == Priority::HIGH) || (priority == Priority::LOW)) &&
+        !event->IsVsyncTask()) {
+        return InsertIntoInbox(event, priority);
+    }
+    LockGuardBase lock(*queueLock_);
+    if (!usable_.load()) {
+        HILOGW("EventQueue is unavailable.");
+        return false;
+    }
+    // Events in inbox are sent earlier, insert them first to keep the order.
+    DrainInboxLocked();
+    if (InsertLocked(event, priority, insertType)) {
+        ioWaiter_->NotifyOne();
+    }
+    if (priority == Priority::VIP) {
+        OnVipTaskInsertedLocked();
+    }
+    return true;
+}
+
+bool EventQueueBase::InsertEvents(std::vector<InsertItem> &items)
+{
+    for (auto &item : items) {
+        if (!item.event) {
+            HILOGE("Could not insert an invalid event");
+            return false;
+        }
+    }
+    for (auto &item : items) {
+        MarkBarrierTaskIfNeed(item.event, VsyncBarrierOption::NO_BARRIER, vsyncPolicy_);
+    }
+    LockGuardBase lock(*queueLock_);
+    if (!usable_.load()) {
+        HILOGW("EventQueue is unavailable.");
+        return false;
+    }
+    DrainInboxLocked();
+    bool needNotify = false;
+    bool hasVipTask = false;
+    for (auto &item : items) {
+        needNotify = InsertLocked(item.event, item.priority, EventInsertType::AT_END) || needNotify;
+        hasVipTask = hasVipTask || (item.priority == Priority::VIP);
+    }
+    // Wake up the runner once for the whole batch.
+    if (needNotify) {
+        ioWaiter_->NotifyOne();
+    }
+    if (hasVipTask) {
+        OnVipTaskInsertedLocked();
+    }
+    return true;
+}
+
+bool EventQueueBase::InsertCoalesced(InnerEvent::Pointer &event, Priority priority, uint64_t key,
+    CoalescePolicy policy)
+{
+    if (!event) {
+        HILOGE("Could not insert an invalid event");
+        return false;
+    }
+    MarkBarrierTaskIfNeed(event, VsyncBarrierOption::NO_BARRIER, vsyncPolicy_);
+    // Release the merged event after the lock is released, since it may hold anything.
+    InnerEvent::Pointer merged(nullptr, nullptr);
     LockGuardBase lock(*queueLock_);
     if (!usable_.load()) {
         HILOGW("EventQueue is unavailable.");
         return false;
     }
+    DrainInboxLocked();
+    PendingEventStore *store = GetStoreLocked(priority);
+    InnerEvent *pending = (store != nullptr) ? store->FindCoalesced(event->GetOwnerId(), key) : nullptr;
+    bool replace = (policy == CoalescePolicy::REPLACE_LATEST);
+    if ((pending != nullptr) && PendingEventStore::Merge(*pending, *event, replace)) {
+        HILOGD("Coalesce task: %{public}llu into %{public}llu.",
+            static_cast<unsigned long long>(event->GetEventUniqueId()),
+            static_cast<unsigned long long>(pending->GetEventUniqueId()));
+        if (replace) {
+            ++coalescedReplacedCount_;
+        } else {
+            ++coalescedDroppedCount_;
+        }
+        merged = std::move(event);
+        return true;
+    }
+    PendingEventStore::SetCoalesceKey(*event, key);
+    if (InsertLocked(event, priority, EventInsertType::AT_END)) {
+        ioWaiter_->NotifyOne();
+    }
+    if (priority == Priority::VIP) {
+        OnVipTaskInsertedLocked();
+    }
+    return true;
+}
+
+PendingEventStore *EventQueueBase::GetStoreLocked(Priority priority)
+{
+    switch (priority) {
+        case Priority::VIP:
+        case Priority::IMMEDIATE:
+        case Priority::HIGH:
+        case Priority::LOW:
+            return subEventQueues_[static_cast<uint32_t>(priority)].queue.get();
+        case Priority::IDLE:
+            return idleEvents_.get();
+        default:
+            return nullptr;
+    }
+}
+
+InnerEvent *EventQueueBase::FindWithHandleLocked(uint64_t eventUniqueId, Priority &priority)
+{
+    if (eventUniqueId == 0) {
+        return nullptr;
+    }
+    // Each store indexes its own events, so look up all priorities instead of trusting the priority of the event.
+    for (uint32_t i = 0; i <= static_cast<uint32_t>(Priority::IDLE); ++i) {
+        auto store = GetStoreLocked(static_cast<Priority>(i));
+        InnerEvent *event = (store != nullptr) ? store->FindWithHandle(eventUniqueId) : nullptr;
+        if (event != nullptr) {
+            priority = static_cast<Priority>(i);
+            return event;
+        }
+    }
+    return nullptr;
+}
+
+InnerEvent::Pointer EventQueueBase::RemoveFromStoreLocked(InnerEvent &event, Priority priority)
+{
+    if (priority == Priority::IDLE) {
+        return idleEvents_->Remove(event);
+    }
+    auto &subQueue = subEventQueues_[static_cast<uint32_t>(priority)];
+    auto removed = subQueue.queue->Remove(event);
+    subQueue.frontEventHandleTime = GetFrontEventHandleTime(*subQueue.queue);
+    return removed;
+}
+
+bool EventQueueBase::CancelByHandle(uint64_t eventUniqueId)
+{
+    // Release the removed event after the lock is released, since it may hold anything.
+    InnerEvent::Pointer removed(nullptr, nullptr);
+    LockGuardBase lock(*queueLock_);
+    if (!usable_.load()) {
+        HILOGW("EventQueueBase is unavailable.");
+        return false;
+    }
+    DrainInboxLocked();
+    Priority priority = Priority::LOW;
+    InnerEvent *event = FindWithHandleLocked(eventUniqueId, priority);
+    if (event == nullptr) {
+        return false;
+    }
+    HILOGD("Cancel task: %{public}llu.", static_cast<unsigned long long>(eventUniqueId));
+    removed = RemoveFromStoreLocked(*event, priority);
+    return true;
+}
+
+bool EventQueueBase::IsPendingByHandle(uint64_t eventUniqueId)
+{
+    LockGuardBase lock(*queueLock_);
+    if (!usable_.load()) {
+        HILOGW("EventQueueBase is unavailable.");
+        return false;
+    }
+    DrainInboxLocked();
+    Priority priority = Priority::LOW;
+    return FindWithHandleLocked(eventUniqueId, priority) != nullptr;
+}
+
+bool EventQueueBase::ReprioritizeByHandle(uint64_t eventUniqueId, Priority priority)
+{
+    if (priority > Priority::IDLE) {
+        HILOGE("Could not move a task into priority %{public}u", static_cast<uint32_t>(priority));
+        return false;
+    }
+    LockGuardBase lock(*queueLock_);
+    if (!usable_.load()) {
+        HILOGW("EventQueueBase is unavailable.");
+        return false;
+    }
+    DrainInboxLocked();
+    Priority oldPriority = Priority::LOW;
+    InnerEvent *event = FindWithHandleLocked(eventUniqueId, oldPriority);
+    if (event == nullptr) {
+        return false;
+    }
+    if (oldPriority == priority) {
+        return true;
+    }
+    HILOGD("Reprioritize task: %{public}llu %{public}u.", static_cast<unsigned long long>(eventUniqueId),
+        static_cast<uint32_t>(priority));
+    auto moved = RemoveFromStoreLocked(*event, oldPriority);
+    if (InsertLocked(moved, priority, EventInsertType::AT_END)) {
+        ioWaiter_->NotifyOne();
+    }
+    if (priority == Priority::VIP) {
+        OnVipTaskInsertedLocked();
+    }
+    return true;
+}
+
+bool EventQueueBase::InsertLocked(InnerEvent::Pointer &event, Priority priority, EventInsertType insertType)
+{
     bool needNotify = false;
     event->SetEventPriority(static_cast<int32_t>(priority));
     switch (priority) {
@@ -214,41 +367,115 @@ bool EventQueueBase::Insert(InnerEvent::Pointer &event, Priority priority, Event
                 needNotify = true;
                 DispatchVsyncTaskNotify();
             }
-            InsertEventsLocked(subEventQueues_[static_cast<uint32_t>(priority)].queue, event, insertType);
-            subEventQueues_[static_cast<uint32_t>(priority)].frontEventHandleTime =
-                static_cast<uint64_t>((*subEventQueues_[static_cast<uint32_t>(priority)].queue.begin())
-                    ->GetHandleTime().time_since_epoch().count());
+            auto &subQueue = subEventQueues_[static_cast<uint32_t>(priority)];
+            subQueue.queue->Insert(event, insertType);
+            subQueue.frontEventHandleTime = GetFrontEventHandleTime(*subQueue.queue);
             break;
         }
         case Priority::IDLE: {
             // Never wake up thread if insert an idle event.
-            InsertEventsLocked(idleEvents_, event, insertType);
+            idleEvents_->Insert(event, insertType);
             break;
         }
         default:
             break;
     }
+    return needNotify;
+}
 
-    if (needNotify) {
-        ioWaiter_->NotifyOne();
-    }
+void EventQueueBase::OnVipTaskInsertedLocked()
+{
 #ifdef NOTIFICATIONG_SMART_GC
-    if (priority == Priority::VIP && !isExistVipTask_) {
+    if (!isExistVipTask_) {
         isExistVipTask_ = true;
         InnerEvent::TimePoint time = InnerEvent::Clock::now();
         TryExecuteObserverCallback(time, EventRunnerStage::STAGE_VIP_EXISTED);
     }
 #endif
+}
+
+bool EventQueueBase::InsertIntoInbox(InnerEvent::Pointer &event, Priority priority)
+{
+    if (!usable_.load()) {
+        HILOGW("EventQueue is unavailable.");
+        return false;
+    }
+    event->SetEventPriority(static_cast<int32_t>(priority));
+    if (!inbox_.Push(event)) {
+        // Someone else has pushed into an empty inbox and woken up the runner, which will drain this event too.
+        return true;
+    }
+    /*
+     * Notify under the lock, so that the notification can not fall into the gap between the runner
+     * draining the inbox and starting to wait.
+     */
+    LockGuardBase lock(*queueLock_);
+    if (usable_.load() && ioWaiter_) {
+        ioWaiter_->NotifyOne();
+    }
     return true;
 }
 
+void EventQueueBase::DrainInboxLocked()
+{
+    if (inbox_.Empty()) {
+        return;
+    }
+    inbox_.Drain([this](InnerEvent::Pointer &event) {
+        auto &subQueue = subEventQueues_[static_cast<uint32_t>(event->GetEventPriority())];
+        subQueue.queue->Insert(event, EventInsertType::AT_END);
+        subQueue.frontEventHandleTime = GetFrontEventHandleTime(*subQueue.queue);
+    });
+}
+
+void EventQueueBase::SetMultiConsumer(bool enable)
+{
+    LockGuardBase lock(*queueLock_);
+    multiConsumer_ = enable;
+    busyOwners_.clear();
+    waitingForOwner_ = false;
+}
+
+bool EventQueueBase::IsMultiConsumerLocked() const
+{
+    return multiConsumer_;
+}
+
+void EventQueueBase::ReleaseOwner(uint64_t ownerId)
+{
+    LockGuardBase lock(*queueLock_);
+    // Wake up a consumer only if due events were left for busy owners, the releasing one checks the queue anyway.
+    if ((busyOwners_.erase(ownerId) > 0) && waitingForOwner_) {
+        waitingForOwner_ = false;
+        ioWaiter_->NotifyOne();
+    }
+}
+
+bool EventQueueBase::TryAcquireOwner(uint64_t ownerId)
+{
+    LockGuardBase lock(*queueLock_);
+    if ((!multiConsumer_) || (ownerId == 0)) {
+        return false;
+    }
+    return busyOwners_.insert(ownerId).second;
+}
+
+void EventQueueBase::SetInboxEnabled(bool enable)
+{
+    inboxEnabled_.store(enable);
+    if (!enable) {
+        LockGuardBase lock(*queueLock_);
+        DrainInboxLocked();
+    }
+}
+
 void EventQueueBase::RemoveOrphan()
 {
     HILOGD("enter");
     // Remove all events which lost its owner.
-    auto filter = [this](const InnerEvent::Pointer &p) {
-        bool ret = p->GetWeakOwner().expired();
-        if (ret && p->IsVsyncTask()) {
+    auto filter = [this](InnerEvent &event) {
+        bool ret = event.GetWeakOwner().expired();
+        if (ret && event.IsVsyncTask()) {
             HandleVsyncTaskNotify();
             SetBarrierMode(false);
             needEpoll_ = false;
@@ -270,16 +497,22 @@ void EventQueueBase::RemoveOrphan()
 void EventQueueBase::RemoveAll()
 {
     HILOGD("enter");
+    // Swap in empty stores, so that the removed events are released after unlock, since they may hold anything.
+    std::unique_ptr<PendingEventStore> releaseStores[SUB_EVENT_QUEUE_NUM + 1];
+    for (auto &store : releaseStores) {
+        store = PendingEventStore::Create();
+    }
     LockGuardBase lock(*queueLock_);
     if (!usable_.load()) {
         HILOGW("RemoveAll EventQueueBase is unavailable.");
         return;
     }
+    DrainInboxLocked();
     for (uint32_t i = 0; i < SUB_EVENT_QUEUE_NUM; ++i) {
-        subEventQueues_[i].queue.clear();
+        subEventQueues_[i].queue.swap(releaseStores[i]);
         subEventQueues_[i].frontEventHandleTime = UINT64_MAX;
     }
-    idleEvents_.clear();
+    idleEvents_.swap(releaseStores[SUB_EVENT_QUEUE_NUM]);
 }
 
 void EventQueueBase::Remove(const std::shared_ptr<EventHandler> &owner)
@@ -290,9 +523,10 @@ void EventQueueBase::Remove(const std::shared_ptr<EventHandler> &owner)
         return;
     }
 
-    auto filter = [&owner](const InnerEvent::Pointer &p) { return (p->GetOwnerId() == owner->GetHandlerId()); };
-
-    Remove(filter);
+    uint64_t ownerId = owner->GetHandlerId();
+    Remove([ownerId](PendingEventStore &events, std::list<InnerEvent::Pointer> &removed) {
+        return events.ExtractOwnerIf(ownerId, [](InnerEvent &) { return true; }, removed);
+    });
 }
 
 void EventQueueBase::Remove(const std::shared_ptr<EventHandler> &owner, uint32_t innerEventId)
@@ -302,11 +536,11 @@ void EventQueueBase::Remove(const std::shared_ptr<EventHandler> &owner, uint32_t
         HILOGE("Invalid owner");
         return;
     }
-    auto filter = [&owner, innerEventId](const InnerEvent::Pointer &p) {
-        return (!p->HasTask()) && (p->GetOwnerId() == owner->GetHandlerId()) && (p->GetInnerEventId() == innerEventId);
-    };
 
-    Remove(filter);
+    uint64_t ownerId = owner->GetHandlerId();
+    Remove([ownerId, innerEventId](PendingEventStore &events, std::list<InnerEvent::Pointer> &removed) {
+        return events.ExtractOwnerEventIf(ownerId, innerEventId, [](InnerEvent &) { return true; }, removed);
+    });
 }
 
 void EventQueueBase::Remove(const std::shared_ptr<EventHandler> &owner, uint32_t innerEventId, int64_t param)
@@ -317,12 +551,11 @@ void EventQueueBase::Remove(const std::shared_ptr<EventHandler> &owner, uint32_t
         return;
     }
 
-    auto filter = [&owner, innerEventId, param](const InnerEvent::Pointer &p) {
-        return (!p->HasTask()) && (p->GetOwnerId() == owner->GetHandlerId()) && (p->GetInnerEventId() == innerEventId)
-        && (p->GetParam() == param);
-    };
-
-    Remove(filter);
+    uint64_t ownerId = owner->GetHandlerId();
+    auto filter = [param](InnerEvent &event) { return event.GetParam() == param; };
+    Remove([ownerId, innerEventId, &filter](PendingEventStore &events, std::list<InnerEvent::Pointer> &removed) {
+        return events.ExtractOwnerEventIf(ownerId, innerEventId, filter, removed);
+    });
 }
 
 bool EventQueueBase::Remove(const std::shared_ptr<EventHandler> &owner, const std::string &name)
@@ -333,71 +566,63 @@ bool EventQueueBase::Remove(const std::shared_ptr<EventHandler> &owner, const st
         return false;
     }
 
-    bool removed = false;
-    auto filter = [&owner, &name, &removed](const InnerEvent::Pointer &p) {
-        if (p == nullptr) {
-            return false;
-        }
-        bool ret = (p->HasTask()) && (p->GetOwnerId() == owner->GetHandlerId()) && (p->GetTaskName() == name);
-        if (!removed) {
-            removed = ret;
-        }
-        return ret;
-    };
-
-    Remove(filter);
-    return removed;
+    uint64_t ownerId = owner->GetHandlerId();
+    auto filter = [&name](InnerEvent &event) { return event.HasTask() && (event.GetTaskName() == name); };
+    return Remove([ownerId, &filter](PendingEventStore &events, std::list<InnerEvent::Pointer> &removed) {
+        return events.ExtractOwnerIf(ownerId, filter, removed);
+    }) > 0;
 }
 
-void EventQueueBase::Remove(const RemoveFilter &filter) __attribute__((no_sanitize("cfi")))
+size_t EventQueueBase::Remove(const StoreRemover &remover) __attribute__((no_sanitize("cfi")))
 {
     HILOGD("Remove filter enter");
+    // Release the removed events after unlock, since they may hold anything.
+    std::list<InnerEvent::Pointer> releaseEvents;
     LockGuardBase lock(*queueLock_);
     if (!usable_.load()) {
         HILOGW("EventQueueBase is unavailable.");
-        return;
+        return 0;
     }
+    DrainInboxLocked();
 #ifdef NOTIFICATIONG_SMART_GC
     bool result = HasVipTask();
 #endif
+    size_t removed = 0;
     for (uint32_t i = 0; i < SUB_EVENT_QUEUE_NUM; ++i) {
-        subEventQueues_[i].queue.remove_if(filter);
-        subEventQueues_[i].frontEventHandleTime = (subEventQueues_[i].queue.size() ?
-            static_cast<uint64_t>((*subEventQueues_[i].queue.begin())
-            ->GetHandleTime().time_since_epoch().count()) : UINT64_MAX);
+        size_t count = remover(*subEventQueues_[i].queue, releaseEvents);
+        if (count > 0) {
+            removed += count;
+            subEventQueues_[i].frontEventHandleTime = GetFrontEventHandleTime(*subEventQueues_[i].queue);
+        }
     }
-    idleEvents_.remove_if(filter);
+    removed += remover(*idleEvents_, releaseEvents);
 #ifdef NOTIFICATIONG_SMART_GC
     if (result) {
         NotifyObserverVipDoneBase();
     }
 #endif
+    return removed;
 }
 
 void EventQueueBase::RemoveOrphan(const RemoveFilter &filter)
 {
-    std::list<InnerEvent::Pointer> releaseIdleEvents;
-    std::array<SubEventQueue, SUB_EVENT_QUEUE_NUM> releaseEventsQueue;
+    // Release the removed events after unlock.
+    std::list<InnerEvent::Pointer> releaseEvents;
     {
         LockGuardBase lock(*queueLock_);
         if (!usable_.load()) {
             HILOGW("EventQueueBase is unavailable.");
             return;
         }
+        DrainInboxLocked();
 #ifdef NOTIFICATIONG_SMART_GC
         bool result = HasVipTask();
 #endif
         for (uint32_t i = 0; i < SUB_EVENT_QUEUE_NUM; ++i) {
-            auto it = std::stable_partition(subEventQueues_[i].queue.begin(), subEventQueues_[i].queue.end(), filter);
-            std::move(subEventQueues_[i].queue.begin(), it, std::back_inserter(releaseEventsQueue[i].queue));
-            subEventQueues_[i].queue.erase(subEventQueues_[i].queue.begin(), it);
-            subEventQueues_[i].frontEventHandleTime = (subEventQueues_[i].queue.size() ?
-            static_cast<uint64_t>((*subEventQueues_[i].queue.begin())
-            ->GetHandleTime().time_since_epoch().count()) : UINT64_MAX);
+            subEventQueues_[i].queue->ExtractOrphansIf(filter, releaseEvents);
+            subEventQueues_[i].frontEventHandleTime = GetFrontEventHandleTime(*subEventQueues_[i].queue);
         }
-        auto idleEventIt = std::stable_partition(idleEvents_.begin(), idleEvents_.end(), filter);
-        std::move(idleEvents_.begin(), idleEventIt, std::back_inserter(releaseIdleEvents));
-        idleEvents_.erase(idleEvents_.begin(), idleEventIt);
+        idleEvents_->ExtractOrphansIf(filter, releaseEvents);
 #ifdef NOTIFICATIONG_SMART_GC
         if (result) {
             NotifyObserverVipDoneBase();
@@ -412,10 +637,11 @@ bool EventQueueBase::HasInnerEvent(const std::shared_ptr<EventHandler> &owner, u
         HILOGE("Invalid owner");
         return false;
     }
-    auto filter = [&owner, innerEventId](const InnerEvent::Pointer &p) {
-        return (!p->HasTask()) && (p->GetOwner() == owner) && (p->GetInnerEventId() == innerEventId);
-    };
-    return HasInnerEvent(filter);
+    uint64_t ownerId = owner->GetHandlerId();
+    auto filter = [&owner](InnerEvent &event) { return event.GetOwner() == owner; };
+    return HasInnerEvent([ownerId, innerEventId, &filter](const PendingEventStore &events) {
+        return events.AnyOfOwnerEvent(ownerId, innerEventId, filter);
+    });
 }
 
 bool EventQueueBase::HasInnerEvent(const std::shared_ptr<EventHandler> &owner, int64_t param)
@@ -424,45 +650,38 @@ bool EventQueueBase::HasInnerEvent(const std::shared_ptr<EventHandler> &owner, i
         HILOGE("Invalid owner");
         return false;
     }
-    auto filter = [&owner, param](const InnerEvent::Pointer &p) {
-        return (!p->HasTask()) && (p->GetOwner() == owner) && (p->GetParam() == param);
+    uint64_t ownerId = owner->GetHandlerId();
+    auto filter = [&owner, param](InnerEvent &event) {
+        return (!event.HasTask()) && (event.GetOwner() == owner) && (event.GetParam() == param);
     };
-    return HasInnerEvent(filter);
+    return HasInnerEvent([ownerId, &filter](const PendingEventStore &events) {
+        return events.AnyOfOwner(ownerId, filter);
+    });
 }
 
-bool EventQueueBase::HasInnerEvent(const HasFilter &filter)
+bool EventQueueBase::HasInnerEvent(const StoreMatcher &matcher)
 {
     LockGuardBase lock(*queueLock_);
     if (!usable_.load()) {
         HILOGW("EventQueueBase is unavailable.");
         return false;
     }
+    DrainInboxLocked();
     for (uint32_t i = 0; i < SUB_EVENT_QUEUE_NUM; ++i) {
-        std::list<InnerEvent::Pointer>::iterator iter =
-            std::find_if(subEventQueues_[i].queue.begin(), subEventQueues_[i].queue.end(), filter);
-        if (iter != subEventQueues_[i].queue.end()) {
+        if (matcher(*subEventQueues_[i].queue)) {
             return true;
         }
     }
-    if (std::find_if(idleEvents_.begin(), idleEvents_.end(), filter) != idleEvents_.end()) {
-        return true;
-    }
-    return false;
+    return matcher(*idleEvents_);
 }
 
 InnerEvent::Pointer EventQueueBase::PickFirstVsyncEventLocked()
 {
-    auto &events = subEventQueues_[static_cast<uint32_t>(Priority::VIP)].queue;
+    auto &events = *subEventQueues_[static_cast<uint32_t>(Priority::VIP)].queue;
     auto filter = [](const InnerEvent::Pointer &p) {
         return p->IsVsyncTask();
     };
-    std::list<InnerEvent::Pointer>::iterator iter = std::find_if(events.begin(), events.end(), filter);
-    if (iter != events.end()) {
-        std::list<InnerEvent::Pointer> tempList;
-        tempList.splice(tempList.begin(), events, iter);
-        return PopFrontEventFromListLocked(tempList);
-    }
-    return InnerEvent::Pointer(nullptr, nullptr);
+    return events.PopFirstIf(filter);
 }
 
 InnerEvent::Pointer EventQueueBase::PickEventLocked(const InnerEvent::TimePoint &now,
@@ -473,10 +692,14 @@ InnerEvent::Pointer EventQueueBase::PickEventLocked(const InnerEvent::TimePoint
     for (uint32_t i = 0; i < SUB_EVENT_QUEUE_NUM; ++i) {
         // Check whether any event need to be distributed.
         if (isBarrierMode) {
-            if (!CheckBarrierTaskInListLocked(subEventQueues_[i].queue, now, nextWakeUpTime)) {
+            if (!CheckBarrierTaskInListLocked(*subEventQueues_[i].queue, now, nextWakeUpTime)) {
+                continue;
+            }
+        } else if (multiConsumer_) {
+            if (!CheckIdleOwnerEventInListLocked(*subEventQueues_[i].queue, now, nextWakeUpTime)) {
                 continue;
             }
-        } else if (!CheckEventInListLocked(subEventQueues_[i].queue, now, nextWakeUpTime)) {
+        } else if (!CheckEventInListLocked(*subEventQueues_[i].queue, now, nextWakeUpTime)) {
             continue;
         }
 
@@ -511,24 +734,76 @@ InnerEvent::Pointer EventQueueBase::PickEventLocked(const InnerEvent::TimePoint
         subEventQueues_[i].handledEventsCount = 0;
     }
     if (isBarrierMode) {
-        return PopFrontBarrierEventFromListLocked(subEventQueues_[priorityIndex].queue);
+        return PopFrontBarrierEventFromListLocked(*subEventQueues_[priorityIndex].queue);
+    }
+    if (multiConsumer_) {
+        return PopFirstIdleOwnerEventLocked(*subEventQueues_[priorityIndex].queue, now);
+    }
+    return subEventQueues_[priorityIndex].queue->PopFront();
+}
+
+bool EventQueueBase::IsOwnerBusyLocked(const InnerEvent &event) const
+{
+    return !busyOwners_.empty() && (busyOwners_.find(event.GetOwnerId()) != busyOwners_.end());
+}
+
+void EventQueueBase::AcquireOwnerLocked(const InnerEvent &event)
+{
+    // Events without owner are never distributed, nothing to serialize.
+    if (multiConsumer_ && (event.GetOwnerId() != 0)) {
+        busyOwners_.insert(event.GetOwnerId());
+    }
+}
+
+// Same as 'CheckEventInListLocked', but only counts the due events whose owner is not busy.
+bool EventQueueBase::CheckIdleOwnerEventInListLocked(const PendingEventStore &events,
+    const InnerEvent::TimePoint &now, InnerEvent::TimePoint &nextWakeUpTime)
+{
+    if (events.Empty()) {
+        return false;
+    }
+    const auto &front = events.Front();
+    if ((front->GetHandleTime() > now) || !IsOwnerBusyLocked(*front)) {
+        return CheckEventInListLocked(events, now, nextWakeUpTime);
+    }
+    if (front->GetHandleTime() >= nextWakeUpTime) {
+        return false;
+    }
+    if (events.HasExpiredIf(now, [this](const InnerEvent::Pointer &event) { return !IsOwnerBusyLocked(*event); })) {
+        nextWakeUpTime = front->GetHandleTime();
+        return true;
     }
-    return PopFrontEventFromListLocked(subEventQueues_[priorityIndex].queue);
+    // All due events wait for their owners, which wake up a consumer when released, so wait for the others only.
+    waitingForOwner_ = true;
+    nextWakeUpTime = std::min(nextWakeUpTime, events.FirstHandleTimeAfter(now));
+    return false;
+}
+
+InnerEvent::Pointer EventQueueBase::PopFirstIdleOwnerEventLocked(PendingEventStore &events,
+    const InnerEvent::TimePoint &now)
+{
+    if (!IsOwnerBusyLocked(*events.Front())) {
+        return events.PopFront();
+    }
+    return events.PopFirstIf([this, &now](const InnerEvent::Pointer &event) {
+        return (event->GetHandleTime() <= now) && !IsOwnerBusyLocked(*event);
+    });
 }
 
 InnerEvent::Pointer EventQueueBase::GetExpiredEventLocked(InnerEvent::TimePoint &nextExpiredTime)
 {
+    DrainInboxLocked();
     auto now = InnerEvent::Clock::now();
     wakeUpTime_ = InnerEvent::TimePoint::max();
     // Find an event which could be distributed right now.
     InnerEvent::Pointer event = PickEventLocked(now, wakeUpTime_);
     if (event) {
         int32_t prio = event->GetEventPriority();
-        subEventQueues_[prio].frontEventHandleTime = subEventQueues_[prio].queue.empty() ? UINT64_MAX :
-            static_cast<uint64_t>((*subEventQueues_[prio].queue.begin())->GetHandleTime().time_since_epoch().count());
+        subEventQueues_[prio].frontEventHandleTime = GetFrontEventHandleTime(*subEventQueues_[prio].queue);
         // Exit idle mode, if found an event to distribute.
         isIdle_ = false;
         currentRunningEvent_ = CurrentRunningEvent(now, event);
+        AcquireOwnerLocked(*event);
         return event;
     }
 
@@ -538,20 +813,23 @@ InnerEvent::Pointer EventQueueBase::GetExpiredEventLocked(InnerEvent::TimePoint
         isIdle_ = true;
     }
 
-    if (!idleEvents_.empty()) {
+    if (!idleEvents_->Empty()) {
         if (isBarrierMode_) {
-            event = PopFrontBarrierEventFromListWithTimeLocked(idleEvents_, idleTimeStamp_, now);
+            event = PopFrontBarrierEventFromListWithTimeLocked(*idleEvents_, idleTimeStamp_, now);
             if (event) {
                 currentRunningEvent_ = CurrentRunningEvent(now, event);
+                AcquireOwnerLocked(*event);
                 return event;
             }
         } else {
-            const auto &idleEvent = idleEvents_.front();
+            const auto &idleEvent = idleEvents_->Front();
 
             // Return the idle event that has been sent before time stamp and reaches its handle time.
-            if ((idleEvent->GetSendTime() <= idleTimeStamp_) && (idleEvent->GetHandleTime() <= now)) {
-                event = PopFrontEventFromListLocked(idleEvents_);
+            if ((idleEvent->GetSendTime() <= idleTimeStamp_) && (idleEvent->GetHandleTime() <= now) &&
+                !IsOwnerBusyLocked(*idleEvent)) {
+                event = idleEvents_->PopFront();
                 currentRunningEvent_ = CurrentRunningEvent(now, event);
+                AcquireOwnerLocked(*event);
                 return event;
             }
         }
@@ -598,13 +876,19 @@ void EventQueueBase::CheckBarrierMode()
 InnerEvent::Pointer EventQueueBase::GetEvent()
 {
     UniqueLockBase lock(*queueLock_);
+    bool poolTrimmed = false;
     while (!finished_) {
         CheckBarrierMode();
+        InnerEvent::Pointer event = PickReadyFileDescriptorEventLocked(InnerEvent::Clock::now());
+        if (event) {
+            return event;
+        }
         InnerEvent::TimePoint nextWakeUpTime = InnerEvent::TimePoint::max();
-        InnerEvent::Pointer event = GetExpiredEventLocked(nextWakeUpTime);
+        event = GetExpiredEventLocked(nextWakeUpTime);
         if (event) {
             auto now = InnerEvent::Clock::now();
-            if (!isLazyMode_.load() && !sumOfPendingVsync_ && (needEpoll_ || vsyncCheckTime_ <
+            // Nothing to poll with multiple consumers, and polling would take the wake up of another consumer.
+            if (!multiConsumer_ && !isLazyMode_.load() && !sumOfPendingVsync_ && (needEpoll_ || vsyncCheckTime_ <
                 std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count())) {
                 TryEpollFd(now, lock);
             }
@@ -621,6 +905,15 @@ InnerEvent::Pointer EventQueueBase::GetEvent()
             SetBarrierMode(false);
             continue;
         }
+        if ((nextWakeUpTime == InnerEvent::TimePoint::max()) && !poolTrimmed) {
+            // Runner goes idle, give back the recycled events it holds without blocking the producers.
+            poolTrimmed = true;
+            lock.unlock();
+            InnerEvent::TrimPool();
+            lock.lock();
+            // Events may be inserted while unlocked, so check the queue again.
+            continue;
+        }
         TryExecuteObserverCallback(nextWakeUpTime, EventRunnerStage::STAGE_BEFORE_WAITING);
         WaitUntilLocked(nextWakeUpTime, lock);
         needEpoll_ = false;
@@ -631,6 +924,100 @@ InnerEvent::Pointer EventQueueBase::GetEvent()
     return InnerEvent::Pointer(nullptr, nullptr);
 }
 
+bool EventQueueBase::RecordReadyFileDescriptor(int32_t fileDescriptor, uint32_t events,
+    const std::shared_ptr<FileDescriptorListener> &listener, Priority priority)
+{
+    LockGuardBase lock(*queueLock_);
+    if (!usable_.load()) {
+        HILOGW("EventQueueBase is unavailable.");
+        return true;
+    }
+    auto &ready = readyFileDescriptors_[fileDescriptor];
+    if (ready.events == 0) {
+        ready.listener = listener;
+        ready.priority = priority;
+        readyOrder_.push_back(fileDescriptor);
+    }
+    // Merge into pending events, the listener is called only once.
+    ready.events |= events;
+    return true;
+}
+
+InnerEvent::Pointer EventQueueBase::PickReadyFileDescriptorEventLocked(const InnerEvent::TimePoint &now)
+{
+    // Listeners are not barrier tasks, same as the tasks posted for them.
+    if (readyOrder_.empty() || isBarrierMode_) {
+        return InnerEvent::Pointer(nullptr, nullptr);
+    }
+    uint64_t nowNs = static_cast<uint64_t>(now.time_since_epoch().count());
+    for (auto it = readyOrder_.begin(); it != readyOrder_.end();) {
+        int32_t fileDescriptor = *it;
+        auto &ready = readyFileDescriptors_[fileDescriptor];
+        auto listener = ready.listener.lock();
+        auto registered = listeners_.find(fileDescriptor);
+        auto handler = listener ? listener->GetOwner() : nullptr;
+        if (!handler || (registered == listeners_.end()) || (registered->second != listener)) {
+            // Listener or its owner is removed after the events happened.
+            readyFileDescriptors_.erase(fileDescriptor);
+            it = readyOrder_.erase(it);
+            continue;
+        }
+        if (multiConsumer_ && (busyOwners_.find(handler->GetHandlerId()) != busyOwners_.end())) {
+            // Same as events, the owner is released by another consumer later.
+            waitingForOwner_ = true;
+            ++it;
+            continue;
+        }
+        // Events with higher priority which reach their handle time go first.
+        uint32_t priority = std::min(static_cast<uint32_t>(ready.priority), SUB_EVENT_QUEUE_NUM);
+        bool preempted = false;
+        bool lowerPending = false;
+        for (uint32_t i = 0; i < SUB_EVENT_QUEUE_NUM; ++i) {
+            if ((i != priority) && (subEventQueues_[i].frontEventHandleTime <= nowNs)) {
+                preempted = preempted || (i < priority);
+                lowerPending = lowerPending || (i > priority);
+            }
+        }
+        if (preempted) {
+            ++it;
+            continue;
+        }
+        if (priority < SUB_EVENT_QUEUE_NUM) {
+            // Same as events, let lower priority events go after enough ones in this priority are handled.
+            SubEventQueue &subQueue = subEventQueues_[priority];
+            if (lowerPending) {
+                if (subQueue.handledEventsCount >= subQueue.maxHandledEventsCount) {
+                    ++it;
+                    continue;
+                }
+                subQueue.handledEventsCount++;
+            }
+            for (uint32_t i = 0; i < priority; ++i) {
+                subEventQueues_[i].handledEventsCount = 0;
+            }
+        }
+
+        uint32_t events = ready.events;
+        ready.events = 0;
+        ready.listener.reset();
+        readyOrder_.erase(it);
+        // Run by the runner as a task of the owner, to take the same context as the posted tasks.
+        auto event = InnerEvent::Get([listener, fileDescriptor, events]() {
+            DispatchFileDescriptorEvents(listener, fileDescriptor, events);
+        });
+        event->SetOwner(handler);
+        event->SetOwnerId(handler->GetHandlerId());
+        event->SetSendTime(now);
+        event->SetHandleTime(now);
+        event->SetEventPriority(static_cast<int32_t>(ready.priority));
+        isIdle_ = false;
+        currentRunningEvent_ = CurrentRunningEvent(now, event);
+        AcquireOwnerLocked(*event);
+        return event;
+    }
+    return InnerEvent::Pointer(nullptr, nullptr);
+}
+
 void EventQueueBase::TryExecuteObserverCallback(InnerEvent::TimePoint &nextExpiredTime, EventRunnerStage stage)
 {
     uint32_t stageUint = static_cast<uint32_t>(stage);
@@ -724,28 +1111,28 @@ void EventQueueBase::DumpCurrentRunningEventId(const InnerEvent::EventId &innerE
     }
 }
 
-std::string EventQueueBase::DumpCurrentRunning()
+std::string EventQueueBase::DumpCurrentRunning(const CurrentRunningEvent &running, DumpTimeFormatter &formatter)
 {
     std::string content;
-    if (currentRunningEvent_.beginTime_ == InnerEvent::TimePoint::max()) {
+    if (running.beginTime_ == InnerEvent::TimePoint::max()) {
         content.append("{}");
     } else {
-        content.append("start at " + InnerEvent::DumpTimeToString(currentRunningEvent_.beginTime_) + ", ");
+        content.append("start at " + formatter.Format(running.beginTime_) + ", ");
         content.append("Event { ");
-        if (!currentRunningEvent_.owner_.expired()) {
-            content.append("send thread = " + std::to_string(currentRunningEvent_.senderKernelThreadId_));
-            content.append(", send time = " + InnerEvent::DumpTimeToString(currentRunningEvent_.sendTime_));
-            content.append(", handle time = " + InnerEvent::DumpTimeToString(currentRunningEvent_.handleTime_));
-            content.append(", trigger time = " + InnerEvent::DumpTimeToString(currentRunningEvent_.triggerTime_));
-            if (currentRunningEvent_.hasTask_) {
-                content.append(", task name = " + currentRunningEvent_.taskName_);
+        if (!running.owner_.expired()) {
+            content.append("send thread = " + std::to_string(running.senderKernelThreadId_));
+            content.append(", send time = " + formatter.Format(running.sendTime_));
+            content.append(", handle time = " + formatter.Format(running.handleTime_));
+            content.append(", trigger time = " + formatter.Format(running.triggerTime_));
+            if (running.hasTask_) {
+                content.append(", task name = " + running.taskName_);
             } else {
-                DumpCurrentRunningEventId(currentRunningEvent_.innerEventId_, content);
+                DumpCurrentRunningEventId(running.innerEventId_, content);
             }
-            if (currentRunningEvent_.param_ != 0) {
-                content.append(", param = " + std::to_string(currentRunningEvent_.param_));
+            if (running.param_ != 0) {
+                content.append(", param = " + std::to_string(running.param_));
             }
-            content.append(", caller = " + currentRunningEvent_.callerInfo_);
+            content.append(", caller = " + running.caller_.ToString());
         } else {
             content.append("No handler");
         }
@@ -754,91 +1141,114 @@ std::string EventQueueBase::DumpCurrentRunning()
  
     return content;
 }
- 
-void EventQueueBase::DumpCurentQueueInfo(Dumper &dumper, uint32_t dumpMaxSize)
+
+void EventQueueBase::CaptureEventsLocked(EventDumpSnapshot &snapshot)
 {
-    std::string priority[] = {"VIP", "Immediate", "High", "Low"};
-    uint32_t total = 0;
     for (uint32_t i = 0; i < SUB_EVENT_QUEUE_NUM; ++i) {
-        uint32_t n = 0;
+        subEventQueues_[i].queue->ForEach([&snapshot, i](const InnerEvent::Pointer &event) {
+            snapshot.Add(i, *event);
+        });
+    }
+    idleEvents_->ForEach([&snapshot](const InnerEvent::Pointer &event) {
+        snapshot.Add(SUB_EVENT_QUEUE_NUM, *event);
+    });
+}
+ 
+void EventQueueBase::DumpCurentQueueInfo(Dumper &dumper, const EventDumpSnapshot &snapshot,
+    DumpTimeFormatter &formatter)
+{
+    std::string priority[] = {"VIP", "Immediate", "High", "Low", "Idle"};
+    for (uint32_t i = 0; i <= SUB_EVENT_QUEUE_NUM; ++i) {
         dumper.Dump(dumper.GetTag() + " " + priority[i] + " priority event queue information:" +
             std::string(LINE_SEPARATOR));
-        for (auto it = subEventQueues_[i].queue.begin(); it != subEventQueues_[i].queue.end(); ++it) {
+        uint32_t n = 0;
+        for (const auto &record : snapshot.GetRecords(i)) {
             ++n;
-            if (total < dumpMaxSize) {
-                dumper.Dump(dumper.GetTag() + " No." + std::to_string(n) + " : " + (*it)->Dump());
-            }
-            ++total;
-        }
-        dumper.Dump(dumper.GetTag() + " Total size of " + priority[i] + " events : " + std::to_string(n) +
-            std::string(LINE_SEPARATOR));
-    }
-    dumper.Dump(dumper.GetTag() + " Idle priority event queue information:" + std::string(LINE_SEPARATOR));
-    int n = 0;
-    for (auto it = idleEvents_.begin(); it != idleEvents_.end(); ++it) {
-        ++n;
-        if (total < dumpMaxSize) {
-            dumper.Dump(dumper.GetTag() + " No." + std::to_string(n) + " : " + (*it)->Dump());
+            dumper.Dump(dumper.GetTag() + " No." + std::to_string(n) + " : " + snapshot.Format(record, formatter));
         }
-        ++total;
+        dumper.Dump(dumper.GetTag() + " Total size of " + priority[i] + " events : " +
+            std::to_string(snapshot.GetCount(i)) + std::string(LINE_SEPARATOR));
     }
-    dumper.Dump(dumper.GetTag() + " Total size of Idle events : " + std::to_string(n) + std::string(LINE_SEPARATOR));
-    dumper.Dump(dumper.GetTag() + " Total event size : " + std::to_string(total) + std::string(LINE_SEPARATOR));
+    dumper.Dump(dumper.GetTag() + " Total event size : " + std::to_string(snapshot.GetTotalCount()) +
+        std::string(LINE_SEPARATOR));
 }
  
 void EventQueueBase::Dump(Dumper &dumper)
 {
-    LockGuardBase lock(*queueLock_);
-    HILOGD("EventQueue start dump.");
-    if (!usable_.load()) {
-        HILOGW("EventQueueBase is unavailable.");
-        return;
+    // Copy everything under the lock, and format them after the lock is released, so that neither producers nor
+    // the runner are blocked by formatting.
+    CurrentRunningEvent running;
+    std::vector<std::pair<uint32_t, HistoryEvent>> history;
+    std::unique_ptr<EventDumpSnapshot> snapshot;
+    uint64_t replacedCount = 0;
+    uint64_t droppedCount = 0;
+    {
+        LockGuardBase lock(*queueLock_);
+        HILOGD("EventQueue start dump.");
+        if (!usable_.load()) {
+            HILOGW("EventQueueBase is unavailable.");
+            return;
+        }
+        DrainInboxLocked();
+        running = currentRunningEvent_;
+        uint32_t historyDepth = historyRing_ ? historyRing_->Depth() : 0;
+        for (uint32_t i = 0; i < historyDepth; i++) {
+            EventHistoryRing::Record record;
+            if (!historyRing_->Read(i, record)) {
+                continue;
+            }
+            history.emplace_back(i, HistoryEvent());
+            DecodeHistoryRecord(record, history.back().second);
+        }
+        uint32_t dumpMaxSize = (history.size() < MAX_DUMP_SIZE) ? (MAX_DUMP_SIZE - history.size()) : 0;
+        snapshot = std::make_unique<EventDumpSnapshot>(maxDumpEventsPerPriority_.load(std::memory_order_relaxed),
+            dumpMaxSize);
+        CaptureEventsLocked(*snapshot);
+        replacedCount = coalescedReplacedCount_;
+        droppedCount = coalescedDroppedCount_;
     }
-    dumper.Dump(dumper.GetTag() + " Current Running: " + DumpCurrentRunning() + std::string(LINE_SEPARATOR));
+
+    DumpTimeFormatter formatter;
+    dumper.Dump(dumper.GetTag() + " Current Running: " + DumpCurrentRunning(running, formatter) +
+        std::string(LINE_SEPARATOR));
     dumper.Dump(dumper.GetTag() + " History event queue information:" + std::string(LINE_SEPARATOR));
-    uint32_t dumpMaxSize = MAX_DUMP_SIZE;
-    for (uint8_t i = 0; i < HISTORY_EVENT_NUM_POWER; i++) {
-        std::lock_guard<std::mutex> lock(historyLock_);
-        if (historyEvents_[i].senderKernelThreadId == 0) {
-            continue;
-        }
-        --dumpMaxSize;
-        dumper.Dump(dumper.GetTag() + " No. " + std::to_string(i) + " : " + HistoryQueueDump(historyEvents_[i]));
+    for (const auto &item : history) {
+        dumper.Dump(dumper.GetTag() + " No. " + std::to_string(item.first) + " : " +
+            HistoryQueueDump(item.second, formatter));
+    }
+    if ((replacedCount != 0) || (droppedCount != 0)) {
+        dumper.Dump(dumper.GetTag() + " Coalesced events : replaced = " + std::to_string(replacedCount) +
+            ", dropped = " + std::to_string(droppedCount) + std::string(LINE_SEPARATOR));
     }
-    DumpCurentQueueInfo(dumper, dumpMaxSize);
+    DumpCurentQueueInfo(dumper, *snapshot, formatter);
 }
  
 void EventQueueBase::DumpQueueInfo(std::string& queueInfo)
 {
-    LockGuardBase lock(*queueLock_);
-    if (!usable_.load()) {
-        HILOGW("EventQueueBase is unavailable.");
-        return;
+    EventDumpSnapshot snapshot(maxDumpEventsPerPriority_.load(std::memory_order_relaxed), UINT32_MAX);
+    {
+        LockGuardBase lock(*queueLock_);
+        if (!usable_.load()) {
+            HILOGW("EventQueueBase is unavailable.");
+            return;
+        }
+        DrainInboxLocked();
+        CaptureEventsLocked(snapshot);
     }
-    std::string priority[] = {"VIP", "Immediate", "High", "Low"};
-    uint32_t total = 0;
-    for (uint32_t i = 0; i < SUB_EVENT_QUEUE_NUM; ++i) {
-        uint32_t n = 0;
+
+    DumpTimeFormatter formatter;
+    std::string priority[] = {"VIP", "Immediate", "High", "Low", "Idle"};
+    for (uint32_t i = 0; i <= SUB_EVENT_QUEUE_NUM; ++i) {
         queueInfo +=  "            " + priority[i] + " priority event queue:" + std::string(LINE_SEPARATOR);
-        for (auto it = subEventQueues_[i].queue.begin(); it != subEventQueues_[i].queue.end(); ++it) {
+        uint32_t n = 0;
+        for (const auto &record : snapshot.GetRecords(i)) {
             ++n;
-            queueInfo +=  "            No." + std::to_string(n) + " : " + (*it)->Dump();
-            ++total;
+            queueInfo +=  "            No." + std::to_string(n) + " : " + snapshot.Format(record, formatter);
         }
-        queueInfo +=  "              Total size of " + priority[i] + " events : " + std::to_string(n) +
-            std::string(LINE_SEPARATOR);
+        queueInfo +=  "              Total size of " + priority[i] + " events : " +
+            std::to_string(snapshot.GetCount(i)) + std::string(LINE_SEPARATOR);
     }
- 
-    queueInfo += "            Idle priority event queue:" + std::string(LINE_SEPARATOR);
- 
-    int n = 0;
-    for (auto it = idleEvents_.begin(); it != idleEvents_.end(); ++it) {
-        ++n;
-        queueInfo += "            No." + std::to_string(n) + " : " + (*it)->Dump();
-        ++total;
-    }
-    queueInfo += "              Total size of Idle events : " + std::to_string(n) + std::string(LINE_SEPARATOR);
-    queueInfo += "            Total event size : " + std::to_string(total);
+    queueInfo += "            Total event size : " + std::to_string(snapshot.GetTotalCount());
 }
  
 bool EventQueueBase::IsIdle()
@@ -853,14 +1263,15 @@ bool EventQueueBase::IsQueueEmpty()
         HILOGW("EventQueueBase is unavailable.");
         return false;
     }
+    DrainInboxLocked();
     for (uint32_t i = 0; i < SUB_EVENT_QUEUE_NUM; ++i) {
-        uint32_t queueSize = subEventQueues_[i].queue.size();
+        uint32_t queueSize = subEventQueues_[i].queue->Size();
         if (queueSize != 0) {
             return false;
         }
     }
  
-    return idleEvents_.size() == 0;
+    return idleEvents_->Empty();
 }
  
 void EventQueueBase::PushHistoryQueueBeforeDistribute(const InnerEvent::Pointer &event)
@@ -869,47 +1280,115 @@ void EventQueueBase::PushHistoryQueueBeforeDistribute(const InnerEvent::Pointer
         HILOGW("event is nullptr.");
         return;
     }
-    std::lock_guard<std::mutex> lock(historyLock_);
-    historyEvents_[historyEventIndex_].senderKernelThreadId = event->GetSenderKernelThreadId();
-    historyEvents_[historyEventIndex_].sendTime = event->GetSendTime();
-    historyEvents_[historyEventIndex_].handleTime = event->GetHandleTime();
-    historyEvents_[historyEventIndex_].triggerTime = InnerEvent::Clock::now();
-    historyEvents_[historyEventIndex_].priority = event->GetEventPriority();
-    historyEvents_[historyEventIndex_].completeTime = InnerEvent::TimePoint::max();
-    historyEvents_[historyEventIndex_].callerInfo_ = (event->GetCaller()).ToString();
-    currentRunningEvent_.triggerTime_ = InnerEvent::Clock::now();
+    if (multiConsumer_) {
+        return;
+    }
+    auto now = InnerEvent::Clock::now();
+    currentRunningEvent_.triggerTime_ = now;
+    if (historyDepthRequest_.load(std::memory_order_relaxed) != NO_HISTORY_DEPTH_REQUEST) {
+        ApplyHistoryDepth();
+    }
+    if (!historyRing_) {
+        return;
+    }
 
+    EventHistoryRing::Record record {};
+    record.senderKernelThreadId = event->GetSenderKernelThreadId();
+    record.sendTime = event->GetSendTime().time_since_epoch().count();
+    record.handleTime = event->GetHandleTime().time_since_epoch().count();
+    record.triggerTime = now.time_since_epoch().count();
+    record.priority = event->GetEventPriority();
+    const Caller &caller = event->GetCaller();
+    record.callerFile = caller.file_;
+    record.callerFunc = caller.func_;
+    record.callerDfxName = caller.dfxName_;
+    record.callerLine = caller.line_;
     if (event->HasTask()) {
-        historyEvents_[historyEventIndex_].hasTask = true;
-        historyEvents_[historyEventIndex_].taskName = event->GetTaskName();
+        record.flags = EventHistoryRing::FLAG_HAS_TASK;
+        historyRing_->SetName(event->GetTaskName(), record);
     } else {
-        historyEvents_[historyEventIndex_].innerEventId = event->GetInnerEventIdEx();
+        // Copying a string event id is rare, numeric ids are the common case.
+        auto eventId = event->GetInnerEventIdEx();
+        if (eventId.index() == TYPE_U32_INDEX) {
+            record.innerEventId = std::get<uint32_t>(eventId);
+        } else {
+            record.flags = EventHistoryRing::FLAG_STRING_EVENT_ID;
+            historyRing_->SetName(std::get<std::string>(eventId), record);
+        }
     }
+    historyRing_->Begin(record);
 }
- 
+
 void EventQueueBase::PushHistoryQueueAfterDistribute()
 {
-    std::lock_guard<std::mutex> lock(historyLock_);
-    historyEvents_[historyEventIndex_].completeTime = InnerEvent::Clock::now();
-    historyEventIndex_++;
-    historyEventIndex_ = historyEventIndex_ & (HISTORY_EVENT_NUM_POWER - 1);
+    if (historyRing_ && !multiConsumer_) {
+        historyRing_->Complete(InnerEvent::Clock::now().time_since_epoch().count());
+    }
+}
+
+void EventQueueBase::SetMaxDumpEventsPerPriority(uint32_t maxEvents)
+{
+    maxDumpEventsPerPriority_.store(maxEvents, std::memory_order_relaxed);
+}
+
+void EventQueueBase::SetHistoryDepth(uint32_t depth)
+{
+    historyDepthRequest_.store(std::min(depth, EventHistoryRing::MAX_DEPTH), std::memory_order_relaxed);
+}
+
+void EventQueueBase::ApplyHistoryDepth()
+{
+    uint32_t depth = historyDepthRequest_.exchange(NO_HISTORY_DEPTH_REQUEST, std::memory_order_relaxed);
+    if (depth == NO_HISTORY_DEPTH_REQUEST) {
+        return;
+    }
+    std::unique_ptr<EventHistoryRing> historyRing;
+    if (depth > 0) {
+        historyRing = std::make_unique<EventHistoryRing>(depth);
+    }
+    // Dumping reads the history under the queue lock.
+    LockGuardBase lock(*queueLock_);
+    historyRing_.swap(historyRing);
+}
+
+void EventQueueBase::DecodeHistoryRecord(const EventHistoryRing::Record &record, HistoryEvent &historyEvent)
+{
+    historyEvent.senderKernelThreadId = record.senderKernelThreadId;
+    historyEvent.sendTime = InnerEvent::TimePoint(InnerEvent::TimePoint::duration(record.sendTime));
+    historyEvent.handleTime = InnerEvent::TimePoint(InnerEvent::TimePoint::duration(record.handleTime));
+    historyEvent.triggerTime = InnerEvent::TimePoint(InnerEvent::TimePoint::duration(record.triggerTime));
+    historyEvent.completeTime = (record.completeTime == EventHistoryRing::NOT_COMPLETED) ?
+        InnerEvent::TimePoint::max() : InnerEvent::TimePoint(InnerEvent::TimePoint::duration(record.completeTime));
+    historyEvent.priority = record.priority;
+    historyEvent.hasTask = (record.flags & EventHistoryRing::FLAG_HAS_TASK) != 0;
+    if (historyEvent.hasTask) {
+        historyEvent.taskName = historyRing_->GetName(record);
+    } else if ((record.flags & EventHistoryRing::FLAG_STRING_EVENT_ID) != 0) {
+        historyEvent.innerEventId = historyRing_->GetName(record);
+    } else {
+        historyEvent.innerEventId = record.innerEventId;
+    }
+    historyEvent.caller.file_ = record.callerFile;
+    historyEvent.caller.line_ = record.callerLine;
+    historyEvent.caller.func_ = record.callerFunc;
+    historyEvent.caller.dfxName_ = record.callerDfxName;
 }
  
-std::string EventQueueBase::HistoryQueueDump(const HistoryEvent &historyEvent)
+std::string EventQueueBase::HistoryQueueDump(const HistoryEvent &historyEvent, DumpTimeFormatter &formatter)
 {
     std::string content;
     std::vector<std::string> prioritys = {"VIP", "Immediate", "High", "Low", "IDEL"};
 
     content.append("Event { ");
     content.append("send thread = " + std::to_string(historyEvent.senderKernelThreadId));
-    content.append(", send time = " + InnerEvent::DumpTimeToString(historyEvent.sendTime));
-    content.append(", handle time = " + InnerEvent::DumpTimeToString(historyEvent.handleTime));
-    content.append(", trigger time = " + InnerEvent::DumpTimeToString(historyEvent.triggerTime));
+    content.append(", send time = " + formatter.Format(historyEvent.sendTime));
+    content.append(", handle time = " + formatter.Format(historyEvent.handleTime));
+    content.append(", trigger time = " + formatter.Format(historyEvent.triggerTime));
 
     if (historyEvent.completeTime == InnerEvent::TimePoint::max()) {
         content.append(", completeTime time = ");
     } else {
-        content.append(", completeTime time = " + InnerEvent::DumpTimeToString(historyEvent.completeTime));
+        content.append(", completeTime time = " + formatter.Format(historyEvent.completeTime));
     }
     if (historyEvent.priority >= 0 && historyEvent.priority < prioritys.size()) {
         content.append(", priority = " + prioritys[historyEvent.priority]);
@@ -922,7 +1401,7 @@ std::string EventQueueBase::HistoryQueueDump(const HistoryEvent &historyEvent)
     } else {
         DumpCurrentRunningEventId(historyEvent.innerEventId, content);
     }
-    content.append(", caller = " + historyEvent.callerInfo_);
+    content.append(", caller = " + historyEvent.caller.ToString());
     content.append(" }" + std::string(LINE_SEPARATOR));
 
     return content;
@@ -931,17 +1410,21 @@ std::string EventQueueBase::HistoryQueueDump(const HistoryEvent &historyEvent)
 std::string EventQueueBase::DumpCurrentQueueSize()
 {
     return "Current queue size: VIP = " +
-    std::to_string(subEventQueues_[static_cast<int>(Priority::VIP)].queue.size()) + ", IMMEDIATE = " +
-    std::to_string(subEventQueues_[static_cast<int>(Priority::IMMEDIATE)].queue.size()) + ", HIGH = " +
-    std::to_string(subEventQueues_[static_cast<int>(Priority::HIGH)].queue.size()) + ", LOW = " +
-    std::to_string(subEventQueues_[static_cast<int>(Priority::LOW)].queue.size()) + ", IDLE = " +
-    std::to_string(idleEvents_.size()) + " ; ";
+    std::to_string(subEventQueues_[static_cast<int>(Priority::VIP)].queue->Size()) + ", IMMEDIATE = " +
+    std::to_string(subEventQueues_[static_cast<int>(Priority::IMMEDIATE)].queue->Size()) + ", HIGH = " +
+    std::to_string(subEventQueues_[static_cast<int>(Priority::HIGH)].queue->Size()) + ", LOW = " +
+    std::to_string(subEventQueues_[static_cast<int>(Priority::LOW)].queue->Size()) + ", IDLE = " +
+    std::to_string(idleEvents_->Size()) + " ; ";
 }
 
 bool EventQueueBase::HasPreferEvent(int basePrio)
 {
+    if (!inbox_.Empty()) {
+        LockGuardBase lock(*queueLock_);
+        DrainInboxLocked();
+    }
     for (int prio = 0; prio < basePrio; prio++) {
-        if (subEventQueues_[prio].queue.size() > 0) {
+        if (!subEventQueues_[prio].queue->Empty()) {
             return true;
         }
     }
@@ -967,21 +1450,22 @@ PendingTaskInfo EventQueueBase::QueryPendingTaskInfo(int32_t fileDescriptor)
         HILOGW("QueryPendingTaskInfo event queue is unavailable.");
         return pendingTaskInfo;
     }
+    DrainInboxLocked();
 
     auto now = InnerEvent::Clock::now();
-    for (auto it = subEventQueues_[0].queue.begin(); it != subEventQueues_[0].queue.end(); it++) {
-        if ((*it)->GetTaskName() == fileDescriptorInfo->taskName_) {
+    subEventQueues_[0].queue->ForEach([&pendingTaskInfo, &fileDescriptorInfo, &now](const InnerEvent::Pointer &event) {
+        if (event->GetTaskName() == fileDescriptorInfo->taskName_) {
             pendingTaskInfo.taskCount++;
-            InnerEvent::TimePoint handlerTime = (*it)->GetHandleTime();
+            InnerEvent::TimePoint handlerTime = event->GetHandleTime();
             if (handlerTime >= now) {
-                continue;
+                return;
             }
             auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(now - handlerTime).count();
             if (duration > pendingTaskInfo.MaxPendingTime) {
                 pendingTaskInfo.MaxPendingTime = duration;
             }
         }
-    }
+    });
     EH_LOGI_LIMIT("Pend task %{public}d %{public}d", pendingTaskInfo.taskCount, pendingTaskInfo.MaxPendingTime);
     return PendingTaskInfo();
 }
@@ -1004,7 +1488,7 @@ CurrentRunningEvent::CurrentRunningEvent(InnerEvent::TimePoint time, InnerEvent:
     sendTime_ = event->GetSendTime();
     handleTime_ = event->GetHandleTime();
     param_ = event->GetParam();
-    callerInfo_ = (event->GetCaller()).ToString();
+    caller_ = event->GetCaller();
     if (event->HasTask()) {
         hasTask_ = true;
         taskName_ = event->GetTaskName();
@@ -1024,6 +1508,10 @@ ErrCode EventQueueBase::AddFileDescriptorListener(int32_t fileDescriptor, uint32
     }
 
     LockGuardBase lock(*queueLock_);
+    if (multiConsumer_) {
+        HILOGW("Listening to file descriptors is not supported with multiple consumers");
+        return EVENT_HANDLER_ERR_FD_NOT_SUPPORT;
+    }
     return AddFileDescriptorListenerBase(fileDescriptor, events, listener, taskName, priority);
 }
 
@@ -1075,7 +1563,7 @@ void EventQueueBase::NotifyObserverVipDone(const InnerEvent::Pointer &event)
 
 void EventQueueBase::NotifyObserverVipDoneBase()
 {
-    if (subEventQueues_[static_cast<uint32_t>(Priority::VIP)].queue.empty()) {
+    if (subEventQueues_[static_cast<uint32_t>(Priority::VIP)].queue->Empty()) {
         InnerEvent::TimePoint time = InnerEvent::Clock::now();
         TryExecuteObserverCallback(time, EventRunnerStage::STAGE_VIP_NONE);
         isExistVipTask_ = false;
@@ -1084,7 +1572,7 @@ void EventQueueBase::NotifyObserverVipDoneBase()
 
 bool EventQueueBase::HasVipTask()
 {
-    if (!subEventQueues_[static_cast<uint32_t>(Priority::VIP)].queue.empty()) {
+    if (!subEventQueues_[static_cast<uint32_t>(Priority::VIP)].queue->Empty()) {
         return true;
     }
     return false;
@@ -29,7 +29,6 @@ namespace {
 
 DEFINE_EH_HILOG_LABEL("EventQueueFFRT");
 constexpr static uint32_t MAX_DUMP_INFO_LENGTH = 120000;
-constexpr static uint32_t MILLI_TO_MICRO = 1000;
 static constexpr int FFRT_REMOVE_SUCC = 0;
 ffrt_inner_queue_priority_t TransferInnerPriority(EventQueue::Priority priority)
 {
@@ -64,7 +63,12 @@ inline ffrt_queue_t* TransferQueuePtr(std::shared_ptr<ffrt::queue> queue)
     return nullptr;
 }
 
-
+// Delay in microseconds, which keeps the precision of delays shorter than one millisecond.
+inline uint64_t GetDelayMicroseconds(const InnerEvent::Pointer &event)
+{
+    auto delay = std::chrono::duration_cast<std::chrono::microseconds>(event->GetHandleTime() - event->GetSendTime());
+    return (delay.count() > 0) ? static_cast<uint64_t>(delay.count()) : 0;
+}
 }  // unnamed namespace
 
 EventQueueFFRT::EventQueueFFRT() : EventQueue()
@@ -159,7 +163,7 @@ void EventQueueFFRT::Remove(const std::shared_ptr<EventHandler> &owner)
     }
 
     // taskname: handler Id | has task | inner event id | param | task name
-    std::string regular = owner->GetHandlerId() + "\\|.*";
+    std::string regular = std::to_string(owner->GetHandlerId()) + "\\|.*";
     ffrt_queue_t* queue = TransferQueuePtr(ffrtQueue_);
     if (queue == nullptr) {
         HILOGW("Remove is unavailable.");
@@ -183,7 +187,7 @@ void EventQueueFFRT::Remove(const std::shared_ptr<EventHandler> &owner, uint32_t
     }
 
     // taskname: handler Id | has task | inner event id | param | task name
-    std::string regular = owner->GetHandlerId() + "\\|0\\|" + std::to_string(innerEventId) + "\\|.*";
+    std::string regular = std::to_string(owner->GetHandlerId()) + "\\|0\\|" + std::to_string(innerEventId) + "\\|.*";
     ffrt_queue_t* queue = TransferQueuePtr(ffrtQueue_);
     if (queue == nullptr) {
         HILOGW("Remove is unavailable.");
@@ -207,7 +211,7 @@ void EventQueueFFRT::Remove(const std::shared_ptr<EventHandler> &owner, uint32_t
     }
 
     // taskname: handler Id | has task | inner event id | param | task name
-    std::string regular = owner->GetHandlerId() + "\\|0\\|" + std::to_string(innerEventId) + "\\|" +
+    std::string regular = std::to_string(owner->GetHandlerId()) + "\\|0\\|" + std::to_string(innerEventId) + "\\|" +
         std::to_string(param) + "\\|.*";
     ffrt_queue_t* queue = TransferQueuePtr(ffrtQueue_);
     if (queue == nullptr) {
@@ -232,7 +236,7 @@ bool EventQueueFFRT::Remove(const std::shared_ptr<EventHandler> &owner, const st
     }
 
     // taskname: handler Id | has task | inner event id | param | task name
-    std::string regular = owner->GetHandlerId() + "\\|1\\|" + ".*\\|" + name;
+    std::string regular = std::to_string(owner->GetHandlerId()) + "\\|1\\|" + ".*\\|" + name;
     ffrt_queue_t* queue = TransferQueuePtr(ffrtQueue_);
     if (queue == nullptr) {
         HILOGW("Remove is unavailable.");
@@ -255,7 +259,7 @@ bool EventQueueFFRT::HasInnerEvent(const std::shared_ptr<EventHandler> &owner, u
     }
 
     // taskname: handler Id | has task | inner event id | param | task name
-    std::string regular = owner->GetHandlerId() + "\\|0\\|" + std::to_string(innerEventId) + "\\|.*";
+    std::string regular = std::to_string(owner->GetHandlerId()) + "\\|0\\|" + std::to_string(innerEventId) + "\\|.*";
     ffrt_queue_t* queue = TransferQueuePtr(ffrtQueue_);
     if (queue == nullptr) {
         HILOGW("Remove is unavailable.");
@@ -277,7 +281,7 @@ bool EventQueueFFRT::HasInnerEvent(const std::shared_ptr<EventHandler> &owner, i
     }
 
     // taskname: handler Id | has task | inner event id | param | task name
-    std::string regular = owner->GetHandlerId() + "\\|0\\|.*" + std::to_string(param) + "\\|.*";
+    std::string regular = std::to_string(owner->GetHandlerId()) + "\\|0\\|.*" + std::to_string(param) + "\\|.*";
     ffrt_queue_t* queue = TransferQueuePtr(ffrtQueue_);
     if (queue == nullptr) {
         HILOGW("Remove is unavailable.");
@@ -447,7 +451,7 @@ bool EventQueueFFRT::InsertEvent(InnerEvent::Pointer &event, Priority priority,
     }
 
     // taskname: handler Id | has task | inner event id | param | task name
-    std::string taskName = event->GetOwnerId() + "|" + (event->HasTask() ? "1" : "0") + "|" +
+    std::string taskName = std::to_string(event->GetOwnerId()) + "|" + (event->HasTask() ? "1" : "0") + "|" +
         std::to_string(event->GetInnerEventId()) + "|" + std::to_string(event->GetParam()) +
         "|" + event->GetTaskName();
     HILOGD("Submit task %{public}s, %{public}d, %{public}d, %{public}d.", taskName.c_str(), priority,
@@ -471,7 +475,7 @@ auto MakeCopyableFunction(F&& f)
 bool EventQueueFFRT::SubmitEventAtEnd(InnerEvent::Pointer &event, Priority priority, bool syncWait,
     const std::string &taskName, std::unique_lock<ffrt::mutex> &lock)
 {
-    uint64_t time = event->GetDelayTime();
+    uint64_t delay = GetDelayMicroseconds(event);
     ffrt_queue_priority_t queuePriority = static_cast<ffrt_queue_priority_t>(TransferInnerPriority(priority));
     std::function<void()> task = MakeCopyableFunction([ffrtEvent = std::move(event)]() {
         auto handler = new (std::nothrow) std::shared_ptr<EventHandler>(ffrtEvent->GetOwner());
@@ -491,11 +495,11 @@ bool EventQueueFFRT::SubmitEventAtEnd(InnerEvent::Pointer &event, Priority prior
 
     if (syncWait) {
         ffrt::task_handle handle = ffrtQueue_->submit_h(task, ffrt::task_attr().name(taskName.c_str())
-            .delay(time * MILLI_TO_MICRO).priority(queuePriority));
+            .delay(delay).priority(queuePriority));
         lock.unlock();
         ffrtQueue_->wait(handle);
     } else {
-        ffrtQueue_->submit(task, ffrt::task_attr().name(taskName.c_str()).delay(time * MILLI_TO_MICRO).
+        ffrtQueue_->submit(task, ffrt::task_attr().name(taskName.c_str()).delay(delay).
             priority(queuePriority));
     }
     return true;
@@ -504,12 +508,12 @@ bool EventQueueFFRT::SubmitEventAtEnd(InnerEvent::Pointer &event, Priority prior
 bool EventQueueFFRT::SubmitEventAtFront(InnerEvent::Pointer &event, Priority priority, bool syncWait,
     const std::string &taskName, std::unique_lock<ffrt::mutex> &lock)
 {
-    uint64_t time = event->GetDelayTime();
+    uint64_t delay = GetDelayMicroseconds(event);
     ffrt_queue_priority_t queuePriority = static_cast<ffrt_queue_priority_t>(TransferInnerPriority(priority));
     ffrt_task_attr_t attribute;
     (void)ffrt_task_attr_init(&attribute);
     ffrt_task_attr_set_name(&attribute, taskName.c_str());
-    ffrt_task_attr_set_delay(&attribute, time * MILLI_TO_MICRO);
+    ffrt_task_attr_set_delay(&attribute, delay);
     ffrt_task_attr_set_queue_priority(&attribute, queuePriority);
 
     std::function<void()> task = MakeCopyableFunction([ffrtEvent = std::move(event)]() {
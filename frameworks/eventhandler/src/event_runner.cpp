@@ -30,6 +30,7 @@
 #include "event_queue_base.h"
 #include "event_inner_runner.h"
 #include "event_logger.h"
+#include "event_runner_pool.h"
 #include "securec.h"
 #include "singleton.h"
 #ifdef FFRT_USAGE_ENABLE
@@ -47,6 +48,8 @@ const int CRASH_BUF_MIN_LEN = 2;
 constexpr int64_t MIN_APP_UID = 20000;
 thread_local static Caller g_currentEventCaller = {};
 thread_local static std::string g_currentEventName = {};
+// Events distributed by a runner in the pool before it gives the worker to other runners.
+const uint32_t MAX_EVENTS_PER_SLICE = 16;
 
 DEFINE_EH_HILOG_LABEL("EventRunner");
 
@@ -61,6 +64,29 @@ inline void SystemCallSetThreadName(const std::string &name)
     HILOGD("thread name is %{public}s", name.c_str());
 }
 
+std::string LatencySummaryToString(const LatencySummary &summary)
+{
+    return "count = " + std::to_string(summary.count) + ", p50 = " + std::to_string(summary.p50) +
+        "ns, p90 = " + std::to_string(summary.p90) + "ns, p99 = " + std::to_string(summary.p99) +
+        "ns, p999 = " + std::to_string(summary.p999) + "ns, max = " + std::to_string(summary.max) + "ns";
+}
+
+// Dump latency percentiles of priorities which have distributed events.
+void DumpLatency(Dumper &dumper, const LatencySnapshot &snapshot)
+{
+    static const std::string priorities[LatencySnapshot::PRIORITY_NUM] = {"VIP", "Immediate", "High", "Low", "Idle"};
+    dumper.Dump(dumper.GetTag() + " Latency information:" + std::string(LINE_SEPARATOR));
+    for (uint32_t i = 0; i < LatencySnapshot::PRIORITY_NUM; ++i) {
+        if (snapshot.delivery[i].count == 0) {
+            continue;
+        }
+        dumper.Dump(dumper.GetTag() + " " + priorities[i] + " delivery : " +
+            LatencySummaryToString(snapshot.delivery[i]) + std::string(LINE_SEPARATOR));
+        dumper.Dump(dumper.GetTag() + " " + priorities[i] + " distribute : " +
+            LatencySummaryToString(snapshot.distribute[i]) + std::string(LINE_SEPARATOR));
+    }
+}
+
 // Help to calculate hash code of object.
 template<typename T>
 inline size_t CalculateHashCode(const T &obj)
@@ -290,16 +316,20 @@ ThreadCollector::~ThreadCollector()
 typedef void(*ThreadInfoCallback)(char *buf, size_t len, void *ucontext);
 extern "C" void SetThreadInfoCallback(ThreadInfoCallback func) __attribute__((weak));
 
-class EventRunnerImpl final : public EventInnerRunner {
+class EventRunnerImpl : public EventInnerRunner {
 public:
-    explicit EventRunnerImpl(const std::shared_ptr<EventRunner> &runner, EventLockType lockType)
-        : EventInnerRunner(runner)
+    explicit EventRunnerImpl(const std::shared_ptr<EventRunner> &runner, EventLockType lockType,
+        const std::shared_ptr<IoWaiter> &ioWaiter = nullptr) : EventInnerRunner(runner)
     {
         HILOGD("enter");
-        queue_ = std::make_shared<EventQueueBase>(lockType);
+        if (ioWaiter) {
+            queue_ = std::make_shared<EventQueueBase>(ioWaiter, lockType);
+        } else {
+            queue_ = std::make_shared<EventQueueBase>(lockType);
+        }
     }
 
-    ~EventRunnerImpl() final
+    ~EventRunnerImpl() override
     {
         HILOGD("enter");
         queue_->RemoveAll();
@@ -331,7 +361,7 @@ public:
         ThreadCollector::GetInstance().ReclaimCurrentThread();
     }
 
-    void Run() final
+    void Run() override
     {
         HILOGD("enter");
         // Prepare to start event loop.
@@ -364,7 +394,7 @@ public:
         currentEventRunner = oldRunner;
     }
 
-    void Stop() final
+    void Stop() override
     {
         HILOGD("enter");
         queue_->Finish();
@@ -496,6 +526,110 @@ private:
         g_currentEventName.clear();
     }
 };
+
+// Runner of 'ThreadMode::POOL', it takes a worker of 'EventRunnerPool' only while it has due events.
+class PooledEventRunnerImpl final : public EventRunnerImpl, public PoolRunnable {
+public:
+    PooledEventRunnerImpl(const std::shared_ptr<EventRunner> &runner, EventLockType lockType,
+        const std::shared_ptr<PoolIoWaiter> &ioWaiter) : EventRunnerImpl(runner, lockType, ioWaiter) {}
+    ~PooledEventRunnerImpl() final = default;
+    DISALLOW_COPY_AND_MOVE(PooledEventRunnerImpl);
+
+    // Events are distributed by workers of the pool, no thread enters the loop.
+    void Run() final {}
+
+    void Stop() final
+    {
+        stopped_.store(true);
+        EventRunnerImpl::Stop();
+    }
+
+protected:
+    InnerEvent::TimePoint RunSlice(bool &hasMore) final
+    {
+        InnerEvent::TimePoint nextWakeTime = InnerEvent::TimePoint::max();
+        if (stopped_.load() || owner_.expired()) {
+            return nextWakeTime;
+        }
+        // The runner looks like running on this worker during the slice. Thread ids are kept unset, since slices
+        // of the runner may run on different workers, while others read them.
+        std::weak_ptr<EventRunner> oldRunner = currentEventRunner;
+        currentEventRunner = owner_;
+
+        uint32_t count = 0;
+        while ((count < MAX_EVENTS_PER_SLICE) && !stopped_.load()) {
+            auto event = queue_->GetExpiredEvent(nextWakeTime);
+            if (!event) {
+                break;
+            }
+            ExecuteEventHandler(event);
+            ++count;
+        }
+        hasMore = (count == MAX_EVENTS_PER_SLICE);
+
+        currentEventRunner = oldRunner;
+        return nextWakeTime;
+    }
+
+    bool IsCurrentThread() final
+    {
+        auto owner = owner_.lock();
+        return (owner != nullptr) && (GetCurrentEventRunner() == owner);
+    }
+
+private:
+    std::atomic<bool> stopped_ {false};
+};
+
+// Runner created by 'EventRunner::CreateConcurrent', its threads share the queue, which serializes events by owner.
+class ConcurrentEventRunnerImpl final : public EventRunnerImpl {
+public:
+    ConcurrentEventRunnerImpl(const std::shared_ptr<EventRunner> &runner, EventLockType lockType)
+        : EventRunnerImpl(runner, lockType), queueBase_(std::static_pointer_cast<EventQueueBase>(queue_))
+    {
+        queueBase_->SetMultiConsumer(true);
+    }
+    ~ConcurrentEventRunnerImpl() final = default;
+    DISALLOW_COPY_AND_MOVE(ConcurrentEventRunnerImpl);
+
+    // Loop of each thread. The queue is prepared once before threads start, so that stopping is never undone.
+    void Run() final
+    {
+        if (owner_.expired()) {
+            return;
+        }
+        // The first thread stands for the runner in 'GetThreadId' and 'GetKernelThreadId'.
+        if (!started_.exchange(true)) {
+            threadId_ = std::this_thread::get_id();
+            kernelThreadId_ = getproctid();
+        }
+        std::weak_ptr<EventRunner> oldRunner = currentEventRunner;
+        currentEventRunner = owner_;
+
+        for (auto event = queue_->GetEvent(); event; event = queue_->GetEvent()) {
+            uint64_t ownerId = event->GetOwnerId();
+            ExecuteEventHandler(event);
+            queueBase_->ReleaseOwner(ownerId);
+        }
+
+        currentEventRunner = oldRunner;
+    }
+
+    bool IsCurrentThread() final
+    {
+        auto owner = owner_.lock();
+        return (owner != nullptr) && (GetCurrentEventRunner() == owner);
+    }
+
+    bool IsConcurrent() const final
+    {
+        return true;
+    }
+
+private:
+    std::shared_ptr<EventQueueBase> queueBase_;
+    std::atomic<bool> started_ {false};
+};
 }  // unnamed namespace
 
 void EventRunnerImpl::CrashCallback(char *buf, size_t len, void *ucontext)
@@ -509,8 +643,8 @@ void EventRunnerImpl::CrashCallback(char *buf, size_t len, void *ucontext)
     }
 
     if (!g_currentEventName.empty()) {
-        const char* file = g_currentEventCaller.file_.c_str();
-        const char* func = g_currentEventCaller.func_.c_str();
+        const char* file = g_currentEventCaller.file_;
+        const char* func = g_currentEventCaller.func_;
         const char* eventName = g_currentEventName.c_str();
         int line = g_currentEventCaller.line_;
         if (snprintf_s(buf, len, len - 1, "Current Event Caller info: [%s(%s:%d)]. EventName is '%s'",
@@ -603,12 +737,44 @@ std::shared_ptr<EventRunner> EventRunner::Create(bool inNewThread, ThreadMode th
     return sp;
 }
 
+std::shared_ptr<EventRunner> EventRunner::Create(bool inNewThread, WaitStrategy waitStrategy, EventLockType lockType)
+{
+    auto runner = Create(inNewThread, Mode::DEFAULT, lockType);
+    if (runner && runner->queue_) {
+        runner->queue_->SetWaitStrategy(waitStrategy);
+    }
+    return runner;
+}
+
+std::shared_ptr<EventRunner> EventRunner::Create(const std::string &threadName, WaitStrategy waitStrategy,
+    EventLockType lockType)
+{
+    // The runner may be waiting already, it is woken up and waits with the new strategy next time.
+    auto runner = Create(threadName, Mode::DEFAULT, ThreadMode::NEW_THREAD, lockType);
+    if (runner && runner->queue_) {
+        runner->queue_->SetWaitStrategy(waitStrategy);
+    }
+    return runner;
+}
+
 std::shared_ptr<EventRunner> EventRunner::Create(const std::string &threadName, Mode mode,
     ThreadMode threadMode, EventLockType lockType)
 {
     HILOGD("threadName is %{public}s %{public}d %{public}d %{public}d", threadName.c_str(), mode, threadMode, lockType);
     // Constructor of 'EventRunner' is private, could not use 'std::make_shared' to construct it.
     std::shared_ptr<EventRunner> sp(new EventRunner(true, mode));
+    if ((threadMode == ThreadMode::POOL) && (mode == Mode::DEFAULT)) {
+        auto ioWaiter = std::make_shared<PoolIoWaiter>();
+        auto pooledRunner = std::make_shared<PooledEventRunnerImpl>(sp, lockType, ioWaiter);
+        ioWaiter->Bind(pooledRunner);
+        pooledRunner->SetThreadName(threadName);
+        sp->innerRunner_ = pooledRunner;
+        sp->threadMode_ = ThreadMode::POOL;
+        sp->queue_ = pooledRunner->GetEventQueue();
+        sp->queue_->SetIoWaiter(false);
+        sp->queue_->Prepare();
+        return sp;
+    }
     auto innerRunner = std::make_shared<EventRunnerImpl>(sp, lockType);
     innerRunner->SetRunningMode(mode);
     sp->innerRunner_ = innerRunner;
@@ -648,6 +814,36 @@ std::shared_ptr<EventRunner> EventRunner::Create(const std::string &threadName,
     return sp;
 }
 
+std::shared_ptr<EventRunner> EventRunner::CreateConcurrent(const std::string &threadName, uint32_t consumerNum,
+    EventLockType lockType)
+{
+    if ((consumerNum == 0) || (consumerNum > MAX_CONSUMER_NUM)) {
+        HILOGE("Invalid consumer number %{public}u", consumerNum);
+        return nullptr;
+    }
+    // Constructor of 'EventRunner' is private, could not use 'std::make_shared' to construct it.
+    std::shared_ptr<EventRunner> sp(new EventRunner(true, Mode::DEFAULT));
+    auto innerRunner = std::make_shared<ConcurrentEventRunnerImpl>(sp, lockType);
+    innerRunner->SetThreadName(threadName);
+    sp->innerRunner_ = innerRunner;
+    sp->threadMode_ = ThreadMode::NEW_THREAD;
+    sp->queue_ = innerRunner->GetEventQueue();
+    sp->queue_->SetIoWaiter(false);
+    sp->queue_->Prepare();
+
+    for (uint32_t i = 0; i < consumerNum; ++i) {
+        auto thread = std::make_unique<std::thread>(EventRunnerImpl::ThreadMain,
+            std::weak_ptr<EventRunnerImpl>(innerRunner));
+        if (!innerRunner->Attach(thread)) {
+            HILOGW("Failed to attach thread, maybe process is exiting");
+            innerRunner->Stop();
+            thread->join();
+            break;
+        }
+    }
+    return sp;
+}
+
 std::shared_ptr<EventRunner> EventRunner::Current()
 {
 #ifdef FFRT_USAGE_ENABLE
@@ -764,6 +960,29 @@ void EventRunner::Dump(Dumper &dumper)
     dumper.Dump(dumper.GetTag() + " Event runner (" + "Thread name = " + innerRunner_->GetThreadName() +
                 ", Thread ID = " + std::to_string(GetKernelThreadId()) + ") is running" + std::string(LINE_SEPARATOR));
     queue_->Dump(dumper);
+    if (latencyStatsCreated_.load(std::memory_order_acquire)) {
+        DumpLatency(dumper, GetLatencySnapshot());
+    }
+}
+
+void EventRunner::SetLatencyStatsEnabled(bool enable)
+{
+    if (enable) {
+        std::call_once(latencyStatsOnce_, [this]() {
+            latencyStats_ = std::make_unique<LatencyStats>();
+            latencyStatsCreated_.store(true, std::memory_order_release);
+        });
+    }
+    latencyStatsEnabled_.store(enable, std::memory_order_release);
+}
+
+LatencySnapshot EventRunner::GetLatencySnapshot() const
+{
+    // Histograms are kept after disabled.
+    if (!latencyStatsCreated_.load(std::memory_order_acquire)) {
+        return LatencySnapshot();
+    }
+    return latencyStats_->GetSnapshot();
 }
 
 void EventRunner::DumpRunnerInfo(std::string& runnerInfo)
@@ -818,6 +1037,9 @@ std::shared_ptr<EventQueue> EventRunner::GetCurrentEventQueue()
 uint64_t EventRunner::GetThreadId()
 {
     std::thread::id tid = innerRunner_->GetThreadId();
+    if (tid == std::thread::id()) {
+        return 0;
+    }
     std::stringstream buf;
     buf << tid;
     std::string stid = buf.str();
@@ -840,10 +1062,10 @@ bool EventRunner::IsCurrentRunnerThread()
         auto sharedHandler =  *(reinterpret_cast<std::shared_ptr<EventHandler>*>(handler));
         return queue_ == sharedHandler->GetEventRunner()->GetEventQueue();
     } else {
-        return std::this_thread::get_id() == innerRunner_->GetThreadId();
+        return innerRunner_->IsCurrentThread();
     }
 #else
-    return std::this_thread::get_id() == innerRunner_->GetThreadId();
+    return innerRunner_->IsCurrentThread();
 #endif
 }
 
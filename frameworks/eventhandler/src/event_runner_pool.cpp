@@ -0,0 +1,269 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "event_runner_pool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include <sys/prctl.h>
+
+#include "event_logger.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+namespace {
+// Idle runners cost no thread, so a few workers are enough for many runners.
+const size_t MAX_POOL_WORKER_NUM = 4;
+// Workers started for blocked ones, so bounded only to stop a runaway chain.
+const size_t MAX_POOL_THREAD_NUM = 64;
+// Workers started for blocked ones are kept for a while after those are back, for the next blocking.
+constexpr std::chrono::seconds SPARE_WORKER_KEEP_ALIVE(1);
+DEFINE_EH_HILOG_LABEL("EventRunnerPool");
+
+thread_local bool g_isPoolWorker = false;
+}  // unnamed namespace
+
+bool PoolRunnable::MarkQueued()
+{
+    uint32_t state = state_.load(std::memory_order_acquire);
+    while (true) {
+        if (state == STATE_IDLE) {
+            if (state_.compare_exchange_weak(state, STATE_QUEUED, std::memory_order_acq_rel)) {
+                return true;
+            }
+        } else if (state == STATE_RUNNING) {
+            if (state_.compare_exchange_weak(state, STATE_RUNNING_WOKEN, std::memory_order_acq_rel)) {
+                return false;
+            }
+        } else {
+            // Queued already, or will be queued again after the running slice.
+            return false;
+        }
+    }
+}
+
+void PoolRunnable::Wake()
+{
+    if (!MarkQueued()) {
+        return;
+    }
+    auto runnable = weak_from_this().lock();
+    if (runnable) {
+        EventRunnerPool::GetInstance().Enqueue(std::move(runnable));
+    }
+}
+
+EventRunnerPool &EventRunnerPool::GetInstance()
+{
+    // Never destroyed, so that workers never run into a destroyed pool while the process exits.
+    static EventRunnerPool *instance = new EventRunnerPool();
+    return *instance;
+}
+
+EventRunnerPool::EventRunnerPool()
+{
+    workerNum_ = std::clamp<size_t>(std::thread::hardware_concurrency(), 1, MAX_POOL_WORKER_NUM);
+    std::lock_guard<std::mutex> lock(lock_);
+    for (size_t i = 0; i < workerNum_; ++i) {
+        StartWorkerLocked();
+    }
+    HILOGD("Started %{public}zu workers", workerNum_);
+}
+
+void EventRunnerPool::StartWorkerLocked()
+{
+    ++threadNum_;
+    std::thread(&EventRunnerPool::WorkerMain, this, nextWorkerIndex_++).detach();
+}
+
+bool EventRunnerPool::BeginBlocking()
+{
+    // Never create the pool for threads out of it.
+    if (!g_isPoolWorker) {
+        return false;
+    }
+    auto &pool = GetInstance();
+    std::lock_guard<std::mutex> lock(pool.lock_);
+    ++pool.blockedNum_;
+    if (pool.threadNum_ - pool.blockedNum_ >= pool.workerNum_) {
+        return true;
+    }
+    if (pool.threadNum_ >= MAX_POOL_THREAD_NUM) {
+        HILOGE("%{public}zu workers are blocked, runners in the pool may hang", pool.blockedNum_);
+        return true;
+    }
+    pool.StartWorkerLocked();
+    return true;
+}
+
+void EventRunnerPool::EndBlocking()
+{
+    auto &pool = GetInstance();
+    std::lock_guard<std::mutex> lock(pool.lock_);
+    --pool.blockedNum_;
+}
+
+bool EventRunnerPool::WaitAsSpareLocked(std::unique_lock<std::mutex> &lock)
+{
+    auto deadline = InnerEvent::Clock::now() + SPARE_WORKER_KEEP_ALIVE;
+    if (!timers_.empty()) {
+        deadline = std::min(deadline, timers_.top().deadline);
+    }
+    // Waiting for timers as well, since arming an earlier timer may wake up this worker only.
+    if ((condition_.wait_until(lock, deadline) == std::cv_status::timeout) && ready_.empty() &&
+        (threadNum_ - blockedNum_ > workerNum_) &&
+        (timers_.empty() || (timers_.top().deadline > InnerEvent::Clock::now()))) {
+        --threadNum_;
+        return true;
+    }
+    return false;
+}
+
+void EventRunnerPool::Enqueue(std::shared_ptr<PoolRunnable> runnable)
+{
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+        ready_.push_back(std::move(runnable));
+    }
+    condition_.notify_one();
+}
+
+void EventRunnerPool::WorkerMain(size_t index)
+{
+    std::string name = "EventPool#" + std::to_string(index);
+    if (prctl(PR_SET_NAME, name.c_str()) < 0) {
+        HILOGW("Failed to set name of worker %{public}zu", index);
+    }
+    g_isPoolWorker = true;
+    // Runnables may be released here for the last time, which releases their queues, so never under the lock.
+    std::vector<std::shared_ptr<PoolRunnable>> released;
+    std::unique_lock<std::mutex> lock(lock_);
+    while (true) {
+        FireTimersLocked(InnerEvent::Clock::now(), released);
+        if (!released.empty()) {
+            lock.unlock();
+            released.clear();
+            lock.lock();
+            continue;
+        }
+        if (!ready_.empty()) {
+            auto runnable = std::move(ready_.front());
+            ready_.pop_front();
+            if (!RunLocked(runnable, lock)) {
+                lock.unlock();
+                runnable.reset();
+                lock.lock();
+            }
+            continue;
+        }
+        if (threadNum_ - blockedNum_ > workerNum_) {
+            // Started for a blocked worker which is back, quit if not needed for a while.
+            if (WaitAsSpareLocked(lock)) {
+                return;
+            }
+            continue;
+        }
+        if (timers_.empty()) {
+            condition_.wait(lock);
+        } else {
+            condition_.wait_until(lock, timers_.top().deadline);
+        }
+    }
+}
+
+bool EventRunnerPool::RunLocked(std::shared_ptr<PoolRunnable> &runnable, std::unique_lock<std::mutex> &lock)
+{
+    runnable->state_.store(PoolRunnable::STATE_RUNNING, std::memory_order_release);
+    lock.unlock();
+    bool hasMore = false;
+    InnerEvent::TimePoint deadline = runnable->RunSlice(hasMore);
+    lock.lock();
+
+    if (!hasMore) {
+        if (deadline != InnerEvent::TimePoint::max()) {
+            ArmTimerLocked(runnable, deadline);
+        }
+        uint32_t expected = PoolRunnable::STATE_RUNNING;
+        if (runnable->state_.compare_exchange_strong(expected, PoolRunnable::STATE_IDLE,
+            std::memory_order_acq_rel)) {
+            return false;
+        }
+    }
+    // Still has due work, or woken up while running, queue it at the end to be fair to other runnables.
+    runnable->state_.store(PoolRunnable::STATE_QUEUED, std::memory_order_release);
+    ready_.push_back(std::move(runnable));
+    return true;
+}
+
+void EventRunnerPool::ArmTimerLocked(const std::shared_ptr<PoolRunnable> &runnable, InnerEvent::TimePoint deadline)
+{
+    // An earlier timer is armed already, the runnable arms this one again after that timer fires.
+    if (deadline >= runnable->timerDeadline_) {
+        return;
+    }
+    runnable->timerDeadline_ = deadline;
+    bool earliest = timers_.empty() || (deadline < timers_.top().deadline);
+    timers_.push({deadline, runnable});
+    if (earliest) {
+        // Let a waiting worker shorten its wait.
+        condition_.notify_one();
+    }
+}
+
+void EventRunnerPool::FireTimersLocked(InnerEvent::TimePoint now,
+    std::vector<std::shared_ptr<PoolRunnable>> &released)
+{
+    while (!timers_.empty() && (timers_.top().deadline <= now)) {
+        Timer timer = timers_.top();
+        timers_.pop();
+        auto runnable = timer.runnable.lock();
+        if (!runnable) {
+            continue;
+        }
+        // Skip timers replaced by an earlier one.
+        if (runnable->timerDeadline_ == timer.deadline) {
+            runnable->timerDeadline_ = InnerEvent::TimePoint::max();
+            if (runnable->MarkQueued()) {
+                ready_.push_back(std::move(runnable));
+                continue;
+            }
+        }
+        released.push_back(std::move(runnable));
+    }
+}
+
+void PoolIoWaiter::NotifyOne()
+{
+    auto runnable = runnable_.lock();
+    if (runnable) {
+        runnable->Wake();
+    }
+}
+
+bool PoolIoWaiter::AddFileDescriptor(int32_t fileDescriptor, uint32_t events, const std::string &taskName,
+    const std::shared_ptr<FileDescriptorListener>& listener, EventQueue::Priority priority)
+{
+    (void)events;
+    (void)taskName;
+    (void)listener;
+    (void)priority;
+    HILOGW("Runners in the pool do not listen file descriptor %{public}d", fileDescriptor);
+    return false;
+}
+}  // namespace AppExecFwk
+}  // namespace OHOS
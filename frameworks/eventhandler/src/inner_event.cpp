@@ -15,15 +15,19 @@
 
 #include "inner_event.h"
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
-#include <condition_variable>
 #include <mutex>
+#include <new>
+#include <unordered_set>
 #include <vector>
 
 #include "event_handler_utils.h"
 #include "event_logger.h"
 #include "singleton.h"
 #include "async_stack_adapter.h"
+#include "sync_waiter.h"
 
 namespace OHOS {
 namespace AppExecFwk {
@@ -31,39 +35,39 @@ namespace {
 static constexpr int DATETIME_STRING_LENGTH = 80;
 static constexpr int MAX_MS_LENGTH = 3;
 static constexpr int MS_PER_SECOND = 1000;
+// Max number of recycled events cached by each thread.
+static constexpr uint32_t THREAD_CACHE_CAPACITY = 32;
+static constexpr uint32_t DEFAULT_POOL_HIGH_WATERMARK = 512;
+static constexpr uint32_t DEFAULT_POOL_LOW_WATERMARK = 64;
+// Max number of names interned by 'Caller::Intern', which are never released.
+static constexpr size_t MAX_CALLER_NAME_NUM = 1024;
+std::atomic<uint64_t> g_eventUniqueIdSequence {0};
 DEFINE_EH_HILOG_LABEL("InnerEvent");
 
-class WaiterImp final : public InnerEvent::Waiter {
-public:
-    WaiterImp(){};
-    ~WaiterImp() override{};
-    DISALLOW_COPY_AND_MOVE(WaiterImp);
+// Waiter reused by all sync events sent from this thread.
+thread_local std::shared_ptr<SyncWaiter> g_threadSyncWaiter;
 
-    void Wait() final
-    {
-        std::unique_lock<std::mutex> lock(mutex_);
-        while (!finished_) {
-            ++waitingCount_;
-            condition_.wait(lock);
-            --waitingCount_;
-        }
-    }
+// Recycled events cached by each thread, it is trivially destructible so still usable while thread is exiting.
+struct ThreadEventCache {
+    void *slots[THREAD_CACHE_CAPACITY];
+    uint32_t count;
+    bool registered;
+    bool closed;
+};
 
-    void Notify() final
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        finished_ = true;
-        if (waitingCount_ > 0) {
-            condition_.notify_all();
-        }
-    }
+// Return the thread cache to the shared pool while thread exiting.
+class ThreadEventCacheFlusher final {
+public:
+    ThreadEventCacheFlusher() = default;
+    ~ThreadEventCacheFlusher();
+    DISALLOW_COPY_AND_MOVE(ThreadEventCacheFlusher);
 
-private:
-    std::mutex mutex_;
-    std::condition_variable condition_;
-    uint32_t waitingCount_ {0};
-    bool finished_ {false};
+    // Does nothing, but the call odr-uses the thread local flusher, so that its destructor runs at thread exit.
+    void Register() {}
 };
+
+thread_local ThreadEventCache g_threadEventCache = {};
+thread_local ThreadEventCacheFlusher g_threadEventCacheFlusher;
 }  // unnamed namespace
 
 // Implementation for event pool.
@@ -75,8 +79,72 @@ public:
 
     InnerEvent::Pointer Get()
     {
-        // Allocate new memory, while pool is empty.
-        return InnerEvent::Pointer(new (std::nothrow) InnerEvent, Drop);
+        void *storage = Acquire();
+        if (storage == nullptr) {
+            return InnerEvent::Pointer(nullptr, Drop);
+        }
+        return InnerEvent::Pointer(new (storage) InnerEvent, Drop);
+    }
+
+    bool SetWatermarks(uint32_t highWatermark, uint32_t lowWatermark)
+    {
+        if (lowWatermark > highWatermark) {
+            HILOGE("Invalid watermarks, high = %{public}u, low = %{public}u", highWatermark, lowWatermark);
+            return false;
+        }
+        std::vector<void *> freed;
+        {
+            std::lock_guard<std::mutex> lock(poolLock_);
+            highWatermark_.store(highWatermark, std::memory_order_relaxed);
+            lowWatermark_.store(lowWatermark, std::memory_order_relaxed);
+            ShrinkLocked(highWatermark, freed);
+        }
+        Free(freed);
+        return true;
+    }
+
+    InnerEvent::PoolStats GetStats() const
+    {
+        InnerEvent::PoolStats stats;
+        stats.hitCount = hitCount_.load(std::memory_order_relaxed);
+        stats.missCount = missCount_.load(std::memory_order_relaxed);
+        stats.cachedCount = cachedCount_.load(std::memory_order_relaxed);
+        stats.bytesHeld = stats.cachedCount * sizeof(InnerEvent);
+        return stats;
+    }
+
+    void Trim()
+    {
+        auto &cache = g_threadEventCache;
+        std::vector<void *> freed;
+        {
+            std::lock_guard<std::mutex> lock(poolLock_);
+            while (cache.count > 0) {
+                pool_.emplace_back(cache.slots[--cache.count]);
+            }
+            ShrinkLocked(lowWatermark_.load(std::memory_order_relaxed), freed);
+        }
+        Free(freed);
+    }
+
+    bool NeedTrim() const
+    {
+        return cachedCount_.load(std::memory_order_relaxed) > lowWatermark_.load(std::memory_order_relaxed);
+    }
+
+    void FlushThreadCache()
+    {
+        auto &cache = g_threadEventCache;
+        cache.closed = true;
+        std::vector<void *> freed;
+        {
+            std::lock_guard<std::mutex> lock(poolLock_);
+            while (cache.count > 0) {
+                pool_.emplace_back(cache.slots[--cache.count]);
+            }
+            ShrinkLocked(highWatermark_.load(std::memory_order_relaxed), freed);
+        }
+        Free(freed);
     }
 
 private:
@@ -88,10 +156,105 @@ private:
 
         // Clear content of the event
         event->ClearEvent();
-        if (event != nullptr) {
-            delete event;
+        // Destruct the event in place, so that nothing is left to the next user of this storage.
+        event->~InnerEvent();
+        InnerEventPool::GetInstance().Release(event);
+    }
+
+    void *Acquire()
+    {
+        auto &cache = g_threadEventCache;
+        if (cache.count > 0) {
+            hitCount_.fetch_add(1, std::memory_order_relaxed);
+            cachedCount_.fetch_sub(1, std::memory_order_relaxed);
+            return cache.slots[--cache.count];
+        }
+
+        void *storage = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(poolLock_);
+            if (!pool_.empty()) {
+                storage = pool_.back();
+                pool_.pop_back();
+                // Refill half of the thread cache at once, to reduce contention on the shared pool.
+                while (!cache.closed && !pool_.empty() && (cache.count < THREAD_CACHE_CAPACITY / 2)) {
+                    cache.slots[cache.count++] = pool_.back();
+                    pool_.pop_back();
+                }
+            }
+        }
+        if (storage != nullptr) {
+            hitCount_.fetch_add(1, std::memory_order_relaxed);
+            cachedCount_.fetch_sub(1, std::memory_order_relaxed);
+            return storage;
+        }
+
+        // Allocate new memory, while pool is empty.
+        missCount_.fetch_add(1, std::memory_order_relaxed);
+        return ::operator new(sizeof(InnerEvent), std::nothrow);
+    }
+
+    void Release(void *storage)
+    {
+        auto &cache = g_threadEventCache;
+        cachedCount_.fetch_add(1, std::memory_order_relaxed);
+        if (cache.closed) {
+            std::vector<void *> freed;
+            {
+                std::lock_guard<std::mutex> lock(poolLock_);
+                pool_.emplace_back(storage);
+                ShrinkLocked(highWatermark_.load(std::memory_order_relaxed), freed);
+            }
+            Free(freed);
+            return;
+        }
+
+        if (!cache.registered) {
+            g_threadEventCacheFlusher.Register();
+            cache.registered = true;
         }
+        if (cache.count == THREAD_CACHE_CAPACITY) {
+            // Thread cache is full, move the older half of it to the shared pool.
+            constexpr uint32_t half = THREAD_CACHE_CAPACITY / 2;
+            std::vector<void *> freed;
+            {
+                std::lock_guard<std::mutex> lock(poolLock_);
+                pool_.insert(pool_.end(), cache.slots, cache.slots + half);
+                ShrinkLocked(highWatermark_.load(std::memory_order_relaxed), freed);
+            }
+            Free(freed);
+            std::copy(cache.slots + half, cache.slots + THREAD_CACHE_CAPACITY, cache.slots);
+            cache.count -= half;
+        }
+        // Keep the latest released storage in the thread cache, it is most likely still hot.
+        cache.slots[cache.count++] = storage;
+    }
+
+    void ShrinkLocked(uint32_t watermark, std::vector<void *> &freed)
+    {
+        if (pool_.size() <= watermark) {
+            return;
+        }
+        freed.assign(pool_.begin() + watermark, pool_.end());
+        pool_.resize(watermark);
+        cachedCount_.fetch_sub(freed.size(), std::memory_order_relaxed);
     }
+
+    static void Free(const std::vector<void *> &freed)
+    {
+        for (void *storage : freed) {
+            ::operator delete(storage);
+        }
+    }
+
+    std::mutex poolLock_;
+    std::vector<void *> pool_;
+    // Written under 'poolLock_', but also read by 'NeedTrim' without it.
+    std::atomic<uint32_t> highWatermark_ {DEFAULT_POOL_HIGH_WATERMARK};
+    std::atomic<uint32_t> lowWatermark_ {DEFAULT_POOL_LOW_WATERMARK};
+    std::atomic<uint64_t> hitCount_ {0};
+    std::atomic<uint64_t> missCount_ {0};
+    std::atomic<uint64_t> cachedCount_ {0};
 };
 
 InnerEventPool::InnerEventPool()
@@ -104,6 +267,51 @@ InnerEventPool::~InnerEventPool()
     HILOGD("~InnerEventPool enter");
 }
 
+namespace {
+ThreadEventCacheFlusher::~ThreadEventCacheFlusher()
+{
+    InnerEventPool::GetInstance().FlushThreadCache();
+}
+}  // unnamed namespace
+
+bool InnerEvent::SetPoolWatermarks(uint32_t highWatermark, uint32_t lowWatermark)
+{
+    return InnerEventPool::GetInstance().SetWatermarks(highWatermark, lowWatermark);
+}
+
+InnerEvent::PoolStats InnerEvent::GetPoolStats()
+{
+    return InnerEventPool::GetInstance().GetStats();
+}
+
+void InnerEvent::TrimPool()
+{
+    auto &pool = InnerEventPool::GetInstance();
+    if (pool.NeedTrim()) {
+        pool.Trim();
+    }
+}
+
+const char *Caller::Intern(const std::string &name)
+{
+    if (name.empty()) {
+        return "";
+    }
+    // Nodes of unordered set are never moved, so the pointers are stable. Leaked to be safe at process exit.
+    static std::mutex namesLock;
+    static auto *names = new std::unordered_set<std::string>();
+    std::lock_guard<std::mutex> lock(namesLock);
+    auto it = names->find(name);
+    if (it != names->end()) {
+        return it->c_str();
+    }
+    if (names->size() >= MAX_CALLER_NAME_NUM) {
+        HILOGW("Too many caller names are interned, drop '%{public}s'", name.c_str());
+        return "";
+    }
+    return names->emplace(name).first->c_str();
+}
+
 InnerEvent::Pointer InnerEvent::Get()
 {
     auto event = InnerEventPool::GetInstance().Get();
@@ -117,7 +325,7 @@ InnerEvent::Pointer InnerEvent::Get(uint32_t innerEventId, int64_t param, const
         event->innerEventId_ = innerEventId;
         event->param_ = param;
         event->caller_ = caller;
-        HILOGD("innerEventId is %{public}u, caller is %{public}s", innerEventId, caller.ToString().c_str());
+        HILOGD("innerEventId is %{public}u, caller is %{public}s:%{public}d", innerEventId, caller.func_, caller.line_);
     }
     return event;
 }
@@ -130,19 +338,27 @@ InnerEvent::Pointer InnerEvent::Get(const EventId &innerEventId, int64_t param,
         event->param_ = param;
         event->caller_ = caller;
         if (innerEventId.index() == TYPE_U32_INDEX) {
-            HILOGD("innerEventId is %{public}u, caller is %{public}s",
-                std::get<uint32_t>(innerEventId),
-                caller.ToString().c_str());
+            HILOGD("innerEventId is %{public}u, caller is %{public}s:%{public}d",
+                std::get<uint32_t>(innerEventId), caller.func_, caller.line_);
         } else {
-            HILOGD("innerEventId is %{public}s, caller is %{public}s",
-                std::get<std::string>(innerEventId).c_str(),
-                caller.ToString().c_str());
+            HILOGD("innerEventId is %{public}s, caller is %{public}s:%{public}d",
+                std::get<std::string>(innerEventId).c_str(), caller.func_, caller.line_);
         }
     }
     return event;
 }
 
 InnerEvent::Pointer InnerEvent::Get(const Callback &callback, const std::string &name, const Caller &caller)
+{
+    // Returns nullptr while callback is invalid.
+    if (!callback) {
+        HILOGW("Failed to create inner event with an invalid callback");
+        return InnerEvent::Pointer(nullptr, nullptr);
+    }
+    return Get(TaskCallable(callback), name, caller);
+}
+
+InnerEvent::Pointer InnerEvent::Get(TaskCallable &&callback, const std::string &name, const Caller &caller)
 {
     // Returns nullptr while callback is invalid.
     if (!callback) {
@@ -152,10 +368,11 @@ InnerEvent::Pointer InnerEvent::Get(const Callback &callback, const std::string
 
     auto event = InnerEventPool::GetInstance().Get();
     if (event != nullptr) {
-        event->taskCallback_ = callback;
+        event->taskCallback_ = std::move(callback);
         event->taskName_ = name;
         event->caller_ = caller;
-        HILOGD("event taskName is '%{public}s', caller is %{public}s", name.c_str(), caller.ToString().c_str());
+        HILOGD("event taskName is '%{public}s', caller is %{public}s:%{public}d", name.c_str(), caller.func_,
+            caller.line_);
     }
     return event;
 }
@@ -188,9 +405,28 @@ void InnerEvent::ClearEvent()
 
     // Clear owner
     owner_.reset();
+    ownerId_ = 0;
+    eventId = 0;
     ReleaseStackId();
 }
 
+void InnerEvent::SwapContent(InnerEvent &other)
+{
+    std::swap(param_, other.param_);
+    std::swap(smartPtrTypeId_, other.smartPtrTypeId_);
+    std::swap(smartPtr_, other.smartPtr_);
+    std::swap(smartPtrDtor_, other.smartPtrDtor_);
+    std::swap(payloadTypeId_, other.payloadTypeId_);
+    std::swap(payload_, other.payload_);
+    std::swap(taskCallback_, other.taskCallback_);
+    std::swap(taskName_, other.taskName_);
+    std::swap(caller_, other.caller_);
+    std::swap(sendTime_, other.sendTime_);
+    std::swap(senderKernelThreadId_, other.senderKernelThreadId_);
+    std::swap(hiTraceId_, other.hiTraceId_);
+    std::swap(stackId_, other.stackId_);
+}
+
 void InnerEvent::WarnSmartPtrCastMismatch()
 {
     HILOGD("Type of the shared_ptr, weak_ptr or unique_ptr mismatched");
@@ -198,7 +434,20 @@ void InnerEvent::WarnSmartPtrCastMismatch()
 
 const std::shared_ptr<InnerEvent::Waiter> &InnerEvent::CreateWaiter()
 {
-    waiter_ = std::make_shared<WaiterImp>();
+    auto waiter = std::make_shared<SyncWaiter>();
+    waiter->Reset();
+    waiter_ = std::move(waiter);
+    return waiter_;
+}
+
+const std::shared_ptr<InnerEvent::Waiter> &InnerEvent::UseThreadWaiter()
+{
+    if (!g_threadSyncWaiter) {
+        g_threadSyncWaiter = std::make_shared<SyncWaiter>();
+    }
+    // The previous event has notified it, since the thread has returned from waiting for that event.
+    g_threadSyncWaiter->Reset();
+    waiter_ = g_threadSyncWaiter;
     return waiter_;
 }
 
@@ -272,6 +521,9 @@ std::string InnerEvent::Dump()
             content.append(", param = " + std::to_string(param_));
         }
         content.append(", caller = " + caller_.ToString());
+        if (eventId != 0) {
+            content.append(", unique id = " + std::to_string(eventId));
+        }
     } else {
         content.append("No handler");
     }
@@ -300,6 +552,9 @@ std::string InnerEvent::TraceInfo()
         }
         content.append("," + std::to_string(priority));
         content.append("," + caller_.ToString());
+        if (eventId != 0) {
+            content.append("," + std::to_string(eventId));
+        }
     } else {
         content.append("NA");
     }
@@ -309,9 +564,8 @@ std::string InnerEvent::TraceInfo()
 
 void InnerEvent::SetEventUniqueId()
 {
-    auto nowTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
-        std::chrono::steady_clock::now().time_since_epoch()).count();
-    eventId = std::to_string(nowTime);
+    // Ids only need to be unique, so the sequence needs no ordering with other memory.
+    eventId = g_eventUniqueIdSequence.fetch_add(1, std::memory_order_relaxed) + 1;
 }
 
 void InnerEvent::ReleaseStackId()
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "latency_histogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace OHOS {
+namespace AppExecFwk {
+namespace {
+const double PERCENTILE_50 = 0.5;
+const double PERCENTILE_90 = 0.9;
+const double PERCENTILE_99 = 0.99;
+const double PERCENTILE_999 = 0.999;
+const uint32_t BITS_OF_UINT64 = 64;
+}  // unnamed namespace
+
+LatencyHistogram::LatencyHistogram()
+{
+    for (auto &bucket : buckets_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+uint32_t LatencyHistogram::GetBucketIndex(uint64_t value)
+{
+    if (value < SUB_BUCKET_NUM) {
+        return static_cast<uint32_t>(value);
+    }
+    uint32_t exponent = BITS_OF_UINT64 - 1 - static_cast<uint32_t>(__builtin_clzll(value));
+    if (exponent > MAX_EXPONENT) {
+        return BUCKET_NUM - 1;
+    }
+    uint32_t subBucket = static_cast<uint32_t>(value >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKET_NUM - 1);
+    return ((exponent - SUB_BUCKET_BITS + 1) << SUB_BUCKET_BITS) + subBucket;
+}
+
+uint64_t LatencyHistogram::GetBucketLowerBound(uint32_t index)
+{
+    if (index < SUB_BUCKET_NUM) {
+        return index;
+    }
+    uint32_t group = index >> SUB_BUCKET_BITS;
+    uint64_t subBucket = index & (SUB_BUCKET_NUM - 1);
+    return (SUB_BUCKET_NUM + subBucket) << (group - 1);
+}
+
+void LatencyHistogram::Record(int64_t nanoseconds)
+{
+    uint64_t value = (nanoseconds > 0) ? static_cast<uint64_t>(nanoseconds) : 0;
+    buckets_[GetBucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    uint64_t max = max_.load(std::memory_order_relaxed);
+    while ((value > max) && !max_.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+    }
+}
+
+uint64_t LatencyHistogram::GetPercentile(const std::array<uint64_t, BUCKET_NUM> &buckets, uint64_t count,
+    double percentile) const
+{
+    uint64_t rank = std::max<uint64_t>(static_cast<uint64_t>(std::ceil(percentile * count)), 1);
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < BUCKET_NUM; ++i) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            // Upper bound of the bucket, but never more than the real maximum.
+            uint64_t upperBound = (i + 1 < BUCKET_NUM) ? GetBucketLowerBound(i + 1) - 1 : UINT64_MAX;
+            return std::min(upperBound, max_.load(std::memory_order_relaxed));
+        }
+    }
+    return max_.load(std::memory_order_relaxed);
+}
+
+LatencySummary LatencyHistogram::GetSummary() const
+{
+    LatencySummary summary;
+    std::array<uint64_t, BUCKET_NUM> buckets;
+    for (uint32_t i = 0; i < BUCKET_NUM; ++i) {
+        buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+        summary.count += buckets[i];
+    }
+    if (summary.count == 0) {
+        return summary;
+    }
+    summary.p50 = GetPercentile(buckets, summary.count, PERCENTILE_50);
+    summary.p90 = GetPercentile(buckets, summary.count, PERCENTILE_90);
+    summary.p99 = GetPercentile(buckets, summary.count, PERCENTILE_99);
+    summary.p999 = GetPercentile(buckets, summary.count, PERCENTILE_999);
+    summary.max = max_.load(std::memory_order_relaxed);
+    return summary;
+}
+
+void LatencyStats::Record(int32_t priority, int64_t deliveryNanoseconds, int64_t distributeNanoseconds)
+{
+    if ((priority < 0) || (static_cast<uint32_t>(priority) >= LatencySnapshot::PRIORITY_NUM)) {
+        return;
+    }
+    delivery_[priority].Record(deliveryNanoseconds);
+    distribute_[priority].Record(distributeNanoseconds);
+}
+
+LatencySnapshot LatencyStats::GetSnapshot() const
+{
+    LatencySnapshot snapshot;
+    for (uint32_t i = 0; i < LatencySnapshot::PRIORITY_NUM; ++i) {
+        snapshot.delivery[i] = delivery_[i].GetSummary();
+        snapshot.distribute[i] = distribute_[i].GetSummary();
+    }
+    return snapshot;
+}
+}  // namespace AppExecFwk
+}  // namespace OHOS
@@ -15,9 +15,15 @@
 
 #include "none_io_waiter.h"
 
+#include <algorithm>
 #include <chrono>
+#include <climits>
+#include <ctime>
+
+#include <unistd.h>
 
 #include "event_logger.h"
+#include "futex.h"
 
 namespace OHOS {
 namespace AppExecFwk {
@@ -25,7 +31,21 @@ namespace {
 const int32_t HOURS_PER_DAY = 24;
 const int32_t DAYS_PER_YEAR = 365;
 const int32_t HOURS_PER_YEAR = HOURS_PER_DAY * DAYS_PER_YEAR;
+const int64_t NANOSECONDS_PER_SECOND = 1000000000;
+// Spin no longer than a futex round trip, otherwise parking is cheaper.
+const int64_t MAX_SPIN_NANOSECONDS = 20000;
+// Read the clock once every these spins.
+const uint32_t SPINS_PER_CLOCK_CHECK = 64;
 DEFINE_EH_HILOG_LABEL("NoneIoWaiter");
+
+inline void CpuRelax()
+{
+#if defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield" ::: "memory");
+#elif defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
 }  // unnamed namespace
 
 // Nothing to do, but used to fix a codex warning.
@@ -38,9 +58,20 @@ bool NoneIoWaiter::WaitFor(UniqueLockBase &externLock, int64_t nanoseconds, bool
 {
     externLock.unlock();
 
+    if (strategy_ != WaitStrategy::BLOCK) {
+        Park(nanoseconds);
+        externLock.lock();
+        return true;
+    }
+
     std::unique_lock<std::mutex> lock(waitLock_);
+    uint64_t notifyAllCount = notifyAllCount_;
+    auto pred = [this, notifyAllCount] {
+        return (this->pendingNotifications_ > 0) || (this->notifyAllCount_ != notifyAllCount);
+    };
+    ++waiterNum_;
     if (nanoseconds < 0) {
-        condition_.wait(lock, [this] { return this->pred_; });
+        condition_.wait(lock, pred);
     } else {
         /*
          * Fix a problem in some versions of STL.
@@ -49,34 +80,129 @@ bool NoneIoWaiter::WaitFor(UniqueLockBase &externLock, int64_t nanoseconds, bool
          */
         static const auto oneYear = std::chrono::hours(HOURS_PER_YEAR);
         auto duration = std::chrono::nanoseconds(nanoseconds);
-        (void)condition_.wait_for(lock, (duration > oneYear) ? oneYear : duration, [this] { return this->pred_; });
+        (void)condition_.wait_for(lock, (duration > oneYear) ? oneYear : duration, pred);
+    }
+    --waiterNum_;
+    if (pendingNotifications_ > 0) {
+        --pendingNotifications_;
     }
     lock.unlock();
 
     externLock.lock();
-    pred_ = false;
     return true;
 }
 
 void NoneIoWaiter::NotifyOne()
 {
+    if (strategy_ != WaitStrategy::BLOCK) {
+        Unpark(1);
+        return;
+    }
     std::lock_guard<std::mutex> lock(waitLock_);
-    pred_ = true;
+    if (pendingNotifications_ <= waiterNum_) {
+        ++pendingNotifications_;
+    }
     condition_.notify_one();
 }
 
 void NoneIoWaiter::NotifyAll()
 {
+    if (strategy_ != WaitStrategy::BLOCK) {
+        Unpark(INT_MAX);
+        return;
+    }
     std::lock_guard<std::mutex> lock(waitLock_);
-    pred_ = true;
+    pendingNotifications_ = std::max(pendingNotifications_, 1u);
+    ++notifyAllCount_;
     condition_.notify_all();
 }
 
+bool NoneIoWaiter::TakeNotification()
+{
+    uint32_t expected = STATE_NOTIFIED;
+    return state_.compare_exchange_strong(expected, STATE_EMPTY, std::memory_order_acquire,
+        std::memory_order_relaxed);
+}
+
+bool NoneIoWaiter::Spin(int64_t nanoseconds)
+{
+    // Spinning only delays the notifier on a single cpu.
+    static const bool multiProcessor = sysconf(_SC_NPROCESSORS_ONLN) > 1;
+    if (!multiProcessor) {
+        return false;
+    }
+    int64_t spinTime = ((nanoseconds >= 0) && (nanoseconds < MAX_SPIN_NANOSECONDS)) ? nanoseconds :
+        MAX_SPIN_NANOSECONDS;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::nanoseconds(spinTime);
+    for (uint32_t spins = 1;; ++spins) {
+        if ((state_.load(std::memory_order_relaxed) == STATE_NOTIFIED) && TakeNotification()) {
+            return true;
+        }
+        if (((spins % SPINS_PER_CLOCK_CHECK) == 0) && (std::chrono::steady_clock::now() >= deadline)) {
+            return false;
+        }
+        CpuRelax();
+    }
+}
+
+void NoneIoWaiter::Park(int64_t nanoseconds)
+{
+    if (TakeNotification()) {
+        return;
+    }
+    if ((strategy_ == WaitStrategy::SPIN_THEN_PARK) && Spin(nanoseconds)) {
+        return;
+    }
+    if (nanoseconds == 0) {
+        return;
+    }
+    uint32_t expected = STATE_EMPTY;
+    if (!state_.compare_exchange_strong(expected, STATE_PARKED, std::memory_order_acq_rel)) {
+        // Notified after checking, so take it and do not park.
+        state_.exchange(STATE_EMPTY, std::memory_order_acquire);
+        return;
+    }
+    if (nanoseconds < 0) {
+        FutexWait(state_, STATE_PARKED, nullptr);
+    } else {
+        // Same limitation as the condition variable.
+        static const int64_t oneYear = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::hours(HOURS_PER_YEAR)).count();
+        int64_t duration = (nanoseconds > oneYear) ? oneYear : nanoseconds;
+        struct timespec timeout;
+        timeout.tv_sec = static_cast<time_t>(duration / NANOSECONDS_PER_SECOND);
+        timeout.tv_nsec = static_cast<long>(duration % NANOSECONDS_PER_SECOND);
+        FutexWait(state_, STATE_PARKED, &timeout);
+    }
+    // Take the notification if any, otherwise it is timed out or woken up spuriously, both are fine for the caller.
+    state_.exchange(STATE_EMPTY, std::memory_order_acquire);
+}
+
+void NoneIoWaiter::Unpark(int32_t count)
+{
+    // Runner is awake and will check the queue again, nothing to do.
+    if (state_.load(std::memory_order_relaxed) == STATE_NOTIFIED) {
+        return;
+    }
+    if (state_.exchange(STATE_NOTIFIED, std::memory_order_release) == STATE_PARKED) {
+        FutexWake(state_, count);
+    }
+}
+
 bool NoneIoWaiter::SupportListeningFileDescriptor() const
 {
     return false;
 }
 
+uint32_t NoneIoWaiter::GetWaiterNum()
+{
+    if (strategy_ != WaitStrategy::BLOCK) {
+        return (state_.load(std::memory_order_relaxed) == STATE_PARKED) ? 1 : 0;
+    }
+    std::lock_guard<std::mutex> lock(waitLock_);
+    return waiterNum_;
+}
+
 bool NoneIoWaiter::AddFileDescriptor(int32_t, uint32_t, const std::string&,
     const std::shared_ptr<FileDescriptorListener>&, EventQueue::Priority)
 {
@@ -0,0 +1,800 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pending_event_store.h"
+
+#include <algorithm>
+#include <deque>
+#include <iterator>
+#include <vector>
+
+namespace OHOS {
+namespace AppExecFwk {
+namespace {
+// Events are kept in a sorted list, same as the event queue used to do.
+class ListEventStore final : public PendingEventStore {
+public:
+    ListEventStore() = default;
+    ~ListEventStore() final = default;
+    DISALLOW_COPY_AND_MOVE(ListEventStore);
+
+    void Insert(InnerEvent::Pointer &event, EventInsertType insertType) final
+    {
+        if (insertType == EventInsertType::AT_FRONT) {
+            if (!events_.empty()) {
+                // Ensure that events queue is in ordered
+                auto headEvent = events_.begin();
+                if ((*headEvent)->GetHandleTime() < event->GetHandleTime()) {
+                    event->SetHandleTime((*headEvent)->GetHandleTime());
+                }
+            }
+            Track(*event);
+            events_.emplace_front(std::move(event));
+            return;
+        }
+
+        Track(*event);
+        auto it = events_.end();
+        auto eventTime = event->GetHandleTime();
+        while (it != events_.begin()) {
+            auto prevIt = std::prev(it);
+            if ((*prevIt)->GetHandleTime() <= eventTime) {
+                break;
+            }
+            it = prevIt;
+        }
+        events_.insert(it, std::move(event));
+    }
+
+    bool Empty() const final
+    {
+        return events_.empty();
+    }
+
+    size_t Size() const final
+    {
+        return events_.size();
+    }
+
+    const InnerEvent::Pointer &Front() const final
+    {
+        return events_.front();
+    }
+
+    InnerEvent::Pointer PopFront() final
+    {
+        InnerEvent::Pointer event = std::move(events_.front());
+        events_.pop_front();
+        Untrack(*event);
+        return event;
+    }
+
+    InnerEvent::Pointer PopFirstIf(const Filter &filter) final
+    {
+        auto it = std::find_if(events_.begin(), events_.end(), filter);
+        if (it == events_.end()) {
+            return InnerEvent::Pointer(nullptr, nullptr);
+        }
+        InnerEvent::Pointer event = std::move(*it);
+        events_.erase(it);
+        Untrack(*event);
+        return event;
+    }
+
+    bool HasExpiredIf(const InnerEvent::TimePoint &now, const Filter &filter) const final
+    {
+        for (auto it = events_.begin(); it != events_.end(); ++it) {
+            if ((*it)->GetHandleTime() > now) {
+                break;
+            }
+            if (filter(*it)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    InnerEvent::TimePoint FirstHandleTimeAfter(const InnerEvent::TimePoint &now) const final
+    {
+        for (const auto &event : events_) {
+            if (event->GetHandleTime() > now) {
+                return event->GetHandleTime();
+            }
+        }
+        return InnerEvent::TimePoint::max();
+    }
+
+    bool AnyOf(const Filter &filter) const final
+    {
+        return std::any_of(events_.begin(), events_.end(), filter);
+    }
+
+    void RemoveIf(const Filter &filter) final
+    {
+        events_.remove_if([this, &filter](const InnerEvent::Pointer &event) {
+            if (!filter(event)) {
+                return false;
+            }
+            Untrack(*event);
+            return true;
+        });
+    }
+
+    void ExtractIf(const Filter &filter, std::list<InnerEvent::Pointer> &extracted) final
+    {
+        for (auto it = events_.begin(); it != events_.end();) {
+            auto next = std::next(it);
+            if (filter(*it)) {
+                Untrack(**it);
+                extracted.splice(extracted.end(), events_, it);
+            }
+            it = next;
+        }
+    }
+
+    void ForEach(const Visitor &visitor) const final
+    {
+        for (auto it = events_.begin(); it != events_.end(); ++it) {
+            visitor(*it);
+        }
+    }
+
+    void Clear() final
+    {
+        ClearIndex();
+        events_.clear();
+    }
+
+protected:
+    InnerEvent::Pointer Erase(InnerEvent &event) final
+    {
+        // Only used to compare with other stores, so just search it.
+        auto it = std::find_if(events_.begin(), events_.end(), [&event](const InnerEvent::Pointer &p) {
+            return p.get() == &event;
+        });
+        InnerEvent::Pointer removed = std::move(*it);
+        events_.erase(it);
+        return removed;
+    }
+
+private:
+    std::list<InnerEvent::Pointer> events_;
+};
+
+/*
+ * Events arriving in handle time order are appended to a FIFO in O(1), which covers events sent without delay and
+ * events sent with the same delay. Others go to a 4-ary min heap. Each event gets a sequence number, so that the
+ * order of events with the same handle time is kept. Events inserted at front take decreasing negative sequences.
+ * Each event records its slot, so that an event found by the index is removed without searching: heap slots follow
+ * the moves of the heap, FIFO slots are counted from the first event ever pushed, and events removed from the middle
+ * of the FIFO leave holes which are skipped and dropped when reaching either end.
+ */
+class HeapEventStore final : public PendingEventStore {
+public:
+    HeapEventStore() = default;
+    ~HeapEventStore() final = default;
+    DISALLOW_COPY_AND_MOVE(HeapEventStore);
+
+    void Insert(InnerEvent::Pointer &event, EventInsertType insertType) final
+    {
+        Track(*event);
+        auto time = event->GetHandleTime();
+        if (insertType == EventInsertType::AT_FRONT) {
+            if (!Empty()) {
+                // Ensure that events queue is in ordered
+                const auto &headTime = FrontNode().time;
+                if (headTime < time) {
+                    event->SetHandleTime(headTime);
+                    time = headTime;
+                }
+            }
+            SetSlot(*event, --fifoBase_, false);
+            fifo_.emplace_front(Node {time, --headSeq_, std::move(event)});
+            return;
+        }
+
+        if (fifo_.empty() || !(time < fifo_.back().time)) {
+            SetSlot(*event, fifoBase_ + fifo_.size(), false);
+            fifo_.emplace_back(Node {time, ++tailSeq_, std::move(event)});
+            return;
+        }
+        LinkOf(*event).inHeap = true;
+        heap_.emplace_back(Node {time, ++tailSeq_, std::move(event)});
+        SiftUp(heap_.size() - 1);
+    }
+
+    bool Empty() const final
+    {
+        return fifo_.empty() && heap_.empty();
+    }
+
+    size_t Size() const final
+    {
+        return fifo_.size() - fifoHoles_ + heap_.size();
+    }
+
+    const InnerEvent::Pointer &Front() const final
+    {
+        return FrontNode().event;
+    }
+
+    InnerEvent::Pointer PopFront() final
+    {
+        InnerEvent::Pointer event = IsHeapFront() ? RemoveHeapAt(0) : RemoveFifoAt(0);
+        Untrack(*event);
+        return event;
+    }
+
+    InnerEvent::Pointer PopFirstIf(const Filter &filter) final
+    {
+        auto fifoIt = std::find_if(fifo_.begin(), fifo_.end(), [&filter](const Node &node) {
+            return node.event && filter(node.event);
+        });
+        size_t heapIndex = heap_.size();
+        for (size_t i = 0; i < heap_.size(); ++i) {
+            if (((heapIndex == heap_.size()) || Before(heap_[i], heap_[heapIndex])) && filter(heap_[i].event)) {
+                heapIndex = i;
+            }
+        }
+
+        InnerEvent::Pointer event(nullptr, nullptr);
+        bool foundInHeap = heapIndex < heap_.size();
+        if (foundInHeap && ((fifoIt == fifo_.end()) || Before(heap_[heapIndex], *fifoIt))) {
+            event = RemoveHeapAt(heapIndex);
+        } else if (fifoIt != fifo_.end()) {
+            event = RemoveFifoAt(static_cast<size_t>(std::distance(fifo_.begin(), fifoIt)));
+        } else {
+            return event;
+        }
+        Untrack(*event);
+        return event;
+    }
+
+    bool HasExpiredIf(const InnerEvent::TimePoint &now, const Filter &filter) const final
+    {
+        for (auto it = fifo_.begin(); it != fifo_.end(); ++it) {
+            if (it->time > now) {
+                break;
+            }
+            if (it->event && filter(it->event)) {
+                return true;
+            }
+        }
+        return HasExpiredInHeapIf(0, now, filter);
+    }
+
+    InnerEvent::TimePoint FirstHandleTimeAfter(const InnerEvent::TimePoint &now) const final
+    {
+        InnerEvent::TimePoint first = InnerEvent::TimePoint::max();
+        for (const auto &node : fifo_) {
+            if (node.event && (node.time > now)) {
+                first = node.time;
+                break;
+            }
+        }
+        FirstHeapTimeAfter(0, now, first);
+        return first;
+    }
+
+    bool AnyOf(const Filter &filter) const final
+    {
+        auto matched = [&filter](const Node &node) { return node.event && filter(node.event); };
+        return std::any_of(fifo_.begin(), fifo_.end(), matched) || std::any_of(heap_.begin(), heap_.end(), matched);
+    }
+
+    void RemoveIf(const Filter &filter) final
+    {
+        RemoveNodesIf([this, &filter](Node &node) {
+            if (!filter(node.event)) {
+                return false;
+            }
+            Untrack(*node.event);
+            return true;
+        });
+    }
+
+    void ExtractIf(const Filter &filter, std::list<InnerEvent::Pointer> &extracted) final
+    {
+        RemoveNodesIf([this, &filter, &extracted](Node &node) {
+            if (!filter(node.event)) {
+                return false;
+            }
+            Untrack(*node.event);
+            extracted.emplace_back(std::move(node.event));
+            return true;
+        });
+    }
+
+    void ForEach(const Visitor &visitor) const final
+    {
+        std::vector<const Node *> sortedHeap;
+        sortedHeap.reserve(heap_.size());
+        for (const auto &node : heap_) {
+            sortedHeap.emplace_back(&node);
+        }
+        std::sort(sortedHeap.begin(), sortedHeap.end(), [](const Node *left, const Node *right) {
+            return Before(*left, *right);
+        });
+
+        auto fifoIt = fifo_.begin();
+        auto heapIt = sortedHeap.begin();
+        while ((fifoIt != fifo_.end()) || (heapIt != sortedHeap.end())) {
+            if ((heapIt != sortedHeap.end()) && ((fifoIt == fifo_.end()) || Before(**heapIt, *fifoIt))) {
+                visitor((*heapIt)->event);
+                ++heapIt;
+            } else {
+                if (fifoIt->event) {
+                    visitor(fifoIt->event);
+                }
+                ++fifoIt;
+            }
+        }
+    }
+
+    void Clear() final
+    {
+        ClearIndex();
+        fifo_.clear();
+        heap_.clear();
+        fifoHoles_ = 0;
+    }
+
+protected:
+    InnerEvent::Pointer Erase(InnerEvent &event) final
+    {
+        const auto &link = LinkOf(event);
+        if (link.inHeap) {
+            return RemoveHeapAt(link.slot);
+        }
+        return RemoveFifoAt(link.slot - fifoBase_);
+    }
+
+private:
+    static constexpr size_t HEAP_ARITY = 4;
+
+    struct Node {
+        InnerEvent::TimePoint time;
+        int64_t seq;
+        // Null for holes in the FIFO.
+        InnerEvent::Pointer event;
+    };
+
+    static inline bool Before(const Node &left, const Node &right)
+    {
+        return (left.time < right.time) || ((left.time == right.time) && (left.seq < right.seq));
+    }
+
+    static inline void SetSlot(InnerEvent &event, size_t slot, bool inHeap)
+    {
+        auto &link = LinkOf(event);
+        link.slot = slot;
+        link.inHeap = inHeap;
+    }
+
+    inline bool IsHeapFront() const
+    {
+        return fifo_.empty() || (!heap_.empty() && Before(heap_.front(), fifo_.front()));
+    }
+
+    inline const Node &FrontNode() const
+    {
+        return IsHeapFront() ? heap_.front() : fifo_.front();
+    }
+
+    inline void PlaceHeapNode(size_t index, Node &&node)
+    {
+        heap_[index] = std::move(node);
+        LinkOf(*heap_[index].event).slot = index;
+    }
+
+    void SiftUp(size_t index)
+    {
+        Node node = std::move(heap_[index]);
+        while (index > 0) {
+            size_t parent = (index - 1) / HEAP_ARITY;
+            if (!Before(node, heap_[parent])) {
+                break;
+            }
+            PlaceHeapNode(index, std::move(heap_[parent]));
+            index = parent;
+        }
+        PlaceHeapNode(index, std::move(node));
+    }
+
+    void SiftDown(size_t index)
+    {
+        size_t size = heap_.size();
+        Node node = std::move(heap_[index]);
+        while (true) {
+            size_t first = index * HEAP_ARITY + 1;
+            if (first >= size) {
+                break;
+            }
+            size_t best = first;
+            size_t last = std::min(first + HEAP_ARITY, size);
+            for (size_t child = first + 1; child < last; ++child) {
+                if (Before(heap_[child], heap_[best])) {
+                    best = child;
+                }
+            }
+            if (!Before(heap_[best], node)) {
+                break;
+            }
+            PlaceHeapNode(index, std::move(heap_[best]));
+            index = best;
+        }
+        PlaceHeapNode(index, std::move(node));
+    }
+
+    void Heapify()
+    {
+        if (heap_.size() < 2) {
+            return;
+        }
+        for (size_t index = (heap_.size() - 2) / HEAP_ARITY + 1; index > 0; --index) {
+            SiftDown(index - 1);
+        }
+    }
+
+    InnerEvent::Pointer RemoveHeapAt(size_t index)
+    {
+        InnerEvent::Pointer event = std::move(heap_[index].event);
+        size_t last = heap_.size() - 1;
+        if (index != last) {
+            heap_[index] = std::move(heap_[last]);
+        }
+        heap_.pop_back();
+        if (index < heap_.size()) {
+            if ((index > 0) && Before(heap_[index], heap_[(index - 1) / HEAP_ARITY])) {
+                SiftUp(index);
+            } else {
+                SiftDown(index);
+            }
+        }
+        return event;
+    }
+
+    InnerEvent::Pointer RemoveFifoAt(size_t index)
+    {
+        InnerEvent::Pointer event = std::move(fifo_[index].event);
+        if ((index != 0) && (index + 1 != fifo_.size())) {
+            ++fifoHoles_;
+            if (fifoHoles_ > fifo_.size() / 2) {
+                CompactFifo();
+            }
+            return event;
+        }
+        // Keep both ends of the FIFO be events, so that the front and the back are always valid.
+        size_t dropped = 0;
+        while (!fifo_.empty() && !fifo_.front().event) {
+            fifo_.pop_front();
+            ++fifoBase_;
+            ++dropped;
+        }
+        while (!fifo_.empty() && !fifo_.back().event) {
+            fifo_.pop_back();
+            ++dropped;
+        }
+        // The removed node itself was not counted as a hole.
+        fifoHoles_ -= dropped - 1;
+        return event;
+    }
+
+    void CompactFifo()
+    {
+        fifo_.erase(std::remove_if(fifo_.begin(), fifo_.end(), [](const Node &node) { return !node.event; }),
+            fifo_.end());
+        fifoHoles_ = 0;
+        for (size_t index = 0; index < fifo_.size(); ++index) {
+            LinkOf(*fifo_[index].event).slot = fifoBase_ + index;
+        }
+    }
+
+    template<typename Matcher>
+    void RemoveNodesIf(Matcher matcher)
+    {
+        // Holes are dropped together with the matched events.
+        fifo_.erase(std::remove_if(fifo_.begin(), fifo_.end(), [&matcher](Node &node) {
+            return !node.event || matcher(node);
+        }), fifo_.end());
+        fifoHoles_ = 0;
+        for (size_t index = 0; index < fifo_.size(); ++index) {
+            LinkOf(*fifo_[index].event).slot = fifoBase_ + index;
+        }
+        auto it = std::remove_if(heap_.begin(), heap_.end(), matcher);
+        if (it != heap_.end()) {
+            heap_.erase(it, heap_.end());
+            for (size_t index = 0; index < heap_.size(); ++index) {
+                LinkOf(*heap_[index].event).slot = index;
+            }
+            Heapify();
+        }
+    }
+
+    bool HasExpiredInHeapIf(size_t index, const InnerEvent::TimePoint &now, const Filter &filter) const
+    {
+        // Children never expire earlier than their parent, so skip the whole sub tree.
+        if ((index >= heap_.size()) || (heap_[index].time > now)) {
+            return false;
+        }
+        if (filter(heap_[index].event)) {
+            return true;
+        }
+        size_t first = index * HEAP_ARITY + 1;
+        for (size_t child = first; child < first + HEAP_ARITY; ++child) {
+            if (HasExpiredInHeapIf(child, now, filter)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void FirstHeapTimeAfter(size_t index, const InnerEvent::TimePoint &now, InnerEvent::TimePoint &first) const
+    {
+        // Children are never earlier than their parent, so skip the sub tree which could not be earlier.
+        if ((index >= heap_.size()) || !(heap_[index].time < first)) {
+            return;
+        }
+        if (heap_[index].time > now) {
+            first = heap_[index].time;
+            return;
+        }
+        size_t firstChild = index * HEAP_ARITY + 1;
+        for (size_t child = firstChild; child < firstChild + HEAP_ARITY; ++child) {
+            FirstHeapTimeAfter(child, now, first);
+        }
+    }
+
+    std::deque<Node> fifo_;
+    std::vector<Node> heap_;
+    // Slot of the first node in the FIFO, wraps around when events are inserted at front.
+    size_t fifoBase_ {0};
+    size_t fifoHoles_ {0};
+    int64_t headSeq_ {0};
+    int64_t tailSeq_ {0};
+};
+}  // unnamed namespace
+
+std::unique_ptr<PendingEventStore> PendingEventStore::Create(Type type)
+{
+    if (type == Type::LIST) {
+        return std::make_unique<ListEventStore>();
+    }
+    return std::make_unique<HeapEventStore>();
+}
+
+bool PendingEventStore::AnyOfOwner(uint64_t ownerId, const IndexFilter &filter) const
+{
+    auto it = owners_.find(ownerId);
+    if (it == owners_.end()) {
+        return false;
+    }
+    return AnyOfChain(it->second.all, &PendingLink::ownerNext, filter);
+}
+
+bool PendingEventStore::AnyOfOwnerEvent(uint64_t ownerId, uint32_t innerEventId,
+    const IndexFilter &filter) const
+{
+    auto it = owners_.find(ownerId);
+    if (it == owners_.end()) {
+        return false;
+    }
+    auto chainIt = it->second.byId.find(innerEventId);
+    if (chainIt == it->second.byId.end()) {
+        return false;
+    }
+    return AnyOfChain(chainIt->second, &PendingLink::idNext, filter);
+}
+
+size_t PendingEventStore::ExtractOwnerIf(uint64_t ownerId, const IndexFilter &filter,
+    std::list<InnerEvent::Pointer> &extracted)
+{
+    auto it = owners_.find(ownerId);
+    if (it == owners_.end()) {
+        return 0;
+    }
+    return ExtractChainIf(it->second.all, &PendingLink::ownerNext, filter, extracted);
+}
+
+size_t PendingEventStore::ExtractOwnerEventIf(uint64_t ownerId, uint32_t innerEventId,
+    const IndexFilter &filter, std::list<InnerEvent::Pointer> &extracted)
+{
+    auto it = owners_.find(ownerId);
+    if (it == owners_.end()) {
+        return 0;
+    }
+    auto chainIt = it->second.byId.find(innerEventId);
+    if (chainIt == it->second.byId.end()) {
+        return 0;
+    }
+    return ExtractChainIf(chainIt->second, &PendingLink::idNext, filter, extracted);
+}
+
+void PendingEventStore::ExtractOrphansIf(const IndexFilter &filter, std::list<InnerEvent::Pointer> &extracted)
+{
+    std::vector<InnerEvent *> matched;
+    for (const auto &[ownerId, owner] : owners_) {
+        // All events of an owner share the same handler, except events sent without handler id.
+        if ((ownerId == 0) || owner.all.head->GetWeakOwner().expired()) {
+            for (InnerEvent *event = owner.all.head; event != nullptr; event = event->pendingLink_.ownerNext) {
+                if (filter(*event)) {
+                    matched.emplace_back(event);
+                }
+            }
+        }
+    }
+    for (InnerEvent *event : matched) {
+        Untrack(*event);
+        extracted.emplace_back(Erase(*event));
+    }
+}
+
+void PendingEventStore::Track(InnerEvent &event)
+{
+    auto &owner = owners_[event.ownerId_];
+    PushChain(owner.all, event, &PendingLink::ownerChain, &PendingLink::ownerPrev, &PendingLink::ownerNext);
+    if (event.pendingLink_.coalesced) {
+        owner.coalesced[event.pendingLink_.coalesceKey] = &event;
+    }
+    if (event.pendingLink_.withHandle) {
+        withHandle_[event.eventId] = &event;
+    }
+    if (event.HasTask()) {
+        event.pendingLink_.idChain = nullptr;
+        return;
+    }
+    PushChain(owner.byId[event.GetInnerEventId()], event, &PendingLink::idChain, &PendingLink::idPrev,
+        &PendingLink::idNext);
+}
+
+void PendingEventStore::Untrack(InnerEvent &event)
+{
+    if (event.pendingLink_.withHandle) {
+        withHandle_.erase(event.eventId);
+    }
+    auto owner = owners_.find(event.ownerId_);
+    if (owner == owners_.end()) {
+        return;
+    }
+    auto &ownerEvents = owner->second;
+    UnlinkChain(event, &PendingLink::ownerChain, &PendingLink::ownerPrev, &PendingLink::ownerNext);
+    if (event.pendingLink_.idChain != nullptr) {
+        PendingChain *chain = event.pendingLink_.idChain;
+        UnlinkChain(event, &PendingLink::idChain, &PendingLink::idPrev, &PendingLink::idNext);
+        auto chainIt = ownerEvents.byId.find(event.GetInnerEventId());
+        if ((chainIt != ownerEvents.byId.end()) && (&chainIt->second == chain) && (chain->count == 0)) {
+            ownerEvents.byId.erase(chainIt);
+        }
+    }
+    if (event.pendingLink_.coalesced) {
+        auto it = ownerEvents.coalesced.find(event.pendingLink_.coalesceKey);
+        if ((it != ownerEvents.coalesced.end()) && (it->second == &event)) {
+            ownerEvents.coalesced.erase(it);
+        }
+    }
+    if (ownerEvents.all.count == 0) {
+        // Drop the index of an owner together with its last pending event.
+        owners_.erase(owner);
+    }
+}
+
+void PendingEventStore::SetCoalesceKey(InnerEvent &event, uint64_t key)
+{
+    event.pendingLink_.coalesceKey = key;
+    event.pendingLink_.coalesced = true;
+}
+
+InnerEvent *PendingEventStore::FindCoalesced(uint64_t ownerId, uint64_t key) const
+{
+    auto owner = owners_.find(ownerId);
+    if (owner == owners_.end()) {
+        return nullptr;
+    }
+    auto it = owner->second.coalesced.find(key);
+    return (it != owner->second.coalesced.end()) ? it->second : nullptr;
+}
+
+InnerEvent *PendingEventStore::FindWithHandle(uint64_t eventUniqueId) const
+{
+    auto it = withHandle_.find(eventUniqueId);
+    return (it != withHandle_.end()) ? it->second : nullptr;
+}
+
+InnerEvent::Pointer PendingEventStore::Remove(InnerEvent &event)
+{
+    Untrack(event);
+    return Erase(event);
+}
+
+bool PendingEventStore::Merge(InnerEvent &pending, InnerEvent &latest, bool replace)
+{
+    if (pending.HasTask() != latest.HasTask()) {
+        return false;
+    }
+    if (!pending.HasTask() && (pending.innerEventId_ != latest.innerEventId_)) {
+        return false;
+    }
+    if (replace) {
+        pending.SwapContent(latest);
+    }
+    return true;
+}
+
+void PendingEventStore::ClearIndex()
+{
+    owners_.clear();
+    withHandle_.clear();
+}
+
+void PendingEventStore::PushChain(PendingChain &chain, InnerEvent &event, ChainField chainField, LinkField prev,
+    LinkField next)
+{
+    auto &link = event.pendingLink_;
+    link.*chainField = &chain;
+    link.*prev = nullptr;
+    link.*next = chain.head;
+    if (chain.head != nullptr) {
+        chain.head->pendingLink_.*prev = &event;
+    }
+    chain.head = &event;
+    ++chain.count;
+}
+
+void PendingEventStore::UnlinkChain(InnerEvent &event, ChainField chainField, LinkField prev, LinkField next)
+{
+    auto &link = event.pendingLink_;
+    PendingChain *chain = link.*chainField;
+    if (link.*prev != nullptr) {
+        (link.*prev)->pendingLink_.*next = link.*next;
+    } else {
+        chain->head = link.*next;
+    }
+    if (link.*next != nullptr) {
+        (link.*next)->pendingLink_.*prev = link.*prev;
+    }
+    --chain->count;
+    link.*chainField = nullptr;
+    link.*prev = nullptr;
+    link.*next = nullptr;
+}
+
+bool PendingEventStore::AnyOfChain(const PendingChain &chain, LinkField next, const IndexFilter &filter)
+{
+    for (InnerEvent *event = chain.head; event != nullptr; event = event->pendingLink_.*next) {
+        if (filter(*event)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t PendingEventStore::ExtractChainIf(const PendingChain &chain, LinkField next, const IndexFilter &filter,
+    std::list<InnerEvent::Pointer> &extracted)
+{
+    // Collect first, untracking an event changes the chain.
+    std::vector<InnerEvent *> matched;
+    for (InnerEvent *event = chain.head; event != nullptr; event = event->pendingLink_.*next) {
+        if (filter(*event)) {
+            matched.emplace_back(event);
+        }
+    }
+    for (InnerEvent *event : matched) {
+        Untrack(*event);
+        extracted.emplace_back(Erase(*event));
+    }
+    return matched.size();
+}
+}  // namespace AppExecFwk
+}  // namespace OHOS
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "task_future.h"
+
+#include <climits>
+
+#include "event_handler.h"
+#include "event_logger.h"
+#include "event_runner_pool.h"
+#include "futex.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+namespace {
+DEFINE_EH_HILOG_LABEL("TaskFuture");
+}  // unnamed namespace
+
+void TaskFutureState::Complete(ErrCode error)
+{
+    error_ = error;
+    uint32_t old = word_.fetch_or(READY, std::memory_order_acq_rel);
+    if ((old & PARKED) != 0) {
+        FutexWake(word_, INT32_MAX);
+    }
+    if ((old & CONTINUED) != 0) {
+        ScheduleContinuation();
+    }
+}
+
+void TaskFutureState::Wait()
+{
+    uint32_t value = word_.load(std::memory_order_acquire);
+    if ((value & READY) != 0) {
+        return;
+    }
+    PoolBlockingScope blocking;
+    while ((value & READY) == 0) {
+        if ((value & PARKED) == 0) {
+            value = word_.fetch_or(PARKED, std::memory_order_acquire) | PARKED;
+            continue;
+        }
+        FutexWait(word_, value);
+        value = word_.load(std::memory_order_acquire);
+    }
+}
+
+void TaskFutureState::SetContinuation(const std::shared_ptr<EventHandler> &handler, TaskCallable &&continuation)
+{
+    handler_ = handler;
+    continuation_ = std::move(continuation);
+    uint32_t old = word_.fetch_or(CONTINUED, std::memory_order_acq_rel);
+    if ((old & READY) != 0) {
+        ScheduleContinuation();
+    }
+}
+
+void TaskFutureState::ScheduleContinuation()
+{
+    // Move both out, the continuation owns this state, so keeping it here would never release the state.
+    auto handler = std::move(handler_);
+    TaskCallable continuation = std::move(continuation_);
+    if (!handler) {
+        continuation();
+        return;
+    }
+    auto event = InnerEvent::Get(std::move(continuation));
+    if (!handler->SendEvent(event)) {
+        HILOGW("ScheduleContinuation: Failed to post continuation, it is dropped");
+    }
+}
+}  // namespace AppExecFwk
+}  // namespace OHOS
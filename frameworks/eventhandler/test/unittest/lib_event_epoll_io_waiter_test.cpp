@@ -15,6 +15,8 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <vector>
 
@@ -24,10 +26,33 @@
 #include "epoll_io_waiter.h"
 #include "deamon_io_waiter.h"
 #include "none_io_waiter.h"
+#include "std_lock.h"
 
 using namespace testing::ext;
 using namespace OHOS::AppExecFwk;
 
+namespace {
+const int64_t SHORT_WAIT_NS = 300000;
+const int64_t ONE_MILLISECOND_NS = 1000000;
+const int WAIT_TIMES = 20;
+
+// Returns the shortest time of several waits, to filter out scheduling noise.
+int64_t MeasureShortestWait(EpollIoWaiter &ioWaiter)
+{
+    StdLock lock;
+    int64_t shortest = INT64_MAX;
+    for (int i = 0; i < WAIT_TIMES; ++i) {
+        UniqueLockBase uniqueLock(lock);
+        auto start = std::chrono::steady_clock::now();
+        EXPECT_TRUE(ioWaiter.WaitFor(uniqueLock, SHORT_WAIT_NS));
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        EXPECT_GE(elapsed.count(), SHORT_WAIT_NS);
+        shortest = std::min(shortest, static_cast<int64_t>(elapsed.count()));
+    }
+    return shortest;
+}
+}  // namespace
+
 class LibEventHandlerEpollIoWaiterTest : public testing::Test {
 public:
     static void SetUpTestCase(void);
@@ -240,4 +265,44 @@ HWTEST_F(LibEventHandlerEpollIoWaiterTest, NoneIoWaiter001, TestSize.Level1)
     auto listener = std::make_shared<IoFileDescriptorListener>();
     bool result = ioWaiter.AddFileDescriptor(1, 2, "task", listener, EventQueue::Priority::VIP);
     EXPECT_EQ(result, false);
-}
\ No newline at end of file
+}
+
+/*
+ * @tc.name: HighResolution001
+ * @tc.desc: wait shorter than one millisecond in high resolution mode
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerEpollIoWaiterTest, HighResolution001, TestSize.Level1)
+{
+    EpollIoWaiter ioWaiter;
+    ASSERT_TRUE(ioWaiter.Init());
+    ioWaiter.SetHighResolution(true);
+    EXPECT_LT(MeasureShortestWait(ioWaiter), ONE_MILLISECOND_NS);
+}
+
+/*
+ * @tc.name: HighResolution002
+ * @tc.desc: wait shorter than one millisecond with timerfd, if epoll_pwait2 is not supported
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerEpollIoWaiterTest, HighResolution002, TestSize.Level1)
+{
+    EpollIoWaiter ioWaiter;
+    ASSERT_TRUE(ioWaiter.Init());
+    ioWaiter.SetHighResolution(true);
+    ioWaiter.pwait2Supported_ = false;
+    EXPECT_LT(MeasureShortestWait(ioWaiter), ONE_MILLISECOND_NS);
+    EXPECT_GE(ioWaiter.timerFd_, 0);
+}
+
+/*
+ * @tc.name: HighResolution003
+ * @tc.desc: timeout is rounded up to milliseconds if not in high resolution mode
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerEpollIoWaiterTest, HighResolution003, TestSize.Level1)
+{
+    EpollIoWaiter ioWaiter;
+    ASSERT_TRUE(ioWaiter.Init());
+    EXPECT_GE(MeasureShortestWait(ioWaiter), ONE_MILLISECOND_NS);
+}
@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "event_handler.h"
+#include "event_handler_coroutine.h"
+#include "event_runner.h"
+
+using namespace testing::ext;
+using namespace OHOS::AppExecFwk;
+
+namespace {
+const useconds_t WAIT_STEP = 1000;
+const int32_t MAX_WAIT_STEPS = 2000;
+
+bool WaitFor(const std::atomic<bool> &flag)
+{
+    for (int32_t i = 0; (i < MAX_WAIT_STEPS) && !flag.load(); ++i) {
+        usleep(WAIT_STEP);
+    }
+    return flag.load();
+}
+
+EventCoroutine HopBetween(std::shared_ptr<EventHandler> first, std::shared_ptr<EventHandler> second,
+    std::vector<bool> &onRunner, std::atomic<bool> &done)
+{
+    EXPECT_TRUE(co_await first->Schedule());
+    onRunner.push_back(first->GetEventRunner()->GetKernelThreadId() == static_cast<uint64_t>(gettid()));
+    EXPECT_TRUE(co_await second->SwitchTo(EventQueue::Priority::HIGH));
+    onRunner.push_back(second->GetEventRunner()->GetKernelThreadId() == static_cast<uint64_t>(gettid()));
+    // Already on the runner of the second handler, so not suspended.
+    EXPECT_TRUE(co_await second->SwitchTo());
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_TRUE(co_await first->Delay(std::chrono::milliseconds(10)));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(10));
+    onRunner.push_back(first->GetEventRunner()->GetKernelThreadId() == static_cast<uint64_t>(gettid()));
+    done = true;
+}
+
+EventCoroutine ReadTwice(std::shared_ptr<EventHandler> handler, int32_t fd, std::vector<char> &data,
+    std::atomic<bool> &done)
+{
+    for (int i = 0; i < 2; ++i) {
+        uint32_t events = co_await handler->WaitFd(fd, FILE_DESCRIPTOR_INPUT_EVENT);
+        EXPECT_EQ(events, FILE_DESCRIPTOR_INPUT_EVENT);
+        char c = 0;
+        EXPECT_EQ(read(fd, &c, 1), 1);
+        data.push_back(c);
+    }
+    done = true;
+}
+
+class FrameGuard final {
+public:
+    explicit FrameGuard(bool &released) : released_(released) {}
+    ~FrameGuard()
+    {
+        released_ = true;
+    }
+
+private:
+    bool &released_;
+};
+
+EventCoroutine WaitForever(std::shared_ptr<EventHandler> handler, bool &released, bool &resumed)
+{
+    FrameGuard guard(released);
+    co_await handler->Schedule();
+    resumed = true;
+}
+
+EventCoroutine WaitInvalidFd(std::shared_ptr<EventHandler> handler, uint32_t &events)
+{
+    events = co_await handler->WaitFd(-1, FILE_DESCRIPTOR_INPUT_EVENT);
+}
+
+EventCoroutine ScheduleOn(std::shared_ptr<EventHandler> handler, bool &posted)
+{
+    posted = co_await handler->Schedule();
+}
+}  // unnamed namespace
+
+class LibEventHandlerCoroutineTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {}
+    static void TearDownTestCase(void) {}
+    void SetUp() {}
+    void TearDown() {}
+};
+
+/*
+ * @tc.name: Coroutine_001
+ * @tc.desc: Coroutines hop between runners with Schedule, SwitchTo and Delay
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerCoroutineTest, Coroutine_001, TestSize.Level1)
+{
+    auto firstRunner = EventRunner::Create(true);
+    auto first = std::make_shared<EventHandler>(firstRunner);
+    auto secondRunner = EventRunner::Create(true);
+    auto second = std::make_shared<EventHandler>(secondRunner);
+    std::vector<bool> onRunner;
+    std::atomic<bool> done {false};
+    HopBetween(first, second, onRunner, done);
+    EXPECT_TRUE(WaitFor(done));
+    EXPECT_EQ(onRunner, std::vector<bool>({true, true, true}));
+    firstRunner->Stop();
+    secondRunner->Stop();
+}
+
+/*
+ * @tc.name: Coroutine_002
+ * @tc.desc: Coroutines wait for a file descriptor, and wait for it again after resumed
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerCoroutineTest, Coroutine_002, TestSize.Level1)
+{
+    auto runner = EventRunner::Create(true);
+    auto handler = std::make_shared<EventHandler>(runner);
+    int32_t fds[2] = {-1, -1};
+    ASSERT_EQ(pipe2(fds, O_NONBLOCK), 0);
+    std::vector<char> data;
+    std::atomic<bool> done {false};
+    ReadTwice(handler, fds[0], data, done);
+    EXPECT_EQ(write(fds[1], "a", 1), 1);
+    usleep(WAIT_STEP * 10);
+    EXPECT_EQ(write(fds[1], "b", 1), 1);
+    EXPECT_TRUE(WaitFor(done));
+    EXPECT_EQ(data, std::vector<char>({'a', 'b'}));
+    runner->Stop();
+    close(fds[0]);
+    close(fds[1]);
+}
+
+/*
+ * @tc.name: Coroutine_003
+ * @tc.desc: A coroutine is resumed at once if it fails to be scheduled, and released if its resuming task is removed
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerCoroutineTest, Coroutine_003, TestSize.Level1)
+{
+    auto noRunnerHandler = std::make_shared<EventHandler>(nullptr);
+    bool posted = true;
+    ScheduleOn(noRunnerHandler, posted);
+    EXPECT_FALSE(posted);
+
+    auto runner = EventRunner::Create(false);
+    auto handler = std::make_shared<EventHandler>(runner);
+    bool released = false;
+    bool resumed = false;
+    WaitForever(handler, released, resumed);
+    EXPECT_FALSE(released);
+    handler->RemoveAllEvents();
+    EXPECT_TRUE(released);
+    EXPECT_FALSE(resumed);
+
+    uint32_t events = FILE_DESCRIPTOR_INPUT_EVENT;
+    WaitInvalidFd(handler, events);
+    EXPECT_EQ(events, 0);
+}
+
+/*
+ * @tc.name: Coroutine_004
+ * @tc.desc: A coroutine holding the last reference of its handler is released when its resuming task is removed
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerCoroutineTest, Coroutine_004, TestSize.Level1)
+{
+    auto runner = EventRunner::Create(false);
+    auto handler = std::make_shared<EventHandler>(runner);
+    std::weak_ptr<EventHandler> weakHandler = handler;
+    bool released = false;
+    bool resumed = false;
+    WaitForever(std::move(handler), released, resumed);
+    EXPECT_FALSE(weakHandler.expired());
+    // Releasing the frame destroys the handler, which removes its orphan events from the same queue.
+    runner->GetEventQueue()->RemoveAll();
+    EXPECT_TRUE(released);
+    EXPECT_FALSE(resumed);
+    EXPECT_TRUE(weakHandler.expired());
+}
@@ -16,9 +16,11 @@
 #include <cstdint>
 #include <gtest/gtest.h>
 
+#include <atomic>
 #include <chrono>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include <fcntl.h>
 #include <sys/resource.h>
@@ -29,6 +31,8 @@
 
 #include "epoll_io_waiter.h"
 #include "event_handler.h"
+#include "event_history_ring.h"
+#include "event_inbox.h"
 #include "event_queue.h"
 #include "event_queue_base.h"
 #include "event_runner.h"
@@ -56,9 +60,53 @@ const uint32_t REMOVE_EVENT_ID = 0;
 const uint32_t HAS_EVENT_ID = 100;
 const int64_t HAS_EVENT_PARAM = 1000;
 const uint32_t INSERT_DELAY = 10;
+const uint32_t INBOX_PRODUCER_NUM = 4;
+const int64_t INBOX_EVENT_NUM = 1000;
+const size_t DIRECT_DISPATCH_BUFFER_SIZE = 64;
+const int64_t DIRECT_DISPATCH_WAIT_MS = 1000;
+const uint32_t HISTORY_DEPTH = 4;
+const uint32_t HISTORY_EVENT_NUM = 6;
 bool isDump = false;
 
 std::atomic<bool> eventRan(false);
+
+class CountingIoWaiter : public IoWaiter {
+public:
+    bool WaitFor(UniqueLockBase &lock, int64_t nanoseconds, bool vsyncOnly = false) override
+    {
+        (void)lock;
+        (void)nanoseconds;
+        (void)vsyncOnly;
+        return true;
+    }
+
+    void NotifyOne() override
+    {
+        ++notifyCount;
+    }
+
+    void NotifyAll() override
+    {
+        ++notifyCount;
+    }
+
+    bool SupportListeningFileDescriptor() const override
+    {
+        return false;
+    }
+
+    bool AddFileDescriptor(int32_t fileDescriptor, uint32_t events, const std::string &taskName,
+        const std::shared_ptr<FileDescriptorListener>& listener, EventQueue::Priority priority) override
+    {
+        return false;
+    }
+
+    void RemoveFileDescriptor(int32_t fileDescriptor) override {}
+
+    void SetFileDescriptorEventCallback(const FileDescriptorEventCallback &callback) override {}
+
+    uint32_t notifyCount = 0;
+};
 }  // namespace
 
 class DumpTest : public Dumper {
@@ -84,6 +132,40 @@ public:
     }
 };
 
+class HistoryDumper : public Dumper {
+public:
+    void Dump(const std::string &message)
+    {
+        if (message.find(" No. ") != std::string::npos) {
+            histories.push_back(message);
+        }
+    }
+
+    std::string GetTag()
+    {
+        return "HistoryDumper";
+    }
+
+    std::vector<std::string> histories;
+};
+
+class CoalesceDumper : public Dumper {
+public:
+    void Dump(const std::string &message)
+    {
+        if (message.find(" Coalesced events : ") != std::string::npos) {
+            counts = message;
+        }
+    }
+
+    std::string GetTag()
+    {
+        return "CoalesceDumper";
+    }
+
+    std::string counts;
+};
+
 /**
  * Init FileDescriptor.
  *
@@ -356,6 +438,40 @@ public:
     IoFileDescriptorListener &operator=(IoFileDescriptorListener &&) = delete;
 };
 
+class CountingFileDescriptorListener : public FileDescriptorListener {
+public:
+    CountingFileDescriptorListener()
+    {}
+    ~CountingFileDescriptorListener()
+    {}
+
+    /* @param int32_t fileDescriptor */
+    void OnReadable(int32_t fileDescriptor)
+    {
+        char buffer[DIRECT_DISPATCH_BUFFER_SIZE];
+        while (read(fileDescriptor, buffer, sizeof(buffer)) > 0) {
+        }
+        currentHandler = EventHandler::Current();
+        ++readableCount;
+    }
+
+    /* @param int32_t fileDescriptor */
+    void OnWritable(int32_t)
+    {
+        currentHandler = EventHandler::Current();
+        ++writableCount;
+    }
+
+    std::shared_ptr<EventHandler> currentHandler;
+    std::atomic<uint32_t> readableCount {0};
+    std::atomic<uint32_t> writableCount {0};
+
+    CountingFileDescriptorListener(const CountingFileDescriptorListener &) = delete;
+    CountingFileDescriptorListener &operator=(const CountingFileDescriptorListener &) = delete;
+    CountingFileDescriptorListener(CountingFileDescriptorListener &&) = delete;
+    CountingFileDescriptorListener &operator=(CountingFileDescriptorListener &&) = delete;
+};
+
 class MyEventHandler : public EventHandler {
 public:
     explicit MyEventHandler(const std::shared_ptr<EventRunner> &runner) : EventHandler(runner)
@@ -3081,4 +3197,616 @@ HWTEST_F(LibEventHandlerEventQueueTest, SetVsyncFirstForceEnableTimeTest_001, Te
     EXPECT_EQ(queue.vsyncPolicy_, VsyncPolicy::VSYNC_FIRST_WITHOUT_DEFAULT_BARRIER);
     queue.SetVsyncFirstForceEnableTime(false, timeout);
     EXPECT_EQ(queue.vsyncFirstForceEnableEndTime_, 0);
-}
\ No newline at end of file
+}
+
+/*
+ * @tc.name: EventInbox_001
+ * @tc.desc: events are drained from the inbox in the order of pushing
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerEventQueueTest, EventInbox_001, TestSize.Level1)
+{
+    EventInbox inbox;
+    EXPECT_TRUE(inbox.Empty());
+    for (uint32_t i = 0; i < NUM; ++i) {
+        auto event = InnerEvent::Get(i);
+        EXPECT_EQ(inbox.Push(event), i == 0);
+        EXPECT_EQ(event, nullptr);
+    }
+    EXPECT_FALSE(inbox.Empty());
+
+    uint32_t expected = 0;
+    size_t count = inbox.Drain([&expected](InnerEvent::Pointer &event) {
+        ASSERT_NE(event, nullptr);
+        EXPECT_EQ(event->GetInnerEventId(), expected++);
+    });
+    EXPECT_EQ(count, NUM);
+    EXPECT_TRUE(inbox.Empty());
+    EXPECT_EQ(inbox.Drain([](InnerEvent::Pointer &) {}), 0);
+}
+
+/*
+ * @tc.name: InboxInsert_001
+ * @tc.desc: events sent by several threads through the inbox keep the order of each sender and priority
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerEventQueueTest, InboxInsert_001, TestSize.Level1)
+{
+    EventQueueBase queue(EventLockType::STANDARD);
+    queue.Prepare();
+    queue.SetInboxEnabled(true);
+    auto now = InnerEvent::Clock::now();
+    std::vector<std::thread> producers;
+    for (uint32_t producer = 0; producer < INBOX_PRODUCER_NUM; ++producer) {
+        producers.emplace_back([&queue, producer, now]() {
+            for (int64_t i = 0; i < INBOX_EVENT_NUM; ++i) {
+                auto event = InnerEvent::Get(producer, i);
+                event->SetSendTime(now);
+                event->SetHandleTime(now);
+                EXPECT_TRUE(queue.Insert(event, EventQueue::Priority::HIGH));
+            }
+        });
+    }
+    for (auto &producer : producers) {
+        producer.join();
+    }
+
+    // Disabling the inbox drains it, then the last event is inserted under lock, after all events of the inbox.
+    queue.SetInboxEnabled(false);
+    EXPECT_TRUE(queue.inbox_.Empty());
+    auto last = InnerEvent::Get(INBOX_PRODUCER_NUM);
+    last->SetSendTime(now);
+    last->SetHandleTime(now);
+    EXPECT_TRUE(queue.Insert(last, EventQueue::Priority::HIGH, EventInsertType::AT_END));
+    EXPECT_TRUE(queue.inbox_.Empty());
+
+    std::vector<int64_t> next(INBOX_PRODUCER_NUM, 0);
+    InnerEvent::TimePoint nextWakeUpTime = InnerEvent::TimePoint::max();
+    for (uint32_t i = 0; i < INBOX_PRODUCER_NUM * INBOX_EVENT_NUM; ++i) {
+        auto event = queue.GetExpiredEvent(nextWakeUpTime);
+        ASSERT_NE(event, nullptr);
+        uint32_t producer = event->GetInnerEventId();
+        ASSERT_LT(producer, INBOX_PRODUCER_NUM);
+        EXPECT_EQ(event->GetParam(), next[producer]++);
+    }
+    auto event = queue.GetExpiredEvent(nextWakeUpTime);
+    ASSERT_NE(event, nullptr);
+    EXPECT_EQ(event->GetInnerEventId(), INBOX_PRODUCER_NUM);
+    EXPECT_TRUE(queue.IsQueueEmpty());
+}
+
+/*
+ * @tc.name: InboxRemove_001
+ * @tc.desc: events still in the inbox are found by HasInnerEvent and removed by Remove
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerEventQueueTest, InboxRemove_001, TestSize.Level1)
+{
+    auto runner = EventRunner::Create(false);
+    auto handler = std::make_shared<EventHandler>(runner);
+    EventQueueBase queue(EventLockType::STANDARD);
+    queue.Prepare();
+    queue.SetInboxEnabled(true);
+
+    auto event = InnerEvent::Get(HAS_EVENT_ID, HAS_EVENT_PARAM);
+    event->SetOwner(handler);
+    event->SetOwnerId(handler->GetHandlerId());
+    EXPECT_TRUE(queue.Insert(event, EventQueue::Priority::LOW));
+    auto other = InnerEvent::Get(REMOVE_EVENT_ID);
+    other->SetOwner(handler);
+    other->SetOwnerId(handler->GetHandlerId());
+    EXPECT_TRUE(queue.Insert(other, EventQueue::Priority::IMMEDIATE));
+
+    EXPECT_TRUE(queue.HasInnerEvent(handler, HAS_EVENT_ID));
+    EXPECT_TRUE(queue.HasInnerEvent(handler, HAS_EVENT_PARAM));
+    queue.Remove(handler, HAS_EVENT_ID);
+    EXPECT_FALSE(queue.HasInnerEvent(handler, HAS_EVENT_ID));
+    EXPECT_TRUE(queue.HasInnerEvent(handler, REMOVE_EVENT_ID));
+
+    auto again = InnerEvent::Get(HAS_EVENT_ID);
+    again->SetOwner(handler);
+    again->SetOwnerId(handler->GetHandlerId());
+    EXPECT_TRUE(queue.Insert(again, EventQueue::Priority::HIGH));
+    queue.Remove(handler);
+    EXPECT_TRUE(queue.IsQueueEmpty());
+}
+
+/*
+ * @tc.name: InboxInsert_002
+ * @tc.desc: runner wakes up and runs tasks posted by several threads through the inbox
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerEventQueueTest, InboxInsert_002, TestSize.Level1)
+{
+    auto runner = EventRunner::Create(true);
+    auto handler = std::make_shared<EventHandler>(runner);
+    runner->GetEventQueue()->SetInboxEnabled(true);
+    std::atomic<int64_t> count(0);
+    std::vector<std::thread> producers;
+    for (uint32_t producer = 0; producer < INBOX_PRODUCER_NUM; ++producer) {
+        producers.emplace_back([&handler, &count]() {
+            for (int64_t i = 0; i < INBOX_EVENT_NUM; ++i) {
+                EXPECT_TRUE(handler->PostTask([&count]() { count.fetch_add(1); }));
+            }
+        });
+    }
+    for (auto &producer : producers) {
+        producer.join();
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(REMOVE_WAIT_TIME);
+    while ((count.load() < INBOX_PRODUCER_NUM * INBOX_EVENT_NUM) && (std::chrono::steady_clock::now() < deadline)) {
+        usleep(INSERT_DELAY);
+    }
+    EXPECT_EQ(count.load(), INBOX_PRODUCER_NUM * INBOX_EVENT_NUM);
+    runner->Stop();
+}
+
+/*
+ * @tc.name: InsertEvents_001
+ * @tc.desc: events inserted together keep their order and priority, and wake up the runner only once
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerEventQueueTest, InsertEvents_001, TestSize.Level1)
+{
+    auto ioWaiter = std::make_shared<CountingIoWaiter>();
+    EventQueueBase queue(ioWaiter, EventLockType::STANDARD);
+    queue.Prepare();
+    auto now = InnerEvent::Clock::now();
+    std::vector<EventQueue::InsertItem> items;
+    const uint32_t eventNum = 6;
+    for (uint32_t i = 0; i < eventNum; ++i) {
+        auto event = InnerEvent::Get(i);
+        event->SetSendTime(now);
+        event->SetHandleTime(now);
+        items.push_back({std::move(event), (i < NUM) ? EventQueue::Priority::HIGH : EventQueue::Priority::LOW});
+    }
+    EXPECT_TRUE(queue.InsertEvents(items));
+    EXPECT_EQ(ioWaiter->notifyCount, 1u);
+    for (const auto &item : items) {
+        EXPECT_EQ(item.event, nullptr);
+    }
+
+    InnerEvent::TimePoint nextWakeUpTime = InnerEvent::TimePoint::max();
+    for (uint32_t i = 0; i < eventNum; ++i) {
+        auto event = queue.GetExpiredEvent(nextWakeUpTime);
+        ASSERT_NE(event, nullptr);
+        EXPECT_EQ(event->GetInnerEventId(), i);
+    }
+    EXPECT_TRUE(queue.IsQueueEmpty());
+}
+
+/*
+ * @tc.name: InsertEvents_002
+ * @tc.desc: nothing is inserted if one of the events is invalid
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerEventQueueTest, InsertEvents_002, TestSize.Level1)
+{
+    auto ioWaiter = std::make_shared<CountingIoWaiter>();
+    EventQueueBase queue(ioWaiter, EventLockType::STANDARD);
+    queue.Prepare();
+    std::vector<EventQueue::InsertItem> items;
+    items.push_back({InnerEvent::Get(REMOVE_EVENT_ID), EventQueue::Priority::LOW});
+    items.push_back({InnerEvent::Pointer(nullptr, nullptr), EventQueue::Priority::LOW});
+    EXPECT_FALSE(queue.InsertEvents(items));
+    EXPECT_NE(items[0].event, nullptr);
+    EXPECT_EQ(ioWaiter->notifyCount, 0u);
+    EXPECT_TRUE(queue.IsQueueEmpty());
+}
+
+/*
+ * @tc.name: InsertEvents_003
+ * @tc.desc: default insertion of events stops at the first one failed, and leaves the rest in items
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerEventQueueTest, InsertEvents_003, TestSize.Level1)
+{
+    auto ioWaiter = std::make_shared<CountingIoWaiter>();
+    EventQueueBase queue(ioWaiter, EventLockType::STANDARD);
+    queue.Prepare();
+    std::vector<EventQueue::InsertItem> items;
+    items.push_back({InnerEvent::Get(REMOVE_EVENT_ID), EventQueue::Priority::LOW});
+    items.push_back({InnerEvent::Pointer(nullptr, nullptr), EventQueue::Priority::LOW});
+    items.push_back({InnerEvent::Get(REMOVE_EVENT_ID), EventQueue::Priority::LOW});
+    EXPECT_FALSE(queue.EventQueue::InsertEvents(items));
+    EXPECT_EQ(items[0].event, nullptr);
+    EXPECT_NE(items[2].event, nullptr);
+    EXPECT_FALSE(queue.IsQueueEmpty());
+    queue.RemoveAll();
+}
+
+/*
+ * @tc.name: DirectDispatch_001
+ * @tc.desc: readiness of a direct dispatch listener is coalesced and dispatched once
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerEventQueueTest, DirectDispatch_001, TestSize.Level1)
+{
+    auto runner = EventRunner::Create(false);
+    auto handler = std::make_shared<EventHandler>(runner);
+    EventQueueBase queue(EventLockType::STANDARD);
+    queue.Prepare();
+    int32_t fds[] = {-1, -1};
+    int32_t fileDescriptor = InitFileDescriptor(fds);
+    fcntl(fileDescriptor, F_SETFL, fcntl(fileDescriptor, F_GETFL) | O_NONBLOCK);
+    auto listener = std::make_shared<CountingFileDescriptorListener>();
+    listener->SetDirectDispatch(true);
+    listener->SetOwner(handler);
+    queue.listeners_.emplace(fileDescriptor, listener);
+
+    EXPECT_TRUE(queue.RecordReadyFileDescriptor(fileDescriptor, FILE_DESCRIPTOR_INPUT_EVENT, listener,
+        EventQueue::Priority::LOW));
+    EXPECT_TRUE(queue.RecordReadyFileDescriptor(fileDescriptor, FILE_DESCRIPTOR_INPUT_EVENT, listener,
+        EventQueue::Priority::LOW));
+    EXPECT_TRUE(queue.RecordReadyFileDescriptor(fileDescriptor, FILE_DESCRIPTOR_OUTPUT_EVENT, listener,
+        EventQueue::Priority::LOW));
+    EXPECT_EQ(queue.readyOrder_.size(), 1u);
+    EXPECT_EQ(queue.readyFileDescriptors_[fileDescriptor].events,
+        FILE_DESCRIPTOR_INPUT_EVENT | FILE_DESCRIPTOR_OUTPUT_EVENT);
+
+    UniqueLockBase lock(*queue.queueLock_);
+    auto event = queue.PickReadyFileDescriptorEventLocked(InnerEvent::Clock::now());
+    EXPECT_EQ(queue.PickReadyFileDescriptorEventLocked(InnerEvent::Clock::now()), nullptr);
+    lock.unlock();
+    ASSERT_NE(event, nullptr);
+    EXPECT_EQ(event->GetOwner(), handler);
+    EXPECT_EQ(event->GetEventPriority(), static_cast<int32_t>(EventQueue::Priority::LOW));
+    EXPECT_EQ(listener->readableCount.load(), 0u);
+    handler->DistributeEvent(event);
+    EXPECT_EQ(listener->readableCount.load(), 1u);
+    EXPECT_EQ(listener->writableCount.load(), 1u);
+    EXPECT_EQ(listener->currentHandler, handler);
+    queue.listeners_.clear();
+    close(fds[0]);
+    close(fds[1]);
+}
+
+/*
+ * @tc.name: DirectDispatch_002
+ * @tc.desc: expired events with higher priority are handled before ready file descriptors
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerEventQueueTest, DirectDispatch_002, TestSize.Level1)
+{
+    auto runner = EventRunner::Create(false);
+    auto handler = std::make_shared<EventHandler>(runner);
+    EventQueueBase queue(EventLockType::STANDARD);
+    queue.Prepare();
+    int32_t fds[] = {-1, -1};
+    int32_t fileDescriptor = InitFileDescriptor(fds);
+    auto lowListener = std::make_shared<CountingFileDescriptorListener>();
+    auto immediateListener = std::make_shared<CountingFileDescriptorListener>();
+    lowListener->SetOwner(handler);
+    immediateListener->SetOwner(handler);
+    queue.listeners_.emplace(fds[0], lowListener);
+    queue.listeners_.emplace(fds[1], immediateListener);
+
+    auto event = InnerEvent::Get(REMOVE_EVENT_ID);
+    event->SetOwner(handler);
+    queue.Insert(event, EventQueue::Priority::HIGH);
+    queue.RecordReadyFileDescriptor(fileDescriptor, FILE_DESCRIPTOR_OUTPUT_EVENT, lowListener,
+        EventQueue::Priority::LOW);
+    UniqueLockBase lock(*queue.queueLock_);
+    EXPECT_EQ(queue.PickReadyFileDescriptorEventLocked(InnerEvent::Clock::now()), nullptr);
+    lock.unlock();
+
+    queue.RecordReadyFileDescriptor(fds[1], FILE_DESCRIPTOR_OUTPUT_EVENT, immediateListener,
+        EventQueue::Priority::IMMEDIATE);
+    lock.lock();
+    auto ready = queue.PickReadyFileDescriptorEventLocked(InnerEvent::Clock::now());
+    lock.unlock();
+    ASSERT_NE(ready, nullptr);
+    handler->DistributeEvent(ready);
+    EXPECT_EQ(lowListener->writableCount.load(), 0u);
+    EXPECT_EQ(immediateListener->writableCount.load(), 1u);
+
+    queue.RemoveAll();
+    lock.lock();
+    ready = queue.PickReadyFileDescriptorEventLocked(InnerEvent::Clock::now());
+    lock.unlock();
+    ASSERT_NE(ready, nullptr);
+    handler->DistributeEvent(ready);
+    EXPECT_EQ(lowListener->writableCount.load(), 1u);
+    queue.listeners_.clear();
+    close(fds[0]);
+    close(fds[1]);
+}
+
+/*
+ * @tc.name: DirectDispatch_003
+ * @tc.desc: a direct dispatch listener is called by a running event runner
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerEventQueueTest, DirectDispatch_003, TestSize.Level1)
+{
+    auto runner = EventRunner::Create(true);
+    auto handler = std::make_shared<EventHandler>(runner);
+    int32_t fds[] = {-1, -1};
+    int32_t fileDescriptor = InitFileDescriptor(fds);
+    fcntl(fileDescriptor, F_SETFL, fcntl(fileDescriptor, F_GETFL) | O_NONBLOCK);
+    auto listener = std::make_shared<CountingFileDescriptorListener>();
+    listener->SetDirectDispatch(true);
+    auto result = handler->AddFileDescriptorListener(fileDescriptor, FILE_DESCRIPTOR_INPUT_EVENT, listener,
+        "DirectDispatch_003");
+    EXPECT_EQ(result, ERR_OK);
+
+    const char data = 'a';
+    EXPECT_EQ(write(fds[1], &data, sizeof(data)), static_cast<ssize_t>(sizeof(data)));
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(DIRECT_DISPATCH_WAIT_MS);
+    while ((listener->readableCount.load() == 0) && (std::chrono::steady_clock::now() < deadline)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_GE(listener->readableCount.load(), 1u);
+    EXPECT_EQ(listener->currentHandler, handler);
+    handler->RemoveFileDescriptorListener(fileDescriptor);
+    runner->Stop();
+    close(fds[0]);
+    close(fds[1]);
+}
+
+/*
+ * @tc.name: DirectDispatch_004
+ * @tc.desc: ready file descriptors of a released owner are dropped, and a low priority event goes after enough
+ *           ready file descriptors in higher priority
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerEventQueueTest, DirectDispatch_004, TestSize.Level1)
+{
+    auto runner = EventRunner::Create(false);
+    auto handler = std::make_shared<EventHandler>(runner);
+    EventQueueBase queue(EventLockType::STANDARD);
+    queue.Prepare();
+    int32_t fds[] = {-1, -1};
+    InitFileDescriptor(fds);
+    auto orphanListener = std::make_shared<CountingFileDescriptorListener>();
+    auto listener = std::make_shared<CountingFileDescriptorListener>();
+    listener->SetOwner(handler);
+    queue.listeners_.emplace(fds[0], orphanListener);
+    queue.listeners_.emplace(fds[1], listener);
+    queue.RecordReadyFileDescriptor(fds[0], FILE_DESCRIPTOR_OUTPUT_EVENT, orphanListener,
+        EventQueue::Priority::HIGH);
+    UniqueLockBase lock(*queue.queueLock_);
+    EXPECT_EQ(queue.PickReadyFileDescriptorEventLocked(InnerEvent::Clock::now()), nullptr);
+    EXPECT_TRUE(queue.readyOrder_.empty());
+    lock.unlock();
+
+    auto event = InnerEvent::Get(REMOVE_EVENT_ID);
+    event->SetOwner(handler);
+    queue.Insert(event, EventQueue::Priority::LOW);
+    auto &subQueue = queue.subEventQueues_[static_cast<uint32_t>(EventQueue::Priority::HIGH)];
+    for (uint32_t i = 0; i <= subQueue.maxHandledEventsCount; ++i) {
+        queue.RecordReadyFileDescriptor(fds[1], FILE_DESCRIPTOR_OUTPUT_EVENT, listener, EventQueue::Priority::HIGH);
+        lock.lock();
+        auto ready = queue.PickReadyFileDescriptorEventLocked(InnerEvent::Clock::now());
+        lock.unlock();
+        EXPECT_EQ((ready == nullptr), (i == subQueue.maxHandledEventsCount));
+    }
+    auto low = queue.GetEvent();
+    ASSERT_NE(low, nullptr);
+    EXPECT_EQ(low->GetInnerEventId(), REMOVE_EVENT_ID);
+    EXPECT_EQ(subQueue.handledEventsCount, 0u);
+    lock.lock();
+    EXPECT_NE(queue.PickReadyFileDescriptorEventLocked(InnerEvent::Clock::now()), nullptr);
+    lock.unlock();
+    queue.listeners_.clear();
+    close(fds[0]);
+    close(fds[1]);
+}
+
+/*
+ * @tc.name: EventHistoryRing_001
+ * @tc.desc: records are read back after wrapping around and names are interned once
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerEventQueueTest, EventHistoryRing_001, TestSize.Level1)
+{
+    EventHistoryRing ring(HISTORY_DEPTH - 1);
+    EXPECT_EQ(ring.Depth(), HISTORY_DEPTH);
+    EventHistoryRing::Record record {};
+    EXPECT_FALSE(ring.Read(0, record));
+
+    uint32_t nameId = ring.Intern("task");
+    EXPECT_NE(nameId, 0u);
+    EXPECT_EQ(ring.Intern("task"), nameId);
+    EXPECT_EQ(ring.Intern(""), 0u);
+    EXPECT_EQ(ring.GetName(nameId), "task");
+
+    for (uint32_t i = 0; i < HISTORY_EVENT_NUM; ++i) {
+        record.innerEventId = i;
+        record.nameId = nameId;
+        ring.Begin(record);
+        EXPECT_TRUE(ring.Read(i, record));
+        EXPECT_EQ(record.completeTime, EventHistoryRing::NOT_COMPLETED);
+        ring.Complete(i);
+    }
+    for (uint32_t i = HISTORY_EVENT_NUM - HISTORY_DEPTH; i < HISTORY_EVENT_NUM; ++i) {
+        EXPECT_TRUE(ring.Read(i, record));
+        EXPECT_EQ(record.innerEventId, i);
+        EXPECT_EQ(record.completeTime, static_cast<int64_t>(i));
+        EXPECT_EQ(record.nameId, nameId);
+    }
+}
+
+/*
+ * @tc.name: HistoryDepth_001
+ * @tc.desc: dump shows the configured number of history events, and nothing after history is disabled
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerEventQueueTest, HistoryDepth_001, TestSize.Level1)
+{
+    auto runner = EventRunner::Create(false);
+    auto handler = std::make_shared<EventHandler>(runner);
+    EventQueueBase queue(EventLockType::STANDARD);
+    queue.Prepare();
+    queue.SetHistoryDepth(HISTORY_DEPTH);
+    for (uint32_t i = 0; i < HISTORY_EVENT_NUM; ++i) {
+        auto event = InnerEvent::Get([]() {}, "HistoryDepth_001");
+        event->SetOwner(handler);
+        queue.PushHistoryQueueBeforeDistribute(event);
+        queue.PushHistoryQueueAfterDistribute();
+    }
+    HistoryDumper dumper;
+    queue.Dump(dumper);
+    ASSERT_EQ(dumper.histories.size(), HISTORY_DEPTH);
+    EXPECT_NE(dumper.histories[0].find("task name = HistoryDepth_001"), std::string::npos);
+
+    queue.SetHistoryDepth(0);
+    auto event = InnerEvent::Get(HAS_EVENT_ID);
+    queue.PushHistoryQueueBeforeDistribute(event);
+    queue.PushHistoryQueueAfterDistribute();
+    HistoryDumper disabledDumper;
+    queue.Dump(disabledDumper);
+    EXPECT_TRUE(disabledDumper.histories.empty());
+}
+
+/*
+ * @tc.name: HistoryDepth_002
+ * @tc.desc: dump still shows task names after the name table of the history is full
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerEventQueueTest, HistoryDepth_002, TestSize.Level1)
+{
+    const uint32_t nameNum = EventHistoryRing::MAX_NAME_NUM + HISTORY_DEPTH;
+    const std::string longName(EventHistoryRing::MAX_INLINE_NAME_LEN + HISTORY_DEPTH, 'x');
+    auto runner = EventRunner::Create(false);
+    auto handler = std::make_shared<EventHandler>(runner);
+    EventQueueBase queue(EventLockType::STANDARD);
+    queue.Prepare();
+    queue.SetHistoryDepth(HISTORY_DEPTH);
+    for (uint32_t i = 0; i <= nameNum; ++i) {
+        auto event = InnerEvent::Get([]() {}, (i < nameNum) ? "HistoryName_" + std::to_string(i) : longName);
+        event->SetOwner(handler);
+        queue.PushHistoryQueueBeforeDistribute(event);
+        queue.PushHistoryQueueAfterDistribute();
+    }
+    HistoryDumper dumper;
+    queue.Dump(dumper);
+    ASSERT_EQ(dumper.histories.size(), HISTORY_DEPTH);
+    std::string dumped;
+    for (const auto &history : dumper.histories) {
+        dumped += history;
+    }
+    for (uint32_t i = nameNum - HISTORY_DEPTH + 1; i < nameNum; ++i) {
+        EXPECT_NE(dumped.find("task name = HistoryName_" + std::to_string(i) + ","), std::string::npos);
+    }
+    std::string truncated = "task name = " + longName.substr(0, EventHistoryRing::MAX_INLINE_NAME_LEN) + ",";
+    EXPECT_NE(dumped.find(truncated), std::string::npos);
+}
+
+/*
+ * @tc.name: DumpSnapshot_001
+ * @tc.desc: dump formats at most the configured number of events of each priority, but counts all of them
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerEventQueueTest, DumpSnapshot_001, TestSize.Level1)
+{
+    const uint32_t eventNum = 5;
+    const uint32_t maxDumpEvents = 2;
+    auto runner = EventRunner::Create(false);
+    auto handler = std::make_shared<EventHandler>(runner);
+    EventQueueBase queue(EventLockType::STANDARD);
+    queue.Prepare();
+    for (uint32_t i = 0; i < eventNum; ++i) {
+        auto event = InnerEvent::Get(HAS_EVENT_ID, static_cast<int64_t>(i + 1));
+        event->SetOwner(handler);
+        queue.Insert(event, EventQueue::Priority::LOW);
+    }
+    queue.SetMaxDumpEventsPerPriority(maxDumpEvents);
+    std::string queueInfo;
+    queue.DumpQueueInfo(queueInfo);
+    EXPECT_NE(queueInfo.find("No.2 : Event { "), std::string::npos);
+    EXPECT_NE(queueInfo.find("param = 2"), std::string::npos);
+    EXPECT_EQ(queueInfo.find("No.3 : "), std::string::npos);
+    EXPECT_NE(queueInfo.find("Total size of Low events : 5"), std::string::npos);
+    EXPECT_NE(queueInfo.find("Total event size : 5"), std::string::npos);
+
+    // Compare with the same offset between the clocks, so that the expected text does not depend on timing.
+    DumpTimeFormatter formatter;
+    auto toSystem = [&formatter](const InnerEvent::TimePoint &time) {
+        auto offset = std::chrono::duration_cast<std::chrono::milliseconds>(time - formatter.steadyNow_);
+        return formatter.systemNow_ + offset;
+    };
+    auto ms = std::chrono::time_point_cast<std::chrono::milliseconds>(formatter.systemNow_).time_since_epoch() %
+        std::chrono::seconds(1);
+    // Start at 5ms of the next second, so that milliseconds are padded, and the second changes in the sequence.
+    auto base = formatter.steadyNow_ + (std::chrono::milliseconds(1005) - ms);
+    const std::vector<std::chrono::milliseconds> offsets = {
+        std::chrono::milliseconds(-2000), std::chrono::milliseconds(0), std::chrono::milliseconds(42),
+        std::chrono::milliseconds(994), std::chrono::milliseconds(995), std::chrono::milliseconds(61000),
+        std::chrono::milliseconds(3600000), std::chrono::milliseconds(-1)};
+    for (const auto &offset : offsets) {
+        auto time = base + offset;
+        EXPECT_EQ(formatter.Format(time), InnerEvent::DumpTimeToString(toSystem(time)));
+    }
+    EXPECT_EQ(formatter.Format(formatter.steadyNow_), InnerEvent::DumpTimeToString(formatter.systemNow_));
+}
+
+/*
+ * @tc.name: Coalesce_001
+ * @tc.desc: coalesced events with the same id and priority replace the pending one, and are counted in dump
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerEventQueueTest, Coalesce_001, TestSize.Level1)
+{
+    auto runner = EventRunner::Create(false);
+    auto handler = std::make_shared<EventHandler>(runner);
+    const int64_t eventNum = 3;
+    for (int64_t i = 1; i <= eventNum; ++i) {
+        auto event = InnerEvent::Get(HAS_EVENT_ID, i);
+        EXPECT_TRUE(handler->SendCoalescedEvent(event));
+        EXPECT_EQ(event, nullptr);
+    }
+    auto highEvent = InnerEvent::Get(HAS_EVENT_ID, eventNum + 1);
+    EXPECT_TRUE(handler->SendCoalescedEvent(highEvent, CoalescePolicy::REPLACE_LATEST, 0,
+        EventQueue::Priority::HIGH));
+    auto task = InnerEvent::Get([]() {});
+    EXPECT_FALSE(handler->SendCoalescedEvent(task));
+
+    std::string queueInfo;
+    runner->GetEventQueue()->DumpQueueInfo(queueInfo);
+    EXPECT_NE(queueInfo.find("Total size of Low events : 1"), std::string::npos);
+    EXPECT_NE(queueInfo.find("Total size of High events : 1"), std::string::npos);
+    EXPECT_NE(queueInfo.find("param = 3"), std::string::npos);
+    EXPECT_EQ(queueInfo.find("param = 1,"), std::string::npos);
+    CoalesceDumper dumper;
+    runner->GetEventQueue()->Dump(dumper);
+    EXPECT_NE(dumper.counts.find("replaced = 2, dropped = 0"), std::string::npos);
+
+    // A removed event is no longer found by later sends.
+    handler->RemoveEvent(HAS_EVENT_ID);
+    auto event = InnerEvent::Get(HAS_EVENT_ID, eventNum + 2);
+    EXPECT_TRUE(handler->SendCoalescedEvent(event));
+    EXPECT_TRUE(handler->HasInnerEvent(HAS_EVENT_ID));
+    handler->RemoveAllEvents();
+}
+
+/*
+ * @tc.name: Coalesce_002
+ * @tc.desc: keep-first drops the later event, and only events and tasks of the same kind are merged
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerEventQueueTest, Coalesce_002, TestSize.Level1)
+{
+    const uint64_t key = 7;
+    auto runner = EventRunner::Create(true);
+    auto handler = std::make_shared<EventHandler>(runner);
+    auto otherHandler = std::make_shared<EventHandler>(runner);
+    std::vector<int> order;
+    const int64_t delayTime = 50;
+    EXPECT_TRUE(handler->PostCoalescedTask([&order]() { order.push_back(1); }, key, CoalescePolicy::KEEP_FIRST,
+        delayTime));
+    EXPECT_TRUE(handler->PostCoalescedTask([&order]() { order.push_back(2); }, key, CoalescePolicy::KEEP_FIRST));
+    EXPECT_TRUE(otherHandler->PostCoalescedTask([&order]() { order.push_back(3); }, key,
+        CoalescePolicy::KEEP_FIRST, delayTime));
+    auto event = InnerEvent::Get(HAS_EVENT_ID);
+    EXPECT_TRUE(handler->SendCoalescedEvent(event, key));
+
+    CoalesceDumper dumper;
+    runner->GetEventQueue()->Dump(dumper);
+    EXPECT_NE(dumper.counts.find("replaced = 0, dropped = 1"), std::string::npos);
+    usleep(delayTime * 2 * 1000);
+    EXPECT_TRUE(handler->PostSyncTask([]() {}));
+    EXPECT_EQ(order, std::vector<int>({1, 3}));
+    runner->Stop();
+}
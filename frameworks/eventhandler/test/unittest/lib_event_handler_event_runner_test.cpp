@@ -15,12 +15,19 @@
 
 #include <atomic>
 #include <cerrno>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
 #include <thread>
+#include <vector>
 
+#include <dirent.h>
+#include <fcntl.h>
 #include <sys/prctl.h>
 
 #include "event_handler.h"
 #include "event_runner.h"
+#include "event_runner_pool.h"
 
 #include <gtest/gtest.h>
 
@@ -398,4 +405,440 @@ HWTEST_F(LibEventHandlerEventRunnerTest, SetTimeOut001, TestSize.Level1)
     int64_t reTimeout = runner->GetTimeout();
     EXPECT_EQ(reTimeout, timeout);
     EXPECT_EQ(nullptr, EventRunner::distributeCallback_);
-}
\ No newline at end of file
+}
+
+/*
+ * @tc.name: WaitStrategy001
+ * @tc.desc: runners waiting with each strategy run tasks posted from other threads and delayed tasks
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerEventRunnerTest, WaitStrategy001, TestSize.Level1)
+{
+    const int64_t delayTime = 10;
+    const int32_t taskNum = 1000;
+    for (auto strategy : {WaitStrategy::BLOCK, WaitStrategy::SPIN_THEN_PARK, WaitStrategy::FUTEX}) {
+        auto runner = EventRunner::Create("WaitStrategy001", strategy);
+        auto handler = std::make_shared<EventHandler>(runner);
+        std::atomic<int32_t> count {0};
+        std::thread producer([&handler, &count]() {
+            for (int32_t i = 0; i < taskNum; ++i) {
+                handler->PostTask([&count]() { count++; });
+            }
+        });
+        producer.join();
+        auto start = InnerEvent::Clock::now();
+        std::atomic<bool> delayed {false};
+        handler->PostTask([&delayed]() { delayed = true; }, delayTime);
+        EXPECT_TRUE(handler->PostSyncTask([]() {}));
+        EXPECT_EQ(count.load(), taskNum);
+        while (!delayed.load()) {
+            usleep(1000);
+        }
+        EXPECT_GE(InnerEvent::Clock::now() - start, std::chrono::milliseconds(delayTime));
+        runner->Stop();
+    }
+}
+
+/*
+ * @tc.name: WaitStrategy002
+ * @tc.desc: strategies parking on a futex are rejected by runners with several threads
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerEventRunnerTest, WaitStrategy002, TestSize.Level1)
+{
+    auto runner = EventRunner::CreateConcurrent("WaitStrategy002", 2);
+    ASSERT_NE(runner, nullptr);
+    auto queue = runner->GetEventQueue();
+    EXPECT_FALSE(queue->SetWaitStrategy(WaitStrategy::SPIN_THEN_PARK));
+    EXPECT_FALSE(queue->SetWaitStrategy(WaitStrategy::FUTEX));
+    EXPECT_EQ(queue->waitStrategy_, WaitStrategy::BLOCK);
+    EXPECT_TRUE(queue->SetWaitStrategy(WaitStrategy::BLOCK));
+    auto handler = std::make_shared<EventHandler>(runner);
+    EXPECT_TRUE(handler->PostSyncTask([]() {}));
+    runner->Stop();
+
+    auto single = EventRunner::Create(false);
+    EXPECT_TRUE(single->GetEventQueue()->SetWaitStrategy(WaitStrategy::FUTEX));
+    EXPECT_EQ(single->GetEventQueue()->waitStrategy_, WaitStrategy::FUTEX);
+}
+
+static int32_t CountThreads()
+{
+    DIR *dir = opendir("/proc/self/task");
+    if (dir == nullptr) {
+        return -1;
+    }
+    int32_t count = 0;
+    for (struct dirent *entry = readdir(dir); entry != nullptr; entry = readdir(dir)) {
+        if (entry->d_name[0] != '.') {
+            ++count;
+        }
+    }
+    closedir(dir);
+    return count;
+}
+
+/*
+ * @tc.name: PoolMode001
+ * @tc.desc: runners in the pool run their tasks in order and as the current runner, without a thread of their own
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerEventRunnerTest, PoolMode001, TestSize.Level1)
+{
+    const int32_t runnerNum = 32;
+    const int32_t taskNum = 100;
+    const int64_t delayTime = 10;
+    auto first = EventRunner::Create("PoolMode001", ThreadMode::POOL);
+    int32_t threadNum = CountThreads();
+    std::vector<std::shared_ptr<EventRunner>> runners = {first};
+    std::vector<std::shared_ptr<EventHandler>> handlers;
+    for (int32_t i = 1; i < runnerNum; ++i) {
+        runners.push_back(EventRunner::Create(true, ThreadMode::POOL));
+    }
+    // Threads of runners stopped by former tests may still be reclaimed meanwhile, so only check no thread is added.
+    EXPECT_LE(CountThreads(), threadNum);
+
+    std::vector<std::vector<int32_t>> results(runnerNum);
+    std::atomic<int32_t> notCurrent {0};
+    std::atomic<int32_t> delayedNum {0};
+    auto start = InnerEvent::Clock::now();
+    for (int32_t i = 0; i < runnerNum; ++i) {
+        auto handler = std::make_shared<EventHandler>(runners[i]);
+        handlers.push_back(handler);
+        handler->PostTask([&delayedNum]() { delayedNum++; }, delayTime);
+        for (int32_t j = 0; j < taskNum; ++j) {
+            handler->PostTask([&results, &notCurrent, runner = runners[i], i, j]() {
+                if ((EventRunner::Current() != runner) || !runner->IsCurrentRunnerThread()) {
+                    notCurrent++;
+                }
+                results[i].push_back(j);
+            });
+        }
+    }
+    for (int32_t i = 0; i < runnerNum; ++i) {
+        EXPECT_TRUE(handlers[i]->PostSyncTask([]() {}));
+        EXPECT_EQ(results[i].size(), static_cast<size_t>(taskNum));
+        for (int32_t j = 0; j < static_cast<int32_t>(results[i].size()); ++j) {
+            EXPECT_EQ(results[i][j], j);
+        }
+    }
+    EXPECT_EQ(notCurrent.load(), 0);
+    while (delayedNum.load() < runnerNum) {
+        usleep(1000);
+    }
+    EXPECT_GE(InnerEvent::Clock::now() - start, std::chrono::milliseconds(delayTime));
+    EXPECT_EQ(EventRunner::Current(), nullptr);
+}
+
+/*
+ * @tc.name: PoolMode002
+ * @tc.desc: runners in the pool are deposited, do not listen file descriptors, do not take thread ids of workers
+ *           and release pending tasks at last
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerEventRunnerTest, PoolMode002, TestSize.Level1)
+{
+    auto runner = EventRunner::Create(true, ThreadMode::POOL);
+    auto handler = std::make_shared<EventHandler>(runner);
+    EXPECT_EQ(runner->Run(), EVENT_HANDLER_ERR_RUNNER_NO_PERMIT);
+    EXPECT_EQ(runner->Stop(), EVENT_HANDLER_ERR_RUNNER_NO_PERMIT);
+
+    int32_t fds[2] = {-1, -1};
+    ASSERT_EQ(pipe2(fds, O_NONBLOCK), 0);
+    class Listener final : public FileDescriptorListener {};
+    EXPECT_NE(handler->AddFileDescriptorListener(fds[0], FILE_DESCRIPTOR_INPUT_EVENT,
+        std::make_shared<Listener>(), "PoolMode002"), ERR_OK);
+    close(fds[0]);
+    close(fds[1]);
+
+    std::atomic<bool> called {false};
+    EXPECT_TRUE(handler->PostSyncTask([&called, runner]() {
+        // Slices run on any worker, so the runner never takes the ids of a worker.
+        called = runner->IsCurrentRunnerThread() && (runner->GetThreadId() == 0) &&
+            (runner->GetKernelThreadId() == 0);
+    }));
+    EXPECT_TRUE(called.load());
+    EXPECT_FALSE(runner->IsCurrentRunnerThread());
+    EXPECT_EQ(runner->GetThreadId(), 0u);
+
+    const int64_t farDelayTime = 100000;
+    auto resource = std::make_shared<int32_t>(0);
+    std::weak_ptr<int32_t> weakResource = resource;
+    handler->PostTask([resource]() {}, farDelayTime);
+    resource.reset();
+    EXPECT_FALSE(weakResource.expired());
+    handler.reset();
+    runner.reset();
+    // The pool may still hold the runner for a moment, if it is woken up by stopping.
+    const int32_t maxRetryCount = 1000;
+    for (int32_t i = 0; (i < maxRetryCount) && !weakResource.expired(); ++i) {
+        usleep(1000);
+    }
+    EXPECT_TRUE(weakResource.expired());
+}
+
+/*
+ * @tc.name: PoolMode003
+ * @tc.desc: runners in the pool sending sync tasks to each other in a chain longer than the workers do not hang
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerEventRunnerTest, PoolMode003, TestSize.Level1)
+{
+    const size_t chainNum = EventRunnerPool::GetInstance().GetWorkerNum() + 2;
+    std::vector<std::shared_ptr<EventHandler>> handlers;
+    for (size_t i = 0; i < chainNum; ++i) {
+        handlers.push_back(std::make_shared<EventHandler>(EventRunner::Create(true, ThreadMode::POOL)));
+    }
+    std::atomic<size_t> reached {0};
+    std::function<void(size_t)> step = [&handlers, &reached, &step](size_t index) {
+        ++reached;
+        if (index + 1 < handlers.size()) {
+            EXPECT_TRUE(handlers[index + 1]->PostSyncTask([&step, index]() { step(index + 1); }));
+        }
+    };
+    EXPECT_TRUE(handlers[0]->PostSyncTask([&step]() { step(0); }));
+    EXPECT_EQ(reached.load(), chainNum);
+}
+
+/*
+ * @tc.name: ConcurrentMode001
+ * @tc.desc: threads of a concurrent runner run tasks of one handler one by one in order, and of different handlers
+ *           in parallel
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerEventRunnerTest, ConcurrentMode001, TestSize.Level1)
+{
+    const uint32_t consumerNum = 4;
+    const int32_t handlerNum = 16;
+    const int32_t taskNum = 200;
+    auto runner = EventRunner::CreateConcurrent("ConcurrentMode001", consumerNum);
+    ASSERT_NE(runner, nullptr);
+    std::vector<std::shared_ptr<EventHandler>> handlers;
+    std::vector<std::vector<int32_t>> results(handlerNum);
+    std::vector<std::atomic<bool>> running(handlerNum);
+    std::atomic<int32_t> overlapped {0};
+    std::atomic<int32_t> notCurrent {0};
+    for (int32_t i = 0; i < handlerNum; ++i) {
+        auto handler = std::make_shared<EventHandler>(runner);
+        handlers.push_back(handler);
+        for (int32_t j = 0; j < taskNum; ++j) {
+            handler->PostTask([&results, &running, &overlapped, &notCurrent, runner, i, j]() {
+                if (running[i].exchange(true)) {
+                    overlapped++;
+                }
+                if ((EventRunner::Current() != runner) || !runner->IsCurrentRunnerThread()) {
+                    notCurrent++;
+                }
+                results[i].push_back(j);
+                running[i].store(false);
+            });
+        }
+    }
+
+    // The first task blocks until a task of another handler runs, which needs another thread.
+    std::mutex lock;
+    std::condition_variable condition;
+    bool released = false;
+    bool waited = false;
+    handlers[0]->PostTask([&lock, &condition, &released, &waited]() {
+        std::unique_lock<std::mutex> guard(lock);
+        waited = condition.wait_for(guard, std::chrono::seconds(1), [&released]() { return released; });
+    });
+    handlers[1]->PostTask([&lock, &condition, &released]() {
+        std::lock_guard<std::mutex> guard(lock);
+        released = true;
+        condition.notify_all();
+    });
+
+    for (int32_t i = 0; i < handlerNum; ++i) {
+        EXPECT_TRUE(handlers[i]->PostSyncTask([]() {}));
+        ASSERT_EQ(results[i].size(), static_cast<size_t>(taskNum));
+        for (int32_t j = 0; j < taskNum; ++j) {
+            EXPECT_EQ(results[i][j], j);
+        }
+    }
+    EXPECT_EQ(overlapped.load(), 0);
+    EXPECT_EQ(notCurrent.load(), 0);
+    EXPECT_TRUE(waited);
+    EXPECT_FALSE(runner->IsCurrentRunnerThread());
+}
+
+/*
+ * @tc.name: ConcurrentMode002
+ * @tc.desc: a concurrent runner checks its thread number, does not listen file descriptors, and wakes up for
+ *           delayed tasks while other tasks wait for their busy handler
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerEventRunnerTest, ConcurrentMode002, TestSize.Level1)
+{
+    EXPECT_EQ(EventRunner::CreateConcurrent("ConcurrentMode002", 0), nullptr);
+    EXPECT_EQ(EventRunner::CreateConcurrent("ConcurrentMode002", EventRunner::MAX_CONSUMER_NUM + 1), nullptr);
+    auto runner = EventRunner::CreateConcurrent("ConcurrentMode002", 2);
+    ASSERT_NE(runner, nullptr);
+    EXPECT_EQ(runner->Run(), EVENT_HANDLER_ERR_RUNNER_NO_PERMIT);
+    auto busy = std::make_shared<EventHandler>(runner);
+    auto other = std::make_shared<EventHandler>(runner);
+
+    int32_t fds[2] = {-1, -1};
+    ASSERT_EQ(pipe2(fds, O_NONBLOCK), 0);
+    class Listener final : public FileDescriptorListener {};
+    EXPECT_EQ(busy->AddFileDescriptorListener(fds[0], FILE_DESCRIPTOR_INPUT_EVENT,
+        std::make_shared<Listener>(), "ConcurrentMode002"), EVENT_HANDLER_ERR_FD_NOT_SUPPORT);
+    close(fds[0]);
+    close(fds[1]);
+
+    const auto busyTime = std::chrono::milliseconds(200);
+    const int64_t delayTime = 10;
+    auto start = InnerEvent::Clock::now();
+    std::atomic<int64_t> delayedCost {0};
+    busy->PostTask([&busyTime]() { std::this_thread::sleep_for(busyTime); });
+    busy->PostTask([]() {});
+    other->PostTask([&delayedCost, start]() {
+        delayedCost = std::chrono::duration_cast<std::chrono::milliseconds>(InnerEvent::Clock::now() - start).count();
+    }, delayTime);
+
+    EXPECT_TRUE(busy->PostSyncTask([]() {}));
+    EXPECT_GE(delayedCost.load(), delayTime);
+    EXPECT_LT(delayedCost.load(), busyTime.count());
+}
+
+/*
+ * @tc.name: ConcurrentMode003
+ * @tc.desc: sync tasks sent to a handler from other handlers of a concurrent runner never overlap with its other
+ *           tasks, while sync tasks sent to the running handler itself run at once
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerEventRunnerTest, ConcurrentMode003, TestSize.Level1)
+{
+    const uint32_t consumerNum = 4;
+    const int32_t senderNum = 3;
+    const int32_t taskNum = 50;
+    const auto taskTime = std::chrono::microseconds(100);
+    auto runner = EventRunner::CreateConcurrent("ConcurrentMode003", consumerNum);
+    ASSERT_NE(runner, nullptr);
+    auto target = std::make_shared<EventHandler>(runner);
+    std::atomic<bool> running {false};
+    std::atomic<int32_t> overlapped {0};
+    std::atomic<int32_t> notTarget {0};
+    std::atomic<int32_t> called {0};
+    auto task = [&target, &running, &overlapped, &notTarget, &called, &taskTime]() {
+        if (running.exchange(true)) {
+            overlapped++;
+        }
+        if (EventHandler::Current() != target) {
+            notTarget++;
+        }
+        std::this_thread::sleep_for(taskTime);
+        called++;
+        running.store(false);
+    };
+
+    std::vector<std::shared_ptr<EventHandler>> senders;
+    std::atomic<int32_t> failed {0};
+    for (int32_t i = 0; i < senderNum; ++i) {
+        auto sender = std::make_shared<EventHandler>(runner);
+        senders.push_back(sender);
+        for (int32_t j = 0; j < taskNum; ++j) {
+            sender->PostTask([&target, &task, &failed]() {
+                if (!target->PostSyncTask(task)) {
+                    failed++;
+                }
+            });
+            target->PostTask(task);
+        }
+    }
+    std::atomic<bool> ranInline {false};
+    target->PostTask([&target, &ranInline]() {
+        auto threadId = std::this_thread::get_id();
+        target->PostSyncTask([&ranInline, threadId]() { ranInline = (std::this_thread::get_id() == threadId); });
+    });
+
+    for (const auto &sender : senders) {
+        EXPECT_TRUE(sender->PostSyncTask([]() {}));
+    }
+    EXPECT_TRUE(target->PostSyncTask([]() {}));
+    EXPECT_EQ(failed.load(), 0);
+    EXPECT_EQ(called.load(), senderNum * taskNum * 2);
+    EXPECT_EQ(overlapped.load(), 0);
+    EXPECT_EQ(notTarget.load(), 0);
+    EXPECT_TRUE(ranInline.load());
+}
+
+/*
+ * @tc.name: ConcurrentMode004
+ * @tc.desc: sync tasks sent to idle handlers while all threads of a concurrent runner are sending them run on the
+ *           sending threads, instead of waiting for a free thread
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerEventRunnerTest, ConcurrentMode004, TestSize.Level1)
+{
+    const uint32_t consumerNum = 3;
+    const auto gatherTime = std::chrono::seconds(1);
+    auto runner = EventRunner::CreateConcurrent("ConcurrentMode004", consumerNum);
+    ASSERT_NE(runner, nullptr);
+    std::atomic<uint32_t> gathered {0};
+    std::atomic<uint32_t> ranInline {0};
+    std::atomic<uint32_t> restored {0};
+    std::vector<std::shared_ptr<EventHandler>> senders;
+    std::vector<std::shared_ptr<EventHandler>> targets;
+    for (uint32_t i = 0; i < consumerNum; ++i) {
+        senders.push_back(std::make_shared<EventHandler>(runner));
+        targets.push_back(std::make_shared<EventHandler>(runner));
+    }
+    for (uint32_t i = 0; i < consumerNum; ++i) {
+        senders[i]->PostTask([&, i]() {
+            // Wait until every thread runs a sender, so that no thread is free for the targets.
+            ++gathered;
+            auto deadline = InnerEvent::Clock::now() + gatherTime;
+            while ((gathered.load() < consumerNum) && (InnerEvent::Clock::now() < deadline)) {
+                std::this_thread::yield();
+            }
+            auto threadId = std::this_thread::get_id();
+            EXPECT_TRUE(targets[i]->PostSyncTask([&, i, threadId]() {
+                if ((std::this_thread::get_id() == threadId) && (EventHandler::Current() == targets[i])) {
+                    ++ranInline;
+                }
+            }));
+            if (EventHandler::Current() == senders[i]) {
+                ++restored;
+            }
+        });
+    }
+    for (uint32_t i = 0; i < consumerNum; ++i) {
+        EXPECT_TRUE(senders[i]->PostSyncTask([]() {}));
+    }
+    EXPECT_EQ(gathered.load(), consumerNum);
+    EXPECT_EQ(ranInline.load(), consumerNum);
+    EXPECT_EQ(restored.load(), consumerNum);
+}
+
+/*
+ * @tc.name: ConcurrentMode005
+ * @tc.desc: sync tasks sent back and forth between handlers of a concurrent runner with a single thread run at once
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerEventRunnerTest, ConcurrentMode005, TestSize.Level1)
+{
+    auto runner = EventRunner::CreateConcurrent("ConcurrentMode005", 1);
+    ASSERT_NE(runner, nullptr);
+    auto first = std::make_shared<EventHandler>(runner);
+    auto second = std::make_shared<EventHandler>(runner);
+    std::atomic<int32_t> depth {0};
+    first->PostTask([&first, &second, &depth]() {
+        EXPECT_TRUE(second->PostSyncTask([&first, &second, &depth]() {
+            EXPECT_TRUE(first->PostSyncTask([&first, &depth]() {
+                EXPECT_EQ(EventHandler::Current(), first);
+                depth = 2;
+            }));
+            EXPECT_EQ(EventHandler::Current(), second);
+            EXPECT_TRUE(second->CanDistributeOnCurrentThread());
+            EXPECT_TRUE(first->CanDistributeOnCurrentThread());
+        }));
+        EXPECT_EQ(EventHandler::Current(), first);
+        EXPECT_FALSE(second->CanDistributeOnCurrentThread());
+    });
+    EXPECT_TRUE(first->PostSyncTask([]() {}));
+    EXPECT_EQ(depth.load(), 2);
+    // Both handlers are released, so their tasks still run.
+    EXPECT_TRUE(second->PostSyncTask([]() {}));
+}
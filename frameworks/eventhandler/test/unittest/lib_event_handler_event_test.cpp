@@ -362,7 +362,7 @@ HWTEST_F(LibEventHandlerEventTest, GetEventInfo006, TestSize.Level1)
 
 /*
  * @tc.name: DrainPool001
- * @tc.desc: get event from pool when the pool is full, then get event from new memory area
+ * @tc.desc: get event from pool when the pool is full, then check the latest recycled event is reused
  * @tc.type: FUNC
  */
 HWTEST_F(LibEventHandlerEventTest, DrainPool001, TestSize.Level1)
@@ -389,7 +389,7 @@ HWTEST_F(LibEventHandlerEventTest, DrainPool001, TestSize.Level1)
     /**
      * @tc.steps: step3. get the event address of the event we get after the event pool is empty,
      *            then reset all the event we get from pool before and get event, compare the two events address.
-     * @tc.expected: step3. the two event address are not the same.
+     * @tc.expected: step3. the two event address are the same, as the latest recycled event is reused first.
      */
     auto firstAddr = event.get();
     event.reset(nullptr);
@@ -399,7 +399,7 @@ HWTEST_F(LibEventHandlerEventTest, DrainPool001, TestSize.Level1)
     auto secondAddr = event.get();
     event.reset(nullptr);
 
-    EXPECT_NE(firstAddr, secondAddr);
+    EXPECT_EQ(firstAddr, secondAddr);
 }
 
 /*
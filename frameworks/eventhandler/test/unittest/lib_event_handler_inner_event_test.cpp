@@ -13,6 +13,9 @@
  * limitations under the License.
  */
 
+#include <thread>
+#include <vector>
+
 #include <gtest/gtest.h>
 #include "inner_event.h"
 
@@ -89,3 +92,201 @@ HWTEST_F(LibEventHandlerInnerEventTest, GetEventPointer001, TestSize.Level1)
     // drop event, execute destructor function
     EXPECT_TRUE(callbackCalled);
 }
+
+/*
+ * @tc.name: EventPool001
+ * @tc.desc: Recycled event is served from the pool and all of its content is reset
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerInnerEventTest, EventPool001, TestSize.Level1)
+{
+    auto object = std::make_shared<int>(1);
+    InnerEvent::Pointer event = InnerEvent::Get([object]() {}, "EventPool001");
+    EXPECT_EQ(2, object.use_count());
+    event.reset();
+    // captures of the task are released once the event is recycled
+    EXPECT_EQ(1, object.use_count());
+
+    auto stats = InnerEvent::GetPoolStats();
+    EXPECT_GT(stats.cachedCount, 0u);
+    EXPECT_EQ(stats.cachedCount * sizeof(InnerEvent), stats.bytesHeld);
+
+    event = InnerEvent::Get(1, 2);
+    auto newStats = InnerEvent::GetPoolStats();
+    EXPECT_EQ(stats.hitCount + 1, newStats.hitCount);
+    EXPECT_EQ(stats.missCount, newStats.missCount);
+    EXPECT_FALSE(event->HasTask());
+    EXPECT_EQ(1u, event->GetInnerEventId());
+    EXPECT_EQ(2, event->GetParam());
+    EXPECT_TRUE(event->GetTaskName().empty());
+}
+
+/*
+ * @tc.name: EventPool002
+ * @tc.desc: Invoke SetPoolWatermarks with invalid watermarks
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerInnerEventTest, EventPool002, TestSize.Level1)
+{
+    EXPECT_FALSE(InnerEvent::SetPoolWatermarks(1, 2));
+    EXPECT_TRUE(InnerEvent::SetPoolWatermarks(512, 64));
+}
+
+/*
+ * @tc.name: EventPool003
+ * @tc.desc: Trim the pool to its low watermark
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerInnerEventTest, EventPool003, TestSize.Level1)
+{
+    const uint32_t highWatermark = 16;
+    const uint32_t lowWatermark = 4;
+    EXPECT_TRUE(InnerEvent::SetPoolWatermarks(highWatermark, lowWatermark));
+    std::vector<InnerEvent::Pointer> events;
+    for (uint32_t i = 0; i < highWatermark * 4; ++i) {
+        events.emplace_back(InnerEvent::Get(i));
+    }
+    events.clear();
+    InnerEvent::TrimPool();
+    EXPECT_LE(InnerEvent::GetPoolStats().cachedCount, lowWatermark);
+    EXPECT_TRUE(InnerEvent::SetPoolWatermarks(512, 64));
+}
+
+/*
+ * @tc.name: EventPool004
+ * @tc.desc: Events recycled by an exited thread are still available to other threads
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerInnerEventTest, EventPool004, TestSize.Level1)
+{
+    InnerEvent::TrimPool();
+    std::thread worker([]() {
+        auto event = InnerEvent::Get(1);
+        event.reset();
+    });
+    worker.join();
+    auto stats = InnerEvent::GetPoolStats();
+    auto event = InnerEvent::Get(1);
+    EXPECT_EQ(stats.hitCount + 1, InnerEvent::GetPoolStats().hitCount);
+}
+
+/*
+ * @tc.name: Caller001
+ * @tc.desc: Caller keeps pointers of the call site and formats them only when asked
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerInnerEventTest, Caller001, TestSize.Level1)
+{
+    Caller caller("/a/b/file.cpp", 10, "Func");
+    EXPECT_EQ("[file.cpp(Func:10)]", caller.ToString());
+    auto event = InnerEvent::Get(1, 0, caller);
+    EXPECT_EQ(caller.file_, event->GetCaller().file_);
+    EXPECT_EQ(caller.func_, event->GetCaller().func_);
+
+    std::string dfxName("dfx");
+    const char *interned = Caller::Intern(dfxName);
+    dfxName.clear();
+    EXPECT_STREQ("dfx", interned);
+    EXPECT_EQ(interned, Caller::Intern("dfx"));
+    caller.dfxName_ = interned;
+    EXPECT_EQ("[file.cpp(Func:10dfx)]", caller.ToString());
+    caller.ClearCaller();
+    EXPECT_EQ("[ ]", caller.ToString());
+}
+
+/*
+ * @tc.name: EventUniqueId001
+ * @tc.desc: Unique ids of events are increasing integers, and are cleared when events are recycled
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerInnerEventTest, EventUniqueId001, TestSize.Level1)
+{
+    auto first = InnerEvent::Get(1);
+    auto second = InnerEvent::Get(2);
+    EXPECT_EQ(0u, first->GetEventUniqueId());
+    first->SetEventUniqueId();
+    second->SetEventUniqueId();
+    EXPECT_NE(0u, first->GetEventUniqueId());
+    EXPECT_LT(first->GetEventUniqueId(), second->GetEventUniqueId());
+    first.reset();
+    auto recycled = InnerEvent::Get(1);
+    EXPECT_EQ(0u, recycled->GetEventUniqueId());
+}
+
+/*
+ * @tc.name: EmplacePayload001
+ * @tc.desc: Payloads constructed by Emplace are only returned for their own type
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerInnerEventTest, EmplacePayload001, TestSize.Level1)
+{
+    struct Point {
+        int32_t x;
+        int32_t y;
+    };
+    struct OtherPoint {
+        int32_t x;
+        int32_t y;
+    };
+    int line = __LINE__ + 1;
+    auto event = InnerEvent::Emplace<Point>(1, Point { 3, 4 });
+    ASSERT_NE(nullptr, event);
+    EXPECT_EQ(1u, event->GetInnerEventId());
+    // Caller is where 'Emplace' is called.
+    EXPECT_STREQ(__FILE__, event->GetCaller().file_);
+    EXPECT_EQ(line, event->GetCaller().line_);
+    ASSERT_NE(nullptr, event->GetPayload<Point>());
+    EXPECT_EQ(3, event->GetPayload<Point>()->x);
+    EXPECT_EQ(4, event->GetPayload<Point>()->y);
+    EXPECT_EQ(nullptr, event->GetPayload<OtherPoint>());
+    EXPECT_EQ(nullptr, event->GetPayload<int64_t>());
+    EXPECT_EQ(nullptr, InnerEvent::Get(1)->GetPayload<Point>());
+}
+
+/*
+ * @tc.name: EmplacePayload002
+ * @tc.desc: Large or non trivially copyable payloads are kept by pointer, and released with the event
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerInnerEventTest, EmplacePayload002, TestSize.Level1)
+{
+    auto object = std::make_shared<int>(0);
+    struct Holder {
+        std::shared_ptr<int> object;
+    };
+    auto event = InnerEvent::Emplace<Holder>("holder", Holder { object });
+    ASSERT_NE(nullptr, event->GetPayload<Holder>());
+    EXPECT_EQ(object, event->GetPayload<Holder>()->object);
+    EXPECT_EQ(2, object.use_count());
+    event.reset();
+    EXPECT_EQ(1, object.use_count());
+
+    struct Large {
+        int64_t values[8];
+    };
+    auto largeEvent = InnerEvent::Emplace<Large>(2, Large { { 1, 2, 3, 4, 5, 6, 7, 8 } });
+    ASSERT_NE(nullptr, largeEvent->GetPayload<Large>());
+    EXPECT_EQ(8, largeEvent->GetPayload<Large>()->values[7]);
+}
+
+/*
+ * @tc.name: PayloadAllocation001
+ * @tc.desc: A small trivially copyable payload is kept inside the event without allocation
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerInnerEventTest, PayloadAllocation001, TestSize.Level1)
+{
+    struct Coordinate {
+        float x;
+        float y;
+        int64_t timestamp;
+    };
+    auto event = InnerEvent::Emplace<Coordinate>(1, Coordinate { 1.0f, 2.0f, 3 });
+    const Coordinate *payload = event->GetPayload<Coordinate>();
+    ASSERT_NE(nullptr, payload);
+    EXPECT_EQ(3, payload->timestamp);
+    auto begin = reinterpret_cast<const uint8_t *>(event.get());
+    auto address = reinterpret_cast<const uint8_t *>(payload);
+    EXPECT_TRUE((address >= begin) && (address + sizeof(Coordinate) <= begin + sizeof(InnerEvent)));
+    EXPECT_EQ(nullptr, event->smartPtr_);
+}
@@ -0,0 +1,400 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <list>
+#include <random>
+#include <vector>
+
+#include "event_handler.h"
+#include "inner_event.h"
+#include "pending_event_store.h"
+
+using namespace testing::ext;
+using namespace OHOS::AppExecFwk;
+
+namespace {
+const uint32_t RANDOM_EVENT_NUM = 2000;
+const uint32_t RANDOM_SEED = 20260101;
+const int64_t MAX_RANDOM_DELAY_MS = 50;
+const uint32_t RANDOM_OWNER_NUM = 8;
+const uint32_t RANDOM_ID_NUM = 4;
+const uint32_t RANDOM_ROUND_NUM = 200;
+const uint64_t OWNER_A = 1;
+const uint64_t OWNER_B = 2;
+const uint64_t OWNER_C = 3;
+
+InnerEvent::Pointer CreateEvent(uint32_t id, const InnerEvent::TimePoint &handleTime)
+{
+    auto event = InnerEvent::Get(id);
+    event->SetHandleTime(handleTime);
+    return event;
+}
+
+InnerEvent::Pointer CreateOwnedEvent(uint32_t id, const InnerEvent::TimePoint &handleTime, uint64_t ownerId,
+    int64_t param = 0)
+{
+    auto event = InnerEvent::Get(id, param);
+    event->SetHandleTime(handleTime);
+    event->SetOwnerId(ownerId);
+    return event;
+}
+
+std::vector<uint32_t> CollectIds(const PendingEventStore &store)
+{
+    std::vector<uint32_t> ids;
+    store.ForEach([&ids](const InnerEvent::Pointer &event) { ids.push_back(event->GetInnerEventId()); });
+    return ids;
+}
+
+std::vector<uint32_t> PopAllIds(PendingEventStore &store)
+{
+    std::vector<uint32_t> ids;
+    while (!store.Empty()) {
+        ids.push_back(store.PopFront()->GetInnerEventId());
+    }
+    return ids;
+}
+
+/*
+ * Insert the same random sequence of events into both stores.
+ */
+void FillRandomly(PendingEventStore &list, PendingEventStore &heap, uint32_t count)
+{
+    std::mt19937 random(RANDOM_SEED);
+    std::uniform_int_distribution<int64_t> delay(0, MAX_RANDOM_DELAY_MS);
+    std::uniform_int_distribution<int32_t> percent(0, 99);
+    auto base = InnerEvent::Clock::now();
+    for (uint32_t id = 0; id < count; ++id) {
+        auto handleTime = base + std::chrono::milliseconds(delay(random));
+        EventInsertType insertType = (percent(random) < 5) ? EventInsertType::AT_FRONT : EventInsertType::AT_END;
+        auto first = CreateEvent(id, handleTime);
+        auto second = CreateEvent(id, handleTime);
+        list.Insert(first, insertType);
+        heap.Insert(second, insertType);
+    }
+}
+
+bool MatchAll(InnerEvent &)
+{
+    return true;
+}
+}  // unnamed namespace
+
+class LibEventHandlerPendingEventStoreTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+void LibEventHandlerPendingEventStoreTest::SetUpTestCase(void)
+{}
+
+void LibEventHandlerPendingEventStoreTest::TearDownTestCase(void)
+{}
+
+void LibEventHandlerPendingEventStoreTest::SetUp(void)
+{}
+
+void LibEventHandlerPendingEventStoreTest::TearDown(void)
+{}
+
+/*
+ * @tc.name: PendingEventStore001
+ * @tc.desc: Events with the same handle time keep insertion order, events inserted at front go first
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerPendingEventStoreTest, PendingEventStore001, TestSize.Level1)
+{
+    for (auto type : {PendingEventStore::Type::LIST, PendingEventStore::Type::HEAP}) {
+        auto store = PendingEventStore::Create(type);
+        auto now = InnerEvent::Clock::now();
+        auto later = now + std::chrono::milliseconds(10);
+        auto event = CreateEvent(1, later);
+        store->Insert(event, EventInsertType::AT_END);
+        event = CreateEvent(2, now);
+        store->Insert(event, EventInsertType::AT_END);
+        event = CreateEvent(3, now);
+        store->Insert(event, EventInsertType::AT_END);
+        event = CreateEvent(4, later);
+        store->Insert(event, EventInsertType::AT_FRONT);
+        event = CreateEvent(5, later);
+        store->Insert(event, EventInsertType::AT_END);
+
+        EXPECT_EQ(store->Size(), 5);
+        EXPECT_EQ(store->Front()->GetInnerEventId(), 4u);
+        std::vector<uint32_t> expected = {4, 2, 3, 1, 5};
+        EXPECT_EQ(CollectIds(*store), expected);
+        EXPECT_EQ(PopAllIds(*store), expected);
+        EXPECT_TRUE(store->Empty());
+    }
+}
+
+/*
+ * @tc.name: PendingEventStore002
+ * @tc.desc: Heap store keeps the same handling order as list store under random inserts
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerPendingEventStoreTest, PendingEventStore002, TestSize.Level1)
+{
+    auto list = PendingEventStore::Create(PendingEventStore::Type::LIST);
+    auto heap = PendingEventStore::Create(PendingEventStore::Type::HEAP);
+    FillRandomly(*list, *heap, RANDOM_EVENT_NUM);
+
+    EXPECT_EQ(list->Size(), heap->Size());
+    EXPECT_EQ(CollectIds(*list), CollectIds(*heap));
+
+    // Pop half of the events, then insert more to mix FIFO and heap parts.
+    for (uint32_t i = 0; i < RANDOM_EVENT_NUM / 2; ++i) {
+        EXPECT_EQ(list->PopFront()->GetInnerEventId(), heap->PopFront()->GetInnerEventId());
+    }
+    FillRandomly(*list, *heap, RANDOM_EVENT_NUM);
+    EXPECT_EQ(PopAllIds(*list), PopAllIds(*heap));
+}
+
+/*
+ * @tc.name: PendingEventStore003
+ * @tc.desc: PopFirstIf and HasExpiredIf match events in handling order
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerPendingEventStoreTest, PendingEventStore003, TestSize.Level1)
+{
+    for (auto type : {PendingEventStore::Type::LIST, PendingEventStore::Type::HEAP}) {
+        auto store = PendingEventStore::Create(type);
+        auto now = InnerEvent::Clock::now();
+        for (uint32_t id = 0; id < 20; ++id) {
+            // Reverse order, so that heap store keeps most of them in the heap.
+            auto event = CreateEvent(id, now + std::chrono::milliseconds(20 - id));
+            store->Insert(event, EventInsertType::AT_END);
+        }
+        auto isOdd = [](const InnerEvent::Pointer &event) { return (event->GetInnerEventId() % 2) != 0; };
+        auto isTen = [](const InnerEvent::Pointer &event) { return event->GetInnerEventId() == 10; };
+
+        EXPECT_TRUE(store->HasExpiredIf(now + std::chrono::milliseconds(1), isOdd));
+        EXPECT_FALSE(store->HasExpiredIf(now + std::chrono::milliseconds(9), isTen));
+        EXPECT_TRUE(store->HasExpiredIf(now + std::chrono::milliseconds(10), isTen));
+        EXPECT_FALSE(store->HasExpiredIf(now, isOdd));
+
+        auto event = store->PopFirstIf(isOdd);
+        ASSERT_NE(event, nullptr);
+        EXPECT_EQ(event->GetInnerEventId(), 19u);
+        event = store->PopFirstIf(isTen);
+        ASSERT_NE(event, nullptr);
+        EXPECT_EQ(store->PopFirstIf(isTen), nullptr);
+        EXPECT_EQ(store->Size(), 18);
+        EXPECT_EQ(store->Front()->GetInnerEventId(), 18u);
+    }
+}
+
+/*
+ * @tc.name: PendingEventStore004
+ * @tc.desc: RemoveIf, ExtractIf, AnyOf and Clear
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerPendingEventStoreTest, PendingEventStore004, TestSize.Level1)
+{
+    auto list = PendingEventStore::Create(PendingEventStore::Type::LIST);
+    auto heap = PendingEventStore::Create(PendingEventStore::Type::HEAP);
+    FillRandomly(*list, *heap, RANDOM_EVENT_NUM);
+
+    auto multipleOfThree = [](const InnerEvent::Pointer &event) { return (event->GetInnerEventId() % 3) == 0; };
+    auto multipleOfFive = [](const InnerEvent::Pointer &event) { return (event->GetInnerEventId() % 5) == 0; };
+    list->RemoveIf(multipleOfThree);
+    heap->RemoveIf(multipleOfThree);
+    EXPECT_FALSE(heap->AnyOf(multipleOfThree));
+    EXPECT_TRUE(heap->AnyOf(multipleOfFive));
+    EXPECT_EQ(CollectIds(*list), CollectIds(*heap));
+
+    std::list<InnerEvent::Pointer> fromList;
+    std::list<InnerEvent::Pointer> fromHeap;
+    list->ExtractIf(multipleOfFive, fromList);
+    heap->ExtractIf(multipleOfFive, fromHeap);
+    EXPECT_EQ(fromList.size(), fromHeap.size());
+    EXPECT_FALSE(heap->AnyOf(multipleOfFive));
+    EXPECT_EQ(list->Size(), heap->Size());
+    EXPECT_EQ(PopAllIds(*list), PopAllIds(*heap));
+
+    FillRandomly(*list, *heap, RANDOM_EVENT_NUM);
+    heap->Clear();
+    EXPECT_TRUE(heap->Empty());
+    EXPECT_EQ(heap->Size(), 0);
+    EXPECT_EQ(heap->PopFirstIf(multipleOfFive), nullptr);
+}
+
+/*
+ * @tc.name: PendingEventStore005
+ * @tc.desc: Remove and find events through the owner index
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerPendingEventStoreTest, PendingEventStore005, TestSize.Level1)
+{
+    for (auto type : {PendingEventStore::Type::LIST, PendingEventStore::Type::HEAP}) {
+        auto store = PendingEventStore::Create(type);
+        auto now = InnerEvent::Clock::now();
+        // Sorted inserts go to the FIFO of heap store, so removing owner B leaves holes in the middle of it.
+        for (uint32_t i = 0; i < 12; ++i) {
+            auto event = CreateOwnedEvent(i % 3, now + std::chrono::milliseconds(i), (i % 2 == 0) ? OWNER_A : OWNER_B, i);
+            store->Insert(event, EventInsertType::AT_END);
+        }
+        auto task = InnerEvent::Get([]() {}, "task");
+        task->SetHandleTime(now + std::chrono::milliseconds(12));
+        task->SetOwnerId(OWNER_A);
+        store->Insert(task, EventInsertType::AT_END);
+
+        EXPECT_TRUE(store->AnyOfOwner(OWNER_B, MatchAll));
+        EXPECT_FALSE(store->AnyOfOwner(OWNER_C, MatchAll));
+        EXPECT_TRUE(store->AnyOfOwnerEvent(OWNER_A, 2, MatchAll));
+        EXPECT_FALSE(store->AnyOfOwnerEvent(OWNER_A, 3, MatchAll));
+        auto isParamEight = [](InnerEvent &event) { return event.GetParam() == 8; };
+        EXPECT_TRUE(store->AnyOfOwnerEvent(OWNER_A, 2, isParamEight));
+
+        std::list<InnerEvent::Pointer> removed;
+        EXPECT_EQ(store->ExtractOwnerIf(OWNER_B, MatchAll, removed), 6u);
+        EXPECT_EQ(removed.size(), 6u);
+        EXPECT_FALSE(store->AnyOfOwner(OWNER_B, MatchAll));
+        EXPECT_EQ(store->Size(), 7u);
+        std::vector<uint32_t> expected = {0, 2, 1, 0, 2, 1, 0};
+        EXPECT_EQ(CollectIds(*store), expected);
+
+        // Task events are not indexed by event id.
+        EXPECT_EQ(store->ExtractOwnerEventIf(OWNER_A, 0, MatchAll, removed), 2u);
+        EXPECT_EQ(store->ExtractOwnerEventIf(OWNER_A, 2, isParamEight, removed), 1u);
+        EXPECT_EQ(removed.size(), 9u);
+        expected = {2, 1, 1, 0};
+        EXPECT_EQ(PopAllIds(*store), expected);
+        EXPECT_FALSE(store->AnyOfOwner(OWNER_A, MatchAll));
+    }
+}
+
+/*
+ * @tc.name: PendingEventStore006
+ * @tc.desc: Heap store keeps the same handling order as list store under random removals through the owner index
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerPendingEventStoreTest, PendingEventStore006, TestSize.Level1)
+{
+    auto list = PendingEventStore::Create(PendingEventStore::Type::LIST);
+    auto heap = PendingEventStore::Create(PendingEventStore::Type::HEAP);
+    std::mt19937 random(RANDOM_SEED);
+    std::uniform_int_distribution<int64_t> delay(0, MAX_RANDOM_DELAY_MS);
+    std::uniform_int_distribution<uint64_t> owner(1, RANDOM_OWNER_NUM);
+    std::uniform_int_distribution<uint32_t> id(0, RANDOM_ID_NUM - 1);
+    std::uniform_int_distribution<int32_t> percent(0, 99);
+    auto base = InnerEvent::Clock::now();
+    uint32_t serial = 0;
+    for (uint32_t round = 0; round < RANDOM_ROUND_NUM; ++round) {
+        for (uint32_t i = 0; i < 20; ++i) {
+            // Half of the events arrive in order, so that both FIFO and heap of the heap store are used.
+            auto handleTime = base + std::chrono::milliseconds((percent(random) < 50) ? round : delay(random) + round);
+            uint64_t ownerId = owner(random);
+            EventInsertType insertType = (percent(random) < 5) ? EventInsertType::AT_FRONT : EventInsertType::AT_END;
+            uint32_t eventId = id(random);
+            auto first = CreateOwnedEvent(eventId, handleTime, ownerId, serial);
+            auto second = CreateOwnedEvent(eventId, handleTime, ownerId, serial);
+            list->Insert(first, insertType);
+            heap->Insert(second, insertType);
+            ++serial;
+        }
+        uint64_t ownerId = owner(random);
+        uint32_t eventId = id(random);
+        std::list<InnerEvent::Pointer> removed;
+        if (percent(random) < 20) {
+            EXPECT_EQ(list->ExtractOwnerIf(ownerId, MatchAll, removed),
+                heap->ExtractOwnerIf(ownerId, MatchAll, removed));
+        } else {
+            EXPECT_EQ(list->ExtractOwnerEventIf(ownerId, eventId, MatchAll, removed),
+                heap->ExtractOwnerEventIf(ownerId, eventId, MatchAll, removed));
+        }
+        for (uint32_t i = 0; (i < 5) && !list->Empty(); ++i) {
+            EXPECT_EQ(list->PopFront()->GetParam(), heap->PopFront()->GetParam());
+        }
+        ASSERT_EQ(list->Size(), heap->Size());
+    }
+    std::vector<int64_t> fromList;
+    std::vector<int64_t> fromHeap;
+    list->ForEach([&fromList](const InnerEvent::Pointer &event) { fromList.push_back(event->GetParam()); });
+    heap->ForEach([&fromHeap](const InnerEvent::Pointer &event) { fromHeap.push_back(event->GetParam()); });
+    EXPECT_EQ(fromList, fromHeap);
+    while (!list->Empty()) {
+        EXPECT_EQ(list->PopFront()->GetParam(), heap->PopFront()->GetParam());
+    }
+    EXPECT_TRUE(heap->Empty());
+}
+
+/*
+ * @tc.name: PendingEventStore007
+ * @tc.desc: ExtractOrphansIf only extracts events whose owner is released
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerPendingEventStoreTest, PendingEventStore007, TestSize.Level1)
+{
+    for (auto type : {PendingEventStore::Type::LIST, PendingEventStore::Type::HEAP}) {
+        auto store = PendingEventStore::Create(type);
+        auto alive = std::make_shared<EventHandler>();
+        auto released = std::make_shared<EventHandler>();
+        auto now = InnerEvent::Clock::now();
+        for (uint32_t i = 0; i < 10; ++i) {
+            auto &owner = (i % 2 == 0) ? alive : released;
+            auto event = CreateOwnedEvent(i, now + std::chrono::milliseconds(10 - i), owner->GetHandlerId());
+            event->SetOwner(owner);
+            store->Insert(event, EventInsertType::AT_END);
+        }
+        released.reset();
+
+        std::list<InnerEvent::Pointer> orphans;
+        auto isOrphan = [](InnerEvent &event) { return event.GetWeakOwner().expired(); };
+        store->ExtractOrphansIf(isOrphan, orphans);
+        EXPECT_EQ(orphans.size(), 5u);
+        std::vector<uint32_t> expected = {8, 6, 4, 2, 0};
+        EXPECT_EQ(CollectIds(*store), expected);
+
+        orphans.clear();
+        store->ExtractOrphansIf(isOrphan, orphans);
+        EXPECT_TRUE(orphans.empty());
+        EXPECT_EQ(store->Size(), 5u);
+    }
+}
+
+/*
+ * @tc.name: PendingEventStore008
+ * @tc.desc: FirstHandleTimeAfter finds the earliest event not due yet, in both FIFO and heap parts
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerPendingEventStoreTest, PendingEventStore008, TestSize.Level1)
+{
+    for (auto type : {PendingEventStore::Type::LIST, PendingEventStore::Type::HEAP}) {
+        auto store = PendingEventStore::Create(type);
+        auto now = InnerEvent::Clock::now();
+        EXPECT_EQ(store->FirstHandleTimeAfter(now), InnerEvent::TimePoint::max());
+        for (uint32_t id = 0; id < 20; ++id) {
+            // Reverse order, so that heap store keeps most of them in the heap.
+            auto event = CreateEvent(id, now + std::chrono::milliseconds(20 - id));
+            store->Insert(event, EventInsertType::AT_END);
+        }
+        auto event = CreateEvent(20, now + std::chrono::milliseconds(30));
+        store->Insert(event, EventInsertType::AT_END);
+
+        EXPECT_EQ(store->FirstHandleTimeAfter(now), now + std::chrono::milliseconds(1));
+        EXPECT_EQ(store->FirstHandleTimeAfter(now + std::chrono::milliseconds(10)),
+            now + std::chrono::milliseconds(11));
+        EXPECT_EQ(store->FirstHandleTimeAfter(now + std::chrono::milliseconds(20)),
+            now + std::chrono::milliseconds(30));
+        EXPECT_EQ(store->FirstHandleTimeAfter(now + std::chrono::milliseconds(30)), InnerEvent::TimePoint::max());
+    }
+}
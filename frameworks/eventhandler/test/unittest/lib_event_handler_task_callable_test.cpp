@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdlib>
+#include <future>
+#include <memory>
+#include <new>
+
+#include "event_handler.h"
+#include "event_runner.h"
+#include "inner_event.h"
+#include "task_callable.h"
+
+using namespace testing::ext;
+using namespace OHOS::AppExecFwk;
+
+namespace {
+thread_local bool g_countAllocation = false;
+thread_local uint32_t g_allocationCount = 0;
+
+void *CountedAlloc(size_t size)
+{
+    if (g_countAllocation) {
+        ++g_allocationCount;
+    }
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+// Count allocations made by the current thread between Start() and Stop().
+class AllocationCounter final {
+public:
+    void Start()
+    {
+        g_allocationCount = 0;
+        g_countAllocation = true;
+    }
+
+    uint32_t Stop()
+    {
+        g_countAllocation = false;
+        return g_allocationCount;
+    }
+};
+
+template<size_t N>
+struct Payload {
+    std::array<uint8_t, N> bytes {};
+};
+
+// Number of allocations to create an event with a lambda capturing N bytes, after the event pool is warmed up.
+template<size_t N>
+uint32_t CountTaskAllocation(bool &isInline)
+{
+    InnerEvent::Get(0).reset();
+    Payload<N> payload;
+    uint32_t sum = 0;
+    AllocationCounter counter;
+    counter.Start();
+    auto event = InnerEvent::Get([payload, &sum]() { sum += payload.bytes[0]; });
+    uint32_t count = counter.Stop();
+    isInline = event->GetTaskCallback().IsInline();
+    return count;
+}
+}  // unnamed namespace
+
+void *operator new(size_t size)
+{
+    void *ptr = CountedAlloc(size);
+    if (ptr == nullptr) {
+        std::abort();
+    }
+    return ptr;
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept
+{
+    return CountedAlloc(size);
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+class LibEventHandlerTaskCallableTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+void LibEventHandlerTaskCallableTest::SetUpTestCase(void)
+{}
+
+void LibEventHandlerTaskCallableTest::TearDownTestCase(void)
+{}
+
+void LibEventHandlerTaskCallableTest::SetUp(void)
+{}
+
+void LibEventHandlerTaskCallableTest::TearDown(void)
+{}
+
+/*
+ * @tc.name: TaskCallable001
+ * @tc.desc: Small callables are kept inline, moved and called without allocation
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerTaskCallableTest, TaskCallable001, TestSize.Level1)
+{
+    int called = 0;
+    AllocationCounter counter;
+    counter.Start();
+    TaskCallable task([&called]() { ++called; });
+    TaskCallable moved(std::move(task));
+    moved();
+    moved = nullptr;
+    uint32_t count = counter.Stop();
+    EXPECT_EQ(0u, count);
+    EXPECT_EQ(1, called);
+    EXPECT_FALSE(task);
+    EXPECT_FALSE(moved);
+}
+
+/*
+ * @tc.name: TaskCallable002
+ * @tc.desc: Move-only callables are accepted, large callables are kept on heap, empty callables give empty holders
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerTaskCallableTest, TaskCallable002, TestSize.Level1)
+{
+    auto value = std::make_unique<int>(0);
+    int *raw = value.get();
+    TaskCallable task([value = std::move(value)]() { ++(*value); });
+    EXPECT_TRUE(task.IsInline());
+    task();
+    EXPECT_EQ(1, *raw);
+
+    Payload<TaskCallable::INLINE_SIZE + 1> payload;
+    TaskCallable large([payload]() { (void)payload; });
+    EXPECT_TRUE(large);
+    EXPECT_FALSE(large.IsInline());
+    TaskCallable movedLarge(std::move(large));
+    EXPECT_TRUE(movedLarge);
+    EXPECT_FALSE(large);
+
+    EXPECT_FALSE(TaskCallable(std::function<void()>()));
+    void (*func)() = nullptr;
+    EXPECT_FALSE(TaskCallable(func));
+}
+
+/*
+ * @tc.name: TaskAllocation001
+ * @tc.desc: Creating a task event with a lambda capturing up to INLINE_SIZE bytes needs no allocation
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerTaskCallableTest, TaskAllocation001, TestSize.Level1)
+{
+    constexpr size_t referenceSize = sizeof(void *);
+    bool isInline = false;
+    EXPECT_EQ(0u, CountTaskAllocation<1>(isInline));
+    EXPECT_TRUE(isInline);
+    EXPECT_EQ(0u, CountTaskAllocation<16>(isInline));
+    EXPECT_TRUE(isInline);
+    EXPECT_EQ(0u, CountTaskAllocation<32>(isInline));
+    EXPECT_TRUE(isInline);
+    EXPECT_EQ(0u, CountTaskAllocation<TaskCallable::INLINE_SIZE - referenceSize>(isInline));
+    EXPECT_TRUE(isInline);
+    EXPECT_EQ(1u, CountTaskAllocation<TaskCallable::INLINE_SIZE>(isInline));
+    EXPECT_FALSE(isInline);
+}
+
+/*
+ * @tc.name: PostTask001
+ * @tc.desc: Lambdas capturing std::unique_ptr are moved into the posted task
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerTaskCallableTest, PostTask001, TestSize.Level1)
+{
+    auto runner = EventRunner::Create(true);
+    auto handler = std::make_shared<EventHandler>(runner);
+    std::promise<int> promise;
+    auto future = promise.get_future();
+    auto value = std::make_unique<int>(1);
+    EXPECT_TRUE(handler->PostTask([value = std::move(value), &promise]() { promise.set_value(*value); },
+        "unique", 0, EventQueue::Priority::HIGH));
+    EXPECT_EQ(1, future.get());
+
+    std::promise<int> delayed;
+    auto delayedFuture = delayed.get_future();
+    auto delayedValue = std::make_unique<int>(2);
+    EXPECT_TRUE(handler->PostTask([delayedValue = std::move(delayedValue), &delayed]() {
+        delayed.set_value(*delayedValue);
+    }, std::chrono::microseconds(100)));
+    EXPECT_EQ(2, delayedFuture.get());
+}
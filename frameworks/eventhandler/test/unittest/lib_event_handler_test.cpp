@@ -15,17 +15,22 @@
 
 #include "event_handler.h"
 #include "event_queue.h"
+#include "event_queue_base.h"
 #include "event_runner.h"
 #include "inner_event.h"
+#include "latency_histogram.h"
 #ifdef FFRT_USAGE_ENABLE
 #include "ffrt_inner.h"
 #endif // FFRT_USAGE_ENABLE
 #include "ffrt_descriptor_listener.h"
 
 #include <gtest/gtest.h>
+#include <atomic>
 #include <dlfcn.h>
 #include <string>
+#include <thread>
 #include <unistd.h>
+#include <vector>
 #include "async_stack_adapter.h"
 #include "local_handle_adapter.h"
 #include "lock_base.h"
@@ -577,4 +582,438 @@ HWTEST_F(LibEventHandlerTest, LockTest_001, TestSize.Level1)
     lockBase1.unlock();
     auto handler = std::make_shared<EventHandler>(nullptr);
     EXPECT_NE(nullptr, handler);
-}
\ No newline at end of file
+}
+
+/*
+ * @tc.name: HandlerId_001
+ * @tc.desc: Handler ids are unique and increasing, events carry the id of their handler
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerTest, HandlerId_001, TestSize.Level1)
+{
+    auto runner = EventRunner::Create(false);
+    auto first = std::make_shared<EventHandler>(runner);
+    auto second = std::make_shared<EventHandler>(runner);
+    EXPECT_NE(first->GetHandlerId(), 0u);
+    EXPECT_GT(second->GetHandlerId(), first->GetHandlerId());
+
+    auto event = InnerEvent::Get(1);
+    EXPECT_EQ(event->GetOwnerId(), 0u);
+    EXPECT_TRUE(second->SendEvent(event, 100, EventQueue::Priority::LOW));
+    EXPECT_TRUE(second->HasInnerEvent(1u));
+    EXPECT_FALSE(first->HasInnerEvent(1u));
+    first->RemoveEvent(1u);
+    EXPECT_TRUE(second->HasInnerEvent(1u));
+    second->RemoveEvent(1u);
+    EXPECT_FALSE(second->HasInnerEvent(1u));
+}
+
+/*
+ * @tc.name: SendEvents_001
+ * @tc.desc: Events sent together are all pending with their own delay time and priority
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerTest, SendEvents_001, TestSize.Level1)
+{
+    auto runner = EventRunner::Create(false);
+    auto handler = std::make_shared<EventHandler>(runner);
+    std::vector<EventHandler::EventItem> items;
+    items.push_back({InnerEvent::Get(1), 100, EventQueue::Priority::LOW});
+    items.push_back({InnerEvent::Get(2), 0, EventQueue::Priority::HIGH});
+    items.push_back({InnerEvent::Get(3), 0, EventQueue::Priority::IDLE});
+    EXPECT_TRUE(handler->SendEvents(items));
+    for (const auto &item : items) {
+        EXPECT_EQ(item.event, nullptr);
+    }
+    EXPECT_TRUE(handler->HasInnerEvent(1u));
+    EXPECT_TRUE(handler->HasInnerEvent(2u));
+    EXPECT_TRUE(handler->HasInnerEvent(3u));
+
+    std::vector<EventHandler::EventItem> invalidItems;
+    invalidItems.push_back({InnerEvent::Get(4), 0, EventQueue::Priority::LOW});
+    invalidItems.push_back({InnerEvent::Pointer(nullptr, nullptr), 0, EventQueue::Priority::LOW});
+    EXPECT_FALSE(handler->SendEvents(invalidItems));
+    EXPECT_NE(invalidItems[0].event, nullptr);
+    EXPECT_FALSE(handler->HasInnerEvent(4u));
+    handler->RemoveAllEvents();
+}
+
+/*
+ * @tc.name: PostTasks_001
+ * @tc.desc: Tasks posted together run in the order of posting
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerTest, PostTasks_001, TestSize.Level1)
+{
+    auto runner = EventRunner::Create(true);
+    auto handler = std::make_shared<EventHandler>(runner);
+    std::vector<int> order;
+    std::vector<EventHandler::TaskItem> items;
+    const int taskNum = 3;
+    for (int i = 0; i < taskNum; ++i) {
+        items.push_back({[&order, i]() { order.push_back(i); }, "PostTasks_001", 0, EventQueue::Priority::LOW});
+    }
+    EXPECT_TRUE(handler->PostTasks(items));
+    EXPECT_TRUE(handler->PostSyncTask([]() {}));
+    EXPECT_EQ(order, std::vector<int>({0, 1, 2}));
+    runner->Stop();
+}
+
+/*
+ * @tc.name: SendEventWithNanoseconds_001
+ * @tc.desc: Delays shorter than one millisecond are kept in the handle time
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerTest, SendEventWithNanoseconds_001, TestSize.Level1)
+{
+    auto runner = EventRunner::Create(false);
+    auto handler = std::make_shared<EventHandler>(runner);
+    const std::chrono::microseconds delay(300);
+    auto event = InnerEvent::Get(1);
+    auto sent = event.get();
+    EXPECT_TRUE(handler->SendEvent(event, delay));
+    EXPECT_EQ(sent->GetHandleTime() - sent->GetSendTime(), delay);
+    EXPECT_EQ(sent->GetDelayTime(), 0);
+
+    auto taskTime = InnerEvent::Clock::now() + delay;
+    event = InnerEvent::Get(2);
+    sent = event.get();
+    EXPECT_TRUE(handler->SendTimingEvent(event, taskTime));
+    EXPECT_GE(sent->GetHandleTime(), taskTime);
+    EXPECT_LT(sent->GetHandleTime() - taskTime, std::chrono::milliseconds(1));
+    handler->RemoveAllEvents();
+}
+
+/*
+ * @tc.name: PostTaskWithNanoseconds_001
+ * @tc.desc: Task posted with a delay in microseconds runs after the delay
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerTest, PostTaskWithNanoseconds_001, TestSize.Level1)
+{
+    auto runner = EventRunner::Create(true);
+    auto handler = std::make_shared<EventHandler>(runner);
+    runner->GetEventQueue()->SetHighResolutionWait(true);
+    const std::chrono::microseconds delay(300);
+    std::atomic<bool> ran(false);
+    auto start = InnerEvent::Clock::now();
+    InnerEvent::TimePoint runTime;
+    EXPECT_TRUE(handler->PostTask([&ran, &runTime]() {
+        runTime = InnerEvent::Clock::now();
+        ran.store(true);
+    }, delay));
+    const int64_t waitTimes = 1000;
+    for (int64_t i = 0; (i < waitTimes) && !ran.load(); ++i) {
+        usleep(100);
+    }
+    ASSERT_TRUE(ran.load());
+    EXPECT_GE(runTime - start, delay);
+    runner->Stop();
+}
+
+/*
+ * @tc.name: LatencyHistogram_001
+ * @tc.desc: Percentiles of the histogram are at most one bucket larger than the real ones
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerTest, LatencyHistogram_001, TestSize.Level1)
+{
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.GetSummary().count, 0u);
+    const int64_t valueNum = 1000;
+    for (int64_t i = 1; i <= valueNum; ++i) {
+        histogram.Record(i * 1000);
+    }
+    histogram.Record(-1);
+    auto summary = histogram.GetSummary();
+    EXPECT_EQ(summary.count, static_cast<uint64_t>(valueNum + 1));
+    EXPECT_EQ(summary.max, static_cast<uint64_t>(valueNum * 1000));
+    // Buckets are no wider than 1/8 of their lower bounds.
+    EXPECT_GE(summary.p50, 500000u);
+    EXPECT_LE(summary.p50, 500000u * 9 / 8);
+    EXPECT_GE(summary.p99, 990000u);
+    EXPECT_LE(summary.p99, summary.max);
+    EXPECT_LE(summary.p90, summary.p99);
+    EXPECT_LE(summary.p99, summary.p999);
+}
+
+/*
+ * @tc.name: GetLatencySnapshot_001
+ * @tc.desc: Latencies of distributed events are recorded by priority into enabled runners and handlers
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerTest, GetLatencySnapshot_001, TestSize.Level1)
+{
+    auto runner = EventRunner::Create(true);
+    auto handler = std::make_shared<EventHandler>(runner);
+    auto otherHandler = std::make_shared<EventHandler>(runner);
+    EXPECT_EQ(handler->GetLatencySnapshot().delivery[0].count, 0u);
+    EXPECT_FALSE(runner->latencyStatsCreated_.load());
+    handler->PostSyncTask([]() {});
+    EXPECT_EQ(runner->GetLatencySnapshot().delivery[static_cast<uint32_t>(EventQueue::Priority::LOW)].count, 0u);
+    EXPECT_EQ(runner->latencyStats_, nullptr);
+    runner->SetLatencyStatsEnabled(true);
+    handler->SetLatencyStatsEnabled(true);
+    const uint32_t taskNum = 3;
+    for (uint32_t i = 0; i < taskNum; ++i) {
+        handler->PostTask([]() { usleep(1000); }, 0, EventQueue::Priority::HIGH);
+    }
+    otherHandler->PostSyncTask([]() {}, EventQueue::Priority::LOW);
+
+    auto high = static_cast<uint32_t>(EventQueue::Priority::HIGH);
+    auto low = static_cast<uint32_t>(EventQueue::Priority::LOW);
+    auto runnerSnapshot = runner->GetLatencySnapshot();
+    EXPECT_EQ(runnerSnapshot.delivery[high].count, taskNum);
+    EXPECT_GE(runnerSnapshot.distribute[high].p50, 1000000u);
+    EXPECT_EQ(runnerSnapshot.delivery[low].count, 1u);
+    auto handlerSnapshot = handler->GetLatencySnapshot();
+    EXPECT_EQ(handlerSnapshot.distribute[high].count, taskNum);
+    EXPECT_EQ(handlerSnapshot.distribute[low].count, 0u);
+    EXPECT_EQ(otherHandler->GetLatencySnapshot().distribute[low].count, 0u);
+
+    // Recorded latencies are kept, and no more is recorded after disabled.
+    runner->SetLatencyStatsEnabled(false);
+    otherHandler->PostSyncTask([]() {}, EventQueue::Priority::LOW);
+    EXPECT_EQ(runner->GetLatencySnapshot().delivery[low].count, 1u);
+    runner->Stop();
+}
+
+/*
+ * @tc.name: TaskHandle_001
+ * @tc.desc: Tasks are cancelled by their handles, other tasks with the same name are kept
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerTest, TaskHandle_001, TestSize.Level1)
+{
+    auto runner = EventRunner::Create(false);
+    auto handler = std::make_shared<EventHandler>(runner);
+    const std::string name = "TaskHandle_001";
+    auto first = handler->PostTaskWithHandle([]() {}, name);
+    auto second = handler->PostTaskWithHandle([]() {}, name, 100);
+    auto third = handler->PostTaskWithHandle([]() {}, name, 0, EventQueue::Priority::IDLE);
+    EXPECT_TRUE(first && second && third);
+    EXPECT_TRUE(second.IsPending());
+    EXPECT_TRUE(second.Cancel());
+    EXPECT_FALSE(second.IsPending());
+    EXPECT_FALSE(second.Cancel());
+    EXPECT_TRUE(first.IsPending());
+    EXPECT_TRUE(third.Cancel());
+
+    TaskHandle empty;
+    EXPECT_FALSE(empty);
+    EXPECT_FALSE(empty.Cancel());
+    EXPECT_FALSE(empty.IsPending());
+    handler->RemoveAllEvents();
+    EXPECT_FALSE(first.IsPending());
+
+    // An event failed to send is not indexed by its unique id when sent again.
+    auto noRunnerHandler = std::make_shared<EventHandler>(nullptr);
+    auto event = InnerEvent::Get(1);
+    EXPECT_FALSE(noRunnerHandler->SendEventWithHandle(event));
+    ASSERT_NE(event, nullptr);
+    EXPECT_FALSE(event->pendingLink_.withHandle);
+}
+
+/*
+ * @tc.name: TaskHandle_002
+ * @tc.desc: A reprioritized task runs before the lower priority tasks, and is not pending after running
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerTest, TaskHandle_002, TestSize.Level1)
+{
+    auto runner = EventRunner::Create(true);
+    auto handler = std::make_shared<EventHandler>(runner);
+    std::vector<int> order;
+    const int64_t delayTime = 50;
+    auto first = handler->PostTaskWithHandle([&order]() { order.push_back(1); }, std::string(), delayTime);
+    auto second = handler->PostTaskWithHandle([&order]() { order.push_back(2); }, std::string(), delayTime);
+    // Sent after the first one with the same priority and delay, so it runs after the others.
+    auto last = handler->PostTaskForResult([]() {}, delayTime);
+    EXPECT_TRUE(second.Reprioritize(EventQueue::Priority::HIGH));
+    EXPECT_TRUE(second.Reprioritize(EventQueue::Priority::HIGH));
+    EXPECT_TRUE(second.IsPending());
+    EXPECT_TRUE(last.Get());
+    EXPECT_EQ(order, std::vector<int>({2, 1}));
+    EXPECT_FALSE(first.IsPending());
+    EXPECT_FALSE(second.Cancel());
+    EXPECT_FALSE(second.Reprioritize(EventQueue::Priority::LOW));
+    runner->Stop();
+}
+
+/*
+ * @tc.name: SyncWaiter_001
+ * @tc.desc: Sync tasks of a thread reuse its waiter, an event failed to send does not wake up the next sync task
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerTest, SyncWaiter_001, TestSize.Level1)
+{
+    auto runner = EventRunner::Create(true);
+    auto handler = std::make_shared<EventHandler>(runner);
+    auto unusableRunner = EventRunner::Create(true);
+    auto unusableHandler = std::make_shared<EventHandler>(unusableRunner);
+    std::static_pointer_cast<EventQueueBase>(unusableRunner->GetEventQueue())->SetUsable(false);
+    auto failed = InnerEvent::Get(1);
+    EXPECT_FALSE(unusableHandler->SendSyncEvent(failed));
+    EXPECT_NE(failed, nullptr);
+
+    const int taskNum = 10;
+    const useconds_t taskTime = 1000;
+    int result = -1;
+    for (int i = 0; i < taskNum; ++i) {
+        EXPECT_TRUE(handler->PostSyncTask([&result, &failed, i]() {
+            if (i == 0) {
+                // Release the failed event while the sync task is running.
+                failed.reset();
+            }
+            usleep(taskTime);
+            result = i;
+        }));
+        EXPECT_EQ(result, i);
+    }
+    std::thread other([&handler, &result, taskNum]() {
+        EXPECT_TRUE(handler->PostSyncTask([&result, taskNum]() { result = taskNum; }));
+        EXPECT_EQ(result, taskNum);
+    });
+    other.join();
+    runner->Stop();
+    unusableRunner->Stop();
+
+    // Only sync events reuse the waiter of the thread.
+    auto first = InnerEvent::Get(1);
+    auto second = InnerEvent::Get(2);
+    EXPECT_NE(first->CreateWaiter(), second->CreateWaiter());
+    EXPECT_EQ(first->UseThreadWaiter(), second->UseThreadWaiter());
+}
+
+/*
+ * @tc.name: TaskResult_001
+ * @tc.desc: Sync tasks hand their return values back, a task failed to send returns an error
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerTest, TaskResult_001, TestSize.Level1)
+{
+    auto runner = EventRunner::Create(true);
+    auto handler = std::make_shared<EventHandler>(runner);
+    const int value = 42;
+    auto result = handler->PostSyncTaskWithResult([value]() { return std::make_unique<int>(value); });
+    EXPECT_TRUE(result);
+    EXPECT_EQ(result.GetError(), ERR_OK);
+    ASSERT_NE(result.GetValue(), nullptr);
+    EXPECT_EQ(*result.GetValue(), value);
+
+    bool called = false;
+    auto voidResult = handler->PostSyncTaskWithResult([&called]() { called = true; });
+    EXPECT_TRUE(voidResult);
+    EXPECT_TRUE(called);
+
+    auto unusableRunner = EventRunner::Create(true);
+    auto unusableHandler = std::make_shared<EventHandler>(unusableRunner);
+    std::static_pointer_cast<EventQueueBase>(unusableRunner->GetEventQueue())->SetUsable(false);
+    auto failed = unusableHandler->PostSyncTaskWithResult([value]() { return value; });
+    EXPECT_FALSE(failed);
+    EXPECT_EQ(failed.GetError(), EVENT_HANDLER_ERR_TASK_NOT_RUN);
+    runner->Stop();
+    unusableRunner->Stop();
+}
+
+/*
+ * @tc.name: TaskFuture_001
+ * @tc.desc: Futures of posted tasks are waited for, or continued on another handler
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerTest, TaskFuture_001, TestSize.Level1)
+{
+    auto runner = EventRunner::Create(true);
+    auto handler = std::make_shared<EventHandler>(runner);
+    auto otherRunner = EventRunner::Create(true);
+    auto otherHandler = std::make_shared<EventHandler>(otherRunner);
+    const int delayTime = 10;
+    auto future = handler->PostTaskForResult([]() { return std::string("result"); }, delayTime);
+    EXPECT_TRUE(future.IsValid());
+    auto result = future.Get();
+    EXPECT_FALSE(future.IsValid());
+    ASSERT_TRUE(result);
+    EXPECT_EQ(result.GetValue(), "result");
+
+    const int taskNum = 10;
+    std::vector<int> values;
+    uint64_t threadId = 0;
+    for (int i = 0; i < taskNum; ++i) {
+        auto next = handler->PostTaskForResult([i]() { return i; });
+        EXPECT_TRUE(next.Then(otherHandler, [&values, &threadId](TaskResult<int> &&result) {
+            threadId = gettid();
+            values.push_back(result ? result.GetValue() : -1);
+        }));
+    }
+    EXPECT_TRUE(handler->PostSyncTask([]() {}));
+    EXPECT_TRUE(otherHandler->PostSyncTask([]() {}));
+    EXPECT_EQ(values, std::vector<int>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    EXPECT_EQ(threadId, otherRunner->GetKernelThreadId());
+    runner->Stop();
+    otherRunner->Stop();
+}
+
+/*
+ * @tc.name: TaskFuture_002
+ * @tc.desc: Futures of tasks removed before running, or failed to send, complete with an error
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerTest, TaskFuture_002, TestSize.Level1)
+{
+    auto runner = EventRunner::Create(false);
+    auto handler = std::make_shared<EventHandler>(runner);
+    auto future = handler->PostTaskForResult([]() { return 1; });
+    EXPECT_FALSE(future.IsReady());
+    handler->RemoveAllEvents();
+    EXPECT_TRUE(future.IsReady());
+    auto result = future.Get();
+    EXPECT_FALSE(result);
+    EXPECT_EQ(result.GetError(), EVENT_HANDLER_ERR_TASK_NOT_RUN);
+
+    bool continued = false;
+    auto voidFuture = handler->PostTaskForResult([]() {});
+    EXPECT_TRUE(voidFuture.Then(nullptr, [&continued](TaskResult<void> &&result) {
+        continued = (result.GetError() == EVENT_HANDLER_ERR_TASK_NOT_RUN);
+    }));
+    handler->RemoveAllEvents();
+    EXPECT_TRUE(continued);
+
+    std::shared_ptr<EventHandler> noRunnerHandler = std::make_shared<EventHandler>(nullptr);
+    auto failed = noRunnerHandler->PostTaskForResult([]() { return 1; });
+    EXPECT_TRUE(failed.IsReady());
+    EXPECT_EQ(failed.Get().GetError(), EVENT_HANDLER_ERR_TASK_NOT_RUN);
+
+    TaskFuture<int> empty;
+    EXPECT_FALSE(empty.Then(nullptr, [](TaskResult<int> &&) {}));
+    EXPECT_EQ(empty.Get().GetError(), EVENT_HANDLER_ERR_INVALID_PARAM);
+}
+
+/*
+ * @tc.name: TaskFuture_003
+ * @tc.desc: Tasks removed before running could schedule their continuations onto the same queue
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerTest, TaskFuture_003, TestSize.Level1)
+{
+    auto runner = EventRunner::Create(true);
+    auto handler = std::make_shared<EventHandler>(runner);
+    const int delayTime = 10000;
+    std::atomic<int> notRunCount {0};
+    auto continuation = [&notRunCount](TaskResult<int> &&result) {
+        if (result.GetError() == EVENT_HANDLER_ERR_TASK_NOT_RUN) {
+            ++notRunCount;
+        }
+    };
+
+    // Continuations are posted to the queue while the removed tasks are released.
+    EXPECT_TRUE(handler->PostTaskForResult([]() { return 1; }, delayTime).Then(handler, continuation));
+    handler->RemoveAllEvents();
+    EXPECT_TRUE(handler->PostSyncTask([]() {}));
+    EXPECT_EQ(notRunCount.load(), 1);
+
+    EXPECT_TRUE(handler->PostTaskForResult([]() { return 1; }, delayTime).Then(handler, continuation));
+    runner->GetEventQueue()->RemoveAll();
+    EXPECT_TRUE(handler->PostSyncTask([]() {}));
+    EXPECT_EQ(notRunCount.load(), 2);
+    runner->Stop();
+}
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "thread_local_data.h"
+
+using namespace testing::ext;
+using namespace OHOS::AppExecFwk;
+
+namespace {
+const int THREAD_NUM = 8;
+const int LOOP_NUM = 1000;
+}  // unnamed namespace
+
+class LibEventHandlerThreadLocalDataTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+void LibEventHandlerThreadLocalDataTest::SetUpTestCase(void)
+{}
+
+void LibEventHandlerThreadLocalDataTest::TearDownTestCase(void)
+{}
+
+void LibEventHandlerThreadLocalDataTest::SetUp(void)
+{}
+
+void LibEventHandlerThreadLocalDataTest::TearDown(void)
+{}
+
+/*
+ * @tc.name: ThreadLocalData001
+ * @tc.desc: Save, read and discard data of current thread
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerThreadLocalDataTest, ThreadLocalData001, TestSize.Level1)
+{
+    ThreadLocalData<int> data;
+    ThreadLocalData<int> other;
+    EXPECT_EQ(static_cast<int>(data), 0);
+    data = 1;
+    other = 2;
+    EXPECT_EQ(static_cast<int>(data), 1);
+    EXPECT_EQ(static_cast<int>(other), 2);
+    data = 3;
+    EXPECT_EQ(static_cast<int>(data), 3);
+
+    std::thread([&data]() {
+        EXPECT_EQ(static_cast<int>(data), 0);
+        data = 4;
+        EXPECT_EQ(static_cast<int>(data), 4);
+    }).join();
+    EXPECT_EQ(static_cast<int>(data), 3);
+
+    data = nullptr;
+    EXPECT_EQ(static_cast<int>(data), 0);
+    EXPECT_EQ(static_cast<int>(other), 2);
+    other = nullptr;
+}
+
+/*
+ * @tc.name: ThreadLocalData002
+ * @tc.desc: Data saved by another thread is not visible, and it is released when the thread exits
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerThreadLocalDataTest, ThreadLocalData002, TestSize.Level1)
+{
+    ThreadLocalData<std::shared_ptr<int>> data;
+    auto value = std::make_shared<int>(1);
+    std::thread([&data, &value]() {
+        data = value;
+        EXPECT_EQ(static_cast<std::shared_ptr<int>>(data), value);
+    }).join();
+    EXPECT_EQ(static_cast<std::shared_ptr<int>>(data), nullptr);
+    EXPECT_EQ(value.use_count(), 1);
+}
+
+/*
+ * @tc.name: ThreadLocalData003
+ * @tc.desc: Threads save and read their own data concurrently
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerThreadLocalDataTest, ThreadLocalData003, TestSize.Level1)
+{
+    auto data = std::make_unique<ThreadLocalData<int>>();
+    std::vector<std::thread> threads;
+    for (int i = 1; i <= THREAD_NUM; ++i) {
+        threads.emplace_back([&data, i]() {
+            for (int loop = 0; loop < LOOP_NUM; ++loop) {
+                *data = i * LOOP_NUM + loop;
+                EXPECT_EQ(static_cast<int>(*data), i * LOOP_NUM + loop);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    // Thread exits after the data is destroyed.
+    std::mutex lock;
+    std::condition_variable cond;
+    bool saved = false;
+    bool destroyed = false;
+    std::thread worker([&]() {
+        *data = 1;
+        std::unique_lock<std::mutex> guard(lock);
+        saved = true;
+        cond.notify_all();
+        cond.wait(guard, [&destroyed]() { return destroyed; });
+    });
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        cond.wait(guard, [&saved]() { return saved; });
+        data.reset();
+        destroyed = true;
+        cond.notify_all();
+    }
+    worker.join();
+    ThreadLocalData<int> other;
+    EXPECT_EQ(static_cast<int>(other), 0);
+}
+
+/*
+ * @tc.name: ThreadLocalData004
+ * @tc.desc: Data is still accessible by destructors of thread local objects, after it is released on thread exit
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerThreadLocalDataTest, ThreadLocalData004, TestSize.Level1)
+{
+    static ThreadLocalData<std::shared_ptr<int>> data;
+    static std::atomic<int> readAtExit {-1};
+    struct ExitProbe {
+        ~ExitProbe()
+        {
+            // Destroyed after the data of this thread, which is constructed later.
+            data = std::make_shared<int>(1);
+            auto value = static_cast<std::shared_ptr<int>>(data);
+            readAtExit = (value == nullptr) ? 0 : *value;
+            data = nullptr;
+        }
+    };
+    auto value = std::make_shared<int>(1);
+    std::thread([&value]() {
+        static thread_local ExitProbe probe;
+        (void)probe;
+        data = value;
+    }).join();
+    EXPECT_EQ(readAtExit.load(), 0);
+    EXPECT_EQ(value.use_count(), 1);
+}
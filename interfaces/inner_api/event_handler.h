@@ -16,9 +16,13 @@
 #ifndef BASE_EVENTHANDLER_INTERFACES_INNER_API_EVENT_HANDLER_H
 #define BASE_EVENTHANDLER_INTERFACES_INNER_API_EVENT_HANDLER_H
 
+#include <mutex>
+
 #include "event_runner.h"
 #include "dumper.h"
 #include "inner_event.h"
+#include "task_future.h"
+#include "task_handle.h"
 
 #ifndef __has_builtin
 #define __has_builtin(x) 0
@@ -30,6 +34,13 @@
     #define EVENTHANDLER_HIDDEN
 #endif
 
+// Awaitables for C++20 coroutines, only declared for users building with coroutine support.
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#define EVENT_HANDLER_COROUTINE_SUPPORT 1
+#endif
+#endif
+
 namespace OHOS {
 namespace AppExecFwk {
 enum class EventType {
@@ -41,6 +52,11 @@ enum class EventType {
 template<typename T>
 class ThreadLocalData;
 
+#ifdef EVENT_HANDLER_COROUTINE_SUPPORT
+class ScheduleAwaiter;
+class FileDescriptorAwaiter;
+#endif
+
 struct TaskOptions {
     std::string dfxName_;
     int64_t delayTime_;
@@ -60,6 +76,21 @@ public:
     using Callback = InnerEvent::Callback;
     using Priority = EventQueue::Priority;
 
+    // Event to send together with other events.
+    struct EventItem {
+        InnerEvent::Pointer event {nullptr, nullptr};
+        int64_t delayTime {0};
+        Priority priority {Priority::LOW};
+    };
+
+    // Task to post together with other tasks.
+    struct TaskItem {
+        Callback callback;
+        std::string name;
+        int64_t delayTime {0};
+        Priority priority {Priority::LOW};
+    };
+
     /**
      * Constructor, set 'EventRunner' automatically.
      *
@@ -86,6 +117,16 @@ public:
      */
     bool SendEvent(InnerEvent::Pointer &event, int64_t delayTime = 0, Priority priority = Priority::LOW);
 
+    /**
+     * Send an event with a delay shorter than or not a multiple of one millisecond.
+     *
+     * @param event Event which should be handled.
+     * @param delay Process the event after 'delay', such as std::chrono::microseconds(300).
+     * @param priority Priority of the event queue for this event.
+     * @return Returns true if event has been sent successfully. If returns false, event should be released manually.
+     */
+    bool SendEvent(InnerEvent::Pointer &event, std::chrono::nanoseconds delay, Priority priority = Priority::LOW);
+
     /**
      * Send an event.
      *
@@ -96,6 +137,67 @@ public:
      */
     bool SendTimingEvent(InnerEvent::Pointer &event, int64_t taskTime, Priority priority = Priority::LOW);
 
+    /**
+     * Send an event.
+     *
+     * @param event Event which should be handled.
+     * @param taskTime Process the event at taskTime, in the precision of nanoseconds.
+     * @param priority Priority of the event queue for this event.
+     * @return Returns true if event has been sent successfully. If returns false, event should be released manually.
+     */
+    bool SendTimingEvent(InnerEvent::Pointer &event, const InnerEvent::TimePoint &taskTime,
+        Priority priority = Priority::LOW);
+
+    /**
+     * Send several events, in the order of items.
+     * All events are inserted into the event queue at once, which wakes up the runner at most once.
+     *
+     * @param items Events with their delay time and priority, sent events are moved out of items.
+     * @return Returns true if all events have been sent successfully. If returns false, events left in items are not
+     * sent. Runners with the base event queue send no event then, while FFRT runners may have sent the events
+     * before the first failed one.
+     */
+    bool SendEvents(std::vector<EventItem> &items);
+
+    /**
+     * Send an event, or merge it into the pending event with the same key sent by this handler.
+     * Events are merged only if they have the same priority and the same event id, and the pending event keeps its
+     * position and handle time. The key is shared by coalesced events and tasks of this handler.
+     *
+     * @param event Event which should be handled, released if it is merged.
+     * @param key Key of the event.
+     * @param policy Replace the pending event with this one, or keep the pending one and drop this one.
+     * @param delayTime Process the event after 'delayTime' milliseconds, if no pending event is found.
+     * @param priority Priority of the event queue for this event.
+     * @return Returns true if event has been sent or merged successfully.
+     */
+    bool SendCoalescedEvent(InnerEvent::Pointer &event, uint64_t key,
+        CoalescePolicy policy = CoalescePolicy::REPLACE_LATEST, int64_t delayTime = 0,
+        Priority priority = Priority::LOW);
+
+    /**
+     * Send an event, or merge it into the pending event with the same event id sent by this handler.
+     *
+     * @param event Event which should be handled, released if it is merged, tasks are not accepted.
+     * @param policy Replace the pending event with this one, or keep the pending one and drop this one.
+     * @param delayTime Process the event after 'delayTime' milliseconds, if no pending event is found.
+     * @param priority Priority of the event queue for this event.
+     * @return Returns true if event has been sent or merged successfully.
+     */
+    bool SendCoalescedEvent(InnerEvent::Pointer &event, CoalescePolicy policy = CoalescePolicy::REPLACE_LATEST,
+        int64_t delayTime = 0, Priority priority = Priority::LOW);
+
+    /**
+     * Send an event, and return a handle to cancel, check or reprioritize it without searching the queue.
+     *
+     * @param event Event which should be handled.
+     * @param delayTime Process the event after 'delayTime' milliseconds.
+     * @param priority Priority of the event queue for this event.
+     * @return Returns the handle of the event, which refers to no event if the event is not sent.
+     */
+    TaskHandle SendEventWithHandle(InnerEvent::Pointer &event, int64_t delayTime = 0,
+        Priority priority = Priority::LOW);
+
     /**
      * Send an event.
      *
@@ -121,6 +223,20 @@ public:
         return SendEvent(event, delayTime, priority);
     }
 
+    /**
+     * Send an event with a delay shorter than or not a multiple of one millisecond.
+     *
+     * @param event Event which should be handled.
+     * @param delay Process the event after 'delay', such as std::chrono::microseconds(300).
+     * @param priority Priority of the event queue for this event.
+     * @return Returns true if event has been sent successfully.
+     */
+    inline bool SendEvent(InnerEvent::Pointer &&event, std::chrono::nanoseconds delay,
+        Priority priority = Priority::LOW)
+    {
+        return SendEvent(event, delay, priority);
+    }
+
     /**
      * Send an event.
      *
@@ -470,6 +586,17 @@ public:
                         Priority priority = Priority::LOW, const Caller &caller = {},
                         VsyncBarrierOption option = VsyncBarrierOption::NO_BARRIER);
 
+    /**
+     * Post several tasks, in the order of items.
+     * All tasks are inserted into the event queue at once, which wakes up the runner at most once.
+     *
+     * @param items Tasks with their name, delay time and priority.
+     * @param caller Caller info of the tasks, default is caller's file, func and line.
+     * @return Returns true if all tasks have been posted successfully. If returns false, runners with the base event
+     * queue post no task, while FFRT runners may have posted the tasks before the first failed one.
+     */
+    bool PostTasks(const std::vector<TaskItem> &items, const Caller &caller = {});
+
     /**
      * Set delivery time out callback.
      *
@@ -490,6 +617,20 @@ public:
         distributeTimeoutCallback_ = callback;
     }
 
+    /**
+     * Enable latency histograms of events distributed by this handler, besides the ones of its runner.
+     *
+     * @param enable Enable or not, recorded latencies are kept after disabled.
+     */
+    void SetLatencyStatsEnabled(bool enable);
+
+    /**
+     * Get latency percentiles of events distributed by this handler, split by priority of events.
+     *
+     * @return Returns the snapshot of latencies, which is empty if latency histograms are never enabled.
+     */
+    LatencySnapshot GetLatencySnapshot() const;
+
     /**
      * Post a task.
      *
@@ -518,6 +659,128 @@ public:
         return PostTask(callback, std::string(), delayTime, priority, caller);
     }
 
+    /**
+     * Post a task with a delay shorter than or not a multiple of one millisecond.
+     *
+     * @param callback Task callback.
+     * @param name Name of the task.
+     * @param delay Process the event after 'delay', such as std::chrono::microseconds(300).
+     * @param priority Priority of the event queue for this event.
+     * @param caller Caller info of the event, default is caller's file, func and line.
+     * @return Returns true if task has been sent successfully.
+     */
+    inline bool PostTask(const Callback &callback, const std::string &name, std::chrono::nanoseconds delay,
+                         Priority priority = Priority::LOW, const Caller &caller = {})
+    {
+        return SendEvent(InnerEvent::Get(callback, name, caller), delay, priority);
+    }
+
+    /**
+     * Post a task with a delay shorter than or not a multiple of one millisecond.
+     *
+     * @param callback Task callback.
+     * @param delay Process the event after 'delay', such as std::chrono::microseconds(300).
+     * @param priority Priority of the event queue for this event.
+     * @param caller Caller info of the event, default is caller's file, func and line.
+     * @return Returns true if task has been sent successfully.
+     */
+    inline bool PostTask(const Callback &callback, std::chrono::nanoseconds delay, Priority priority = Priority::LOW,
+                         const Caller &caller = {})
+    {
+        return PostTask(callback, std::string(), delay, priority, caller);
+    }
+
+    /*
+     * Overloads of 'PostTask' for callables other than Callback, such as lambdas.
+     * The callable is forwarded into the event, so it is never copied, and move-only callables are accepted.
+     * Small callables are kept inside the event without allocation, see TaskCallable.
+     */
+    template<typename F, typename = std::enable_if_t<InnerEvent::IS_FORWARDED_TASK<F>>>
+    inline bool PostTask(F &&callback, const std::string &name = std::string(), int64_t delayTime = 0,
+                         Priority priority = Priority::LOW, const Caller &caller = {})
+    {
+        return SendEvent(InnerEvent::Get(std::forward<F>(callback), name, caller), delayTime, priority);
+    }
+
+    template<typename F, typename = std::enable_if_t<InnerEvent::IS_FORWARDED_TASK<F>>>
+    inline bool PostTask(F &&callback, Priority priority, const Caller &caller = {})
+    {
+        return PostTask(std::forward<F>(callback), std::string(), 0, priority, caller);
+    }
+
+    template<typename F, typename = std::enable_if_t<InnerEvent::IS_FORWARDED_TASK<F>>>
+    inline bool PostTask(F &&callback, int64_t delayTime, Priority priority = Priority::LOW,
+                         const Caller &caller = {})
+    {
+        return PostTask(std::forward<F>(callback), std::string(), delayTime, priority, caller);
+    }
+
+    template<typename F, typename = std::enable_if_t<InnerEvent::IS_FORWARDED_TASK<F>>>
+    inline bool PostTask(F &&callback, const std::string &name, std::chrono::nanoseconds delay,
+                         Priority priority = Priority::LOW, const Caller &caller = {})
+    {
+        return SendEvent(InnerEvent::Get(std::forward<F>(callback), name, caller), delay, priority);
+    }
+
+    template<typename F, typename = std::enable_if_t<InnerEvent::IS_FORWARDED_TASK<F>>>
+    inline bool PostTask(F &&callback, std::chrono::nanoseconds delay, Priority priority = Priority::LOW,
+                         const Caller &caller = {})
+    {
+        return PostTask(std::forward<F>(callback), std::string(), delay, priority, caller);
+    }
+
+    /**
+     * Post a task, or merge it into the pending task with the same key posted by this handler.
+     *
+     * @param callback Task callback.
+     * @param key Key of the task, shared by coalesced events and tasks of this handler.
+     * @param policy Replace the pending task with this one, or keep the pending one and drop this one.
+     * @param delayTime Process the task after 'delayTime' milliseconds, if no pending task is found.
+     * @param priority Priority of the event queue for this task.
+     * @param caller Caller info of the event, default is caller's file, func and line.
+     * @return Returns true if task has been posted or merged successfully.
+     */
+    inline bool PostCoalescedTask(const Callback &callback, uint64_t key,
+        CoalescePolicy policy = CoalescePolicy::REPLACE_LATEST, int64_t delayTime = 0,
+        Priority priority = Priority::LOW, const Caller &caller = {})
+    {
+        auto event = InnerEvent::Get(callback, std::string(), caller);
+        return SendCoalescedEvent(event, key, policy, delayTime, priority);
+    }
+
+    /**
+     * Post a task, and return a handle to cancel, check or reprioritize it without searching by name.
+     *
+     * @param callback Task callback.
+     * @param name Name of the task.
+     * @param delayTime Process the task after 'delayTime' milliseconds.
+     * @param priority Priority of the event queue for this task.
+     * @param caller Caller info of the event, default is caller's file, func and line.
+     * @return Returns the handle of the task, which refers to no task if the task is not posted.
+     */
+    inline TaskHandle PostTaskWithHandle(const Callback &callback, const std::string &name = std::string(),
+        int64_t delayTime = 0, Priority priority = Priority::LOW, const Caller &caller = {})
+    {
+        auto event = InnerEvent::Get(callback, name, caller);
+        return SendEventWithHandle(event, delayTime, priority);
+    }
+
+    template<typename F, typename = std::enable_if_t<InnerEvent::IS_FORWARDED_TASK<F>>>
+    inline TaskHandle PostTaskWithHandle(F &&callback, const std::string &name = std::string(), int64_t delayTime = 0,
+        Priority priority = Priority::LOW, const Caller &caller = {})
+    {
+        auto event = InnerEvent::Get(std::forward<F>(callback), name, caller);
+        return SendEventWithHandle(event, delayTime, priority);
+    }
+
+    template<typename F, typename = std::enable_if_t<InnerEvent::IS_FORWARDED_TASK<F>>>
+    inline bool PostCoalescedTask(F &&callback, uint64_t key, CoalescePolicy policy = CoalescePolicy::REPLACE_LATEST,
+        int64_t delayTime = 0, Priority priority = Priority::LOW, const Caller &caller = {})
+    {
+        auto event = InnerEvent::Get(std::forward<F>(callback), std::string(), caller);
+        return SendCoalescedEvent(event, key, policy, delayTime, priority);
+    }
+
     /**
      * Post an immediate task.
      *
@@ -731,6 +994,69 @@ public:
         return PostSyncTask(callback, std::string(), priority, caller);
     }
 
+    /**
+     * Post a task, wait until it has been handled, and hand its return value back.
+     * The value is written straight into the caller's stack, and published by the wakeup of the sync event.
+     *
+     * @param task Task returning the value.
+     * @param priority Priority of the event queue for this event, IDLE is not permitted for sync event.
+     * @param caller Caller info of the event, default is caller's file, func and line.
+     * @return Returns the value of the task, or 'EVENT_HANDLER_ERR_TASK_NOT_RUN' if it is not sent or is removed.
+     */
+    template<typename F, typename R = std::invoke_result_t<std::decay_t<F> &>,
+        typename = std::enable_if_t<InnerEvent::IS_FORWARDED_TASK<F>>>
+    TaskResult<R> PostSyncTaskWithResult(F &&task, Priority priority = Priority::LOW, const Caller &caller = {})
+    {
+        if constexpr (std::is_void_v<R>) {
+            bool ran = false;
+            bool sent = SendSyncEvent(InnerEvent::Get([&task, &ran]() {
+                task();
+                ran = true;
+            }, std::string(), caller), priority);
+            return (sent && ran) ? TaskResult<R>(std::in_place) : TaskResult<R>(EVENT_HANDLER_ERR_TASK_NOT_RUN);
+        } else {
+            std::optional<R> value;
+            bool sent = SendSyncEvent(InnerEvent::Get([&task, &value]() {
+                value.emplace(task());
+            }, std::string(), caller), priority);
+            if (!sent || !value.has_value()) {
+                return TaskResult<R>(EVENT_HANDLER_ERR_TASK_NOT_RUN);
+            }
+            return TaskResult<R>(std::in_place, std::move(*value));
+        }
+    }
+
+    /**
+     * Post a task, and get a future of its return value without blocking.
+     * The future shares one allocation with the posted task, and its continuation can be scheduled onto any handler.
+     *
+     * @param task Task returning the value.
+     * @param delayTime Process the task after 'delayTime' milliseconds.
+     * @param priority Priority of the event queue for this event.
+     * @param caller Caller info of the event, default is caller's file, func and line.
+     * @return Returns the future, which completes with 'EVENT_HANDLER_ERR_TASK_NOT_RUN' if the task is not sent or
+     *     is removed.
+     */
+    template<typename F, typename R = std::invoke_result_t<std::decay_t<F> &>,
+        typename = std::enable_if_t<InnerEvent::IS_FORWARDED_TASK<F>>>
+    TaskFuture<R> PostTaskForResult(F &&task, int64_t delayTime = 0, Priority priority = Priority::LOW,
+        const Caller &caller = {})
+    {
+        TaskPromise<R> promise;
+        auto future = TaskFuture<R>::Create(promise);
+        auto event = InnerEvent::Get([promise = std::move(promise), task = std::forward<F>(task)]() mutable {
+            if constexpr (std::is_void_v<R>) {
+                task();
+                promise.SetValue();
+            } else {
+                promise.SetValue(task());
+            }
+        }, std::string(), caller);
+        // A failed send drops the event, and with it the promise, which completes the future.
+        SendEvent(event, delayTime, priority);
+        return future;
+    }
+
     /**
      * Send a timing event.
      *
@@ -969,6 +1295,44 @@ public:
      */
     void RemoveFileDescriptorListener(int32_t fileDescriptor);
 
+#ifdef EVENT_HANDLER_COROUTINE_SUPPORT
+    /**
+     * Suspend the coroutine, and resume it from a task posted to this handler.
+     * The resuming task is a pooled event holding only the coroutine handle, so no allocation is made for a hop.
+     * 'co_await' returns false if the task could not be posted, the coroutine is then resumed at once.
+     *
+     * @param priority Priority of the resuming task.
+     */
+    inline ScheduleAwaiter Schedule(Priority priority = Priority::LOW);
+
+    /**
+     * Suspend the coroutine, and resume it on this handler after 'delay'.
+     *
+     * @param delay Delay of resuming.
+     * @param priority Priority of the resuming task.
+     */
+    inline ScheduleAwaiter Delay(std::chrono::nanoseconds delay, Priority priority = Priority::LOW);
+
+    /**
+     * Continue the coroutine on the runner of this handler, without suspending if it is already running there.
+     * On a concurrent runner, it is only skipped while running an event of this handler.
+     *
+     * @param priority Priority of the resuming task.
+     */
+    inline ScheduleAwaiter SwitchTo(Priority priority = Priority::LOW);
+
+    /**
+     * Suspend the coroutine until the file descriptor is ready, and resume it on this handler.
+     * The listener is removed before resuming, so the file descriptor can be awaited again at once.
+     * 'co_await' returns the ready events, or 0 if the listener could not be added.
+     *
+     * @param fileDescriptor File descriptor to wait for.
+     * @param events Events to wait for, FILE_DESCRIPTOR_INPUT_EVENT or FILE_DESCRIPTOR_OUTPUT_EVENT.
+     * @param priority Priority of the resuming task.
+     */
+    inline FileDescriptorAwaiter WaitFd(int32_t fileDescriptor, uint32_t events, Priority priority = Priority::HIGH);
+#endif
+
     /**
      * Set the 'EventRunner' to the 'EventHandler'.
      *
@@ -1016,6 +1380,14 @@ public:
      */
     void DeliveryTimeAction(const InnerEvent::Pointer &event, InnerEvent::TimePoint nowStart);
 
+    /**
+     * Record latencies of a distributed event.
+     *
+     * @param event The event which is distributed.
+     * @param nowStart Dotting before distribution.
+     */
+    void RecordLatency(const InnerEvent::Pointer &event, InnerEvent::TimePoint nowStart);
+
     /**
      * Check whether there are events which priority higher than current event. Currently ONLY applicable to
      * the main thread, otherwise it will result in problematic returns.
@@ -1073,6 +1445,16 @@ public:
      */
     bool IsIdle();
 
+    /**
+     * Check whether events of this handler could be distributed on the current thread directly.
+     * It is true on the thread of the event runner. On a concurrent runner, it is true only while this handler is
+     * distributing an event on the current thread, including the outer ones of sync events handled on the thread,
+     * because other threads may distribute events of this handler.
+     *
+     * @return Returns true if events of this handler could be distributed on the current thread directly.
+     */
+    bool CanDistributeOnCurrentThread();
+
     /**
      * @param enableEventLog dump event log handle time.
      */
@@ -1081,7 +1463,7 @@ public:
     /**
      * Get handler id, only for inner use
      */
-    inline std::string GetHandlerId()
+    inline uint64_t GetHandlerId() const
     {
         return handlerId_;
     }
@@ -1193,12 +1575,46 @@ private:
      */
     InnerEvent::Pointer CreateTask(const Callback &callback, const std::string &name,
         Priority priority, const Caller &caller);
+
+    /**
+     * Fill in the sending information of an event.
+     *
+     * @param event Event which should be sent.
+     * @param delay Process the event after 'delay'.
+     * @param now Time of sending.
+     */
+    void PrepareToSend(InnerEvent::Pointer &event, std::chrono::nanoseconds delay, const InnerEvent::TimePoint &now);
+
+    /**
+     * Send an event, and get the unique id assigned to it.
+     *
+     * @param event Event which should be handled.
+     * @param delay Process the event after 'delay'.
+     * @param priority Priority of the event queue for this event.
+     * @param eventUniqueId Unique id of the sent event.
+     * @return Returns true if event has been sent successfully.
+     */
+    bool SendEvent(InnerEvent::Pointer &event, std::chrono::nanoseconds delay, Priority priority,
+        uint64_t &eventUniqueId);
+
+    /**
+     * Distribute a sync event on the current thread of a concurrent runner, if no other thread of the runner is
+     * distributing events of this handler, instead of waiting for a free thread which may never come.
+     *
+     * @param event Event which should be handled.
+     * @return Returns true if the event has been distributed.
+     */
+    bool DistributeOnIdleConcurrentThread(const InnerEvent::Pointer &event);
     
-    std::string handlerId_;
+    uint64_t handlerId_ {0};
     bool enableEventLog_ {false};
     std::shared_ptr<EventRunner> eventRunner_;
     CallbackTimeout deliveryTimeoutCallback_;
     CallbackTimeout distributeTimeoutCallback_;
+    std::once_flag latencyStatsOnce_;
+    std::unique_ptr<LatencyStats> latencyStats_;
+    std::atomic<bool> latencyStatsCreated_ {false};
+    std::atomic<bool> latencyStatsEnabled_ {false};
     EVENTHANDLER_HIDDEN static thread_local std::weak_ptr<EventHandler> currentEventHandler;
     EVENTHANDLER_HIDDEN static thread_local int32_t currentEventPriority;
 };
@@ -1206,4 +1622,8 @@ private:
 namespace EventHandling = AppExecFwk;
 }  // namespace OHOS
 
+#ifdef EVENT_HANDLER_COROUTINE_SUPPORT
+#include "event_handler_coroutine.h"
+#endif
+
 #endif  // #ifndef BASE_EVENTHANDLER_INTERFACES_INNER_API_EVENT_HANDLER_H
@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BASE_EVENTHANDLER_INTERFACES_INNER_API_EVENT_HANDLER_COROUTINE_H
+#define BASE_EVENTHANDLER_INTERFACES_INNER_API_EVENT_HANDLER_COROUTINE_H
+
+#include "event_handler.h"
+
+#ifdef EVENT_HANDLER_COROUTINE_SUPPORT
+#include <chrono>
+#include <coroutine>
+#include <cstdlib>
+#include <memory>
+#include <utility>
+
+#include "file_descriptor_listener.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+/*
+ * Return type of coroutines driven by event handlers, the coroutine starts at once and is detached from the caller.
+ * Its frame is released when it returns, or when the task resuming it is dropped, for example removed from the
+ * queue, just like captures of a removed task are released.
+ */
+class EventCoroutine final {
+public:
+    struct promise_type {
+        EventCoroutine get_return_object() noexcept
+        {
+            return EventCoroutine();
+        }
+
+        std::suspend_never initial_suspend() noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never final_suspend() noexcept
+        {
+            return {};
+        }
+
+        void return_void() noexcept {}
+
+        void unhandled_exception() noexcept
+        {
+            std::abort();
+        }
+    };
+};
+
+/*
+ * Slot of the suspended coroutine, kept by the awaiter inside the coroutine frame.
+ * Whoever takes the handle first, either to resume or to destroy the frame, empties the slot.
+ */
+class CoroutineSlot final {
+public:
+    CoroutineSlot() = default;
+    explicit CoroutineSlot(std::coroutine_handle<> *handle) : handle_(handle) {}
+    CoroutineSlot(CoroutineSlot &&other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+    CoroutineSlot &operator=(CoroutineSlot &&) = delete;
+    CoroutineSlot(const CoroutineSlot &) = delete;
+    CoroutineSlot &operator=(const CoroutineSlot &) = delete;
+
+    ~CoroutineSlot()
+    {
+        auto handle = Take();
+        if (handle) {
+            handle.destroy();
+        }
+    }
+
+    inline void Resume()
+    {
+        auto handle = Take();
+        if (handle) {
+            handle.resume();
+        }
+    }
+
+private:
+    // The frame may be gone once resumed, so the slot is detached before.
+    inline std::coroutine_handle<> Take()
+    {
+        if (handle_ == nullptr) {
+            return nullptr;
+        }
+        return std::exchange(*std::exchange(handle_, nullptr), nullptr);
+    }
+
+    std::coroutine_handle<> *handle_ {nullptr};
+};
+
+/*
+ * Awaiter of 'EventHandler::Schedule', 'EventHandler::Delay' and 'EventHandler::SwitchTo'.
+ * The resuming task holds a pointer only, so it is kept inside TaskCallable of a pooled event.
+ */
+class ScheduleAwaiter final {
+public:
+    ScheduleAwaiter(EventHandler &handler, std::chrono::nanoseconds delay, EventQueue::Priority priority,
+        bool skipOnRunner) : handler_(handler), delay_(delay), priority_(priority), skipOnRunner_(skipOnRunner) {}
+    ~ScheduleAwaiter() = default;
+
+    inline bool await_ready() const
+    {
+        if (!skipOnRunner_) {
+            return false;
+        }
+        return handler_.CanDistributeOnCurrentThread();
+    }
+
+    inline bool await_suspend(std::coroutine_handle<> handle)
+    {
+        handle_ = handle;
+        posted_ = true;
+        auto event = InnerEvent::Get([slot = CoroutineSlot(&handle_)]() mutable { slot.Resume(); });
+        if (handler_.SendEvent(event, delay_, priority_)) {
+            // The coroutine may be running on the runner already, this awaiter must not be touched any more.
+            return true;
+        }
+        // Empty the slot first, so that releasing the failed event does not destroy the frame.
+        handle_ = nullptr;
+        posted_ = false;
+        return false;
+    }
+
+    inline bool await_resume() const noexcept
+    {
+        return posted_;
+    }
+
+private:
+    EventHandler &handler_;
+    std::chrono::nanoseconds delay_;
+    EventQueue::Priority priority_;
+    bool skipOnRunner_ {false};
+    bool posted_ {true};
+    std::coroutine_handle<> handle_;
+};
+
+/*
+ * Listener resuming the coroutine awaiting 'EventHandler::WaitFd' on the first ready event.
+ */
+class CoroutineFileDescriptorListener final : public FileDescriptorListener {
+public:
+    CoroutineFileDescriptorListener(std::coroutine_handle<> *handle, uint32_t *readyEvents) : slot_(handle),
+        readyEvents_(readyEvents) {}
+    ~CoroutineFileDescriptorListener() final = default;
+    DISALLOW_COPY_AND_MOVE(CoroutineFileDescriptorListener);
+
+    void OnReadable(int32_t fileDescriptor) final
+    {
+        Resume(fileDescriptor, FILE_DESCRIPTOR_INPUT_EVENT);
+    }
+
+    void OnWritable(int32_t fileDescriptor) final
+    {
+        Resume(fileDescriptor, FILE_DESCRIPTOR_OUTPUT_EVENT);
+    }
+
+    void OnShutdown(int32_t fileDescriptor) final
+    {
+        Resume(fileDescriptor, FILE_DESCRIPTOR_SHUTDOWN_EVENT);
+    }
+
+    void OnException(int32_t fileDescriptor) final
+    {
+        Resume(fileDescriptor, FILE_DESCRIPTOR_EXCEPTION_EVENT);
+    }
+
+private:
+    inline void Resume(int32_t fileDescriptor, uint32_t events)
+    {
+        if (readyEvents_ == nullptr) {
+            return;
+        }
+        *std::exchange(readyEvents_, nullptr) = events;
+        auto owner = GetOwner();
+        if (owner) {
+            owner->RemoveFileDescriptorListener(fileDescriptor);
+        }
+        slot_.Resume();
+    }
+
+    CoroutineSlot slot_;
+    uint32_t *readyEvents_ {nullptr};
+};
+
+/*
+ * Awaiter of 'EventHandler::WaitFd'.
+ */
+class FileDescriptorAwaiter final {
+public:
+    FileDescriptorAwaiter(EventHandler &handler, int32_t fileDescriptor, uint32_t events,
+        EventQueue::Priority priority) : handler_(handler), fileDescriptor_(fileDescriptor), events_(events),
+        priority_(priority) {}
+    ~FileDescriptorAwaiter() = default;
+
+    inline bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    inline bool await_suspend(std::coroutine_handle<> handle)
+    {
+        handle_ = handle;
+        auto listener = std::make_shared<CoroutineFileDescriptorListener>(&handle_, &readyEvents_);
+        if (handler_.AddFileDescriptorListener(fileDescriptor_, events_, listener, std::string(), priority_) ==
+            ERR_OK) {
+            // The coroutine may be running on the runner already, this awaiter must not be touched any more.
+            return true;
+        }
+        // Empty the slot first, so that releasing the listener does not destroy the frame.
+        handle_ = nullptr;
+        return false;
+    }
+
+    inline uint32_t await_resume() const noexcept
+    {
+        return readyEvents_;
+    }
+
+private:
+    EventHandler &handler_;
+    int32_t fileDescriptor_ {-1};
+    uint32_t events_ {0};
+    EventQueue::Priority priority_;
+    uint32_t readyEvents_ {0};
+    std::coroutine_handle<> handle_;
+};
+
+inline ScheduleAwaiter EventHandler::Schedule(Priority priority)
+{
+    return ScheduleAwaiter(*this, std::chrono::nanoseconds::zero(), priority, false);
+}
+
+inline ScheduleAwaiter EventHandler::Delay(std::chrono::nanoseconds delay, Priority priority)
+{
+    return ScheduleAwaiter(*this, delay, priority, false);
+}
+
+inline ScheduleAwaiter EventHandler::SwitchTo(Priority priority)
+{
+    return ScheduleAwaiter(*this, std::chrono::nanoseconds::zero(), priority, true);
+}
+
+inline FileDescriptorAwaiter EventHandler::WaitFd(int32_t fileDescriptor, uint32_t events, Priority priority)
+{
+    return FileDescriptorAwaiter(*this, fileDescriptor, events, priority);
+}
+}  // namespace AppExecFwk
+}  // namespace OHOS
+#endif  // #ifdef EVENT_HANDLER_COROUTINE_SUPPORT
+
+#endif  // #ifndef BASE_EVENTHANDLER_INTERFACES_INNER_API_EVENT_HANDLER_COROUTINE_H
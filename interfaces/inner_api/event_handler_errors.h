@@ -39,6 +39,8 @@ enum {
     EVENT_HANDLER_ERR_RUNNER_NO_PERMIT,
     // Event runner is already running.
     EVENT_HANDLER_ERR_RUNNER_ALREADY,
+    // Task was not sent, or was removed before running, so it has no result.
+    EVENT_HANDLER_ERR_TASK_NOT_RUN,
 };
 }  // namespace AppExecFwk
 }  // namespace OHOS
@@ -22,6 +22,7 @@
 #include <list>
 #include <map>
 #include <mutex>
+#include <vector>
 
 #include "inner_event.h"
 #include "event_handler_errors.h"
@@ -49,6 +50,22 @@ enum class EventInsertType: uint32_t {
     AT_FRONT
 };
 
+enum class WaitStrategy: uint32_t {
+    // Block on a condition variable, notifying always locks a mutex
+    BLOCK = 0,
+    // Spin for a short while before parking on a futex, for producers sending within microseconds
+    SPIN_THEN_PARK,
+    // Park on a futex at once, notifying only makes a system call if the runner is parked
+    FUTEX
+};
+
+enum class CoalescePolicy: uint32_t {
+    // Replace content of the pending event with the latest one, and keep its position in queue
+    REPLACE_LATEST = 0,
+    // Keep the pending event, and drop the latest one
+    KEEP_FIRST
+};
+
 enum class Observer {
     ARKTS_GC,
 };
@@ -153,6 +170,12 @@ public:
     virtual ~EventQueue();
     DISALLOW_COPY_AND_MOVE(EventQueue);
 
+    // Event to insert together with other events.
+    struct InsertItem {
+        InnerEvent::Pointer event {nullptr, nullptr};
+        Priority priority {Priority::LOW};
+    };
+
     /**
      * Insert an event into event queue with different priority.
      * The events will be sorted by handle time.
@@ -167,6 +190,81 @@ public:
         EventInsertType insertType = EventInsertType::AT_END,
         VsyncBarrierOption option = VsyncBarrierOption::NO_BARRIER) = 0;
 
+    /**
+     * Insert events into event queue at the end, in the order of items.
+     * Base queue inserts all of them under one lock and wakes up the runner at most once, or inserts none of them.
+     * Other queues insert them one by one, and stop at the first one failed to insert.
+     *
+     * @param items Events and their priority, inserted events are moved out of items.
+     * @return Returns true if all events are inserted.
+     */
+    virtual bool InsertEvents(std::vector<InsertItem> &items)
+    {
+        for (auto &item : items) {
+            if (!Insert(item.event, item.priority)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Insert an event, or merge it into the pending event with the same key from the same handler.
+     * Only events with the same priority are merged, and the merged event is released.
+     * Queues without coalescing support insert the event as usual.
+     *
+     * @param event Event instance which should be added into event queue.
+     * @param priority Priority of the event.
+     * @param key Key of the event, shared by events and tasks of the handler.
+     * @param policy How to merge the event into the pending one.
+     * @return Returns true if the event is inserted or merged.
+     */
+    virtual bool InsertCoalesced(InnerEvent::Pointer &event, Priority priority, uint64_t key, CoalescePolicy policy)
+    {
+        (void)key;
+        (void)policy;
+        return Insert(event, priority);
+    }
+
+    /**
+     * Remove a pending event which a task handle is returned for, for base queue.
+     *
+     * @param eventUniqueId Unique id of the event.
+     * @return Returns true if the event is removed.
+     */
+    virtual bool CancelByHandle(uint64_t eventUniqueId)
+    {
+        (void)eventUniqueId;
+        return false;
+    }
+
+    /**
+     * Check whether an event which a task handle is returned for is still pending, for base queue.
+     *
+     * @param eventUniqueId Unique id of the event.
+     * @return Returns true if the event is pending.
+     */
+    virtual bool IsPendingByHandle(uint64_t eventUniqueId)
+    {
+        (void)eventUniqueId;
+        return false;
+    }
+
+    /**
+     * Move a pending event which a task handle is returned for into another priority, for base queue.
+     * The event keeps its handle time, and is placed after events with the same handle time of that priority.
+     *
+     * @param eventUniqueId Unique id of the event.
+     * @param priority New priority of the event.
+     * @return Returns true if the event is pending and moved.
+     */
+    virtual bool ReprioritizeByHandle(uint64_t eventUniqueId, Priority priority)
+    {
+        (void)eventUniqueId;
+        (void)priority;
+        return false;
+    }
+
     /**
      * Remove events if its owner is invalid, for base queue.
      */
@@ -177,6 +275,35 @@ public:
      */
     virtual void RemoveOrphanByHandlerId(const std::string& handlerId) { (void)handlerId; };
 
+    /**
+     * Enable or disable the lock free inbox, for base queue.
+     * When enabled, events sent from other threads without special requirement are pushed into the inbox without
+     * taking the queue lock, and moved into the queue by the runner.
+     *
+     * @param enable Enable or not.
+     */
+    virtual void SetInboxEnabled(bool enable) { (void)enable; };
+
+    /**
+     * Enable or disable high resolution waiting.
+     * When enabled, the runner waiting with epoll wakes up at the exact handle time of delayed events,
+     * instead of rounding the timeout up to milliseconds.
+     *
+     * @param enable Enable or not.
+     */
+    void SetHighResolutionWait(bool enable);
+
+    /**
+     * Set how the runner waits for events, if it is not listening to file descriptors.
+     * Runners listening to file descriptors always wait with epoll.
+     * Spinning and futex strategies park on a single futex word, which supports only one waiting thread, so they
+     * are rejected for queues shared by several threads, or if more than one thread is waiting on the queue.
+     *
+     * @param strategy Wait strategy.
+     * @return Returns false if the strategy is rejected, the queue keeps waiting with the current one then.
+     */
+    bool SetWaitStrategy(WaitStrategy strategy);
+
     /**
      * Remove all events.
      */
@@ -324,6 +451,20 @@ public:
 
     virtual void PushHistoryQueueAfterDistribute() {}
 
+    /**
+     * Set how many dispatched events are kept for dumping, for base queue.
+     *
+     * @param depth Number of events, rounded up to power of 2, 0 disables the history.
+     */
+    virtual void SetHistoryDepth(uint32_t depth) { (void)depth; }
+
+    /**
+     * Set how many pending events of each priority are dumped, for base queue.
+     *
+     * @param maxEvents Max number of events of each priority, the rest are only counted.
+     */
+    virtual void SetMaxDumpEventsPerPriority(uint32_t maxEvents) { (void)maxEvents; }
+
     virtual bool HasPreferEvent(int basePrio) = 0;
 
     virtual std::string DumpCurrentQueueSize() = 0;
@@ -516,6 +657,45 @@ protected:
     void HandleFileDescriptorEvent(int32_t fileDescriptor, uint32_t events, const std::string &name,
         Priority priority);
 
+    /**
+     * Check whether several threads take events from this queue, called with the queue lock held.
+     *
+     * @return Returns true if the queue has several consumer threads.
+     */
+    virtual bool IsMultiConsumerLocked() const
+    {
+        return false;
+    }
+
+    /**
+     * Record events of a listener in direct dispatch mode, which are dispatched by the runner loop later.
+     *
+     * @param fileDescriptor File descriptor.
+     * @param events Events from file descriptor, such as input, output, error
+     * @param listener Listener of the file descriptor.
+     * @param Priority Priority of the listener.
+     * @return Returns false if direct dispatch is not supported, then a task should be posted instead.
+     */
+    virtual bool RecordReadyFileDescriptor(int32_t fileDescriptor, uint32_t events,
+        const std::shared_ptr<FileDescriptorListener> &listener, Priority priority)
+    {
+        (void)fileDescriptor;
+        (void)events;
+        (void)listener;
+        (void)priority;
+        return false;
+    }
+
+    /**
+     * Call the listener for events of file descriptor.
+     *
+     * @param listener Listener of the file descriptor.
+     * @param fileDescriptor File descriptor.
+     * @param events Events from file descriptor, such as input, output, error
+     */
+    static void DispatchFileDescriptorEvents(const std::shared_ptr<FileDescriptorListener> &listener,
+        int32_t fileDescriptor, uint32_t events);
+
     /**
      * remove listener by owner.
      *
@@ -556,6 +736,10 @@ protected:
     // select different epoll
     bool useDeamonIoWaiter_ = false;
 
+    // Apply to IO waiters created later.
+    bool highResolutionWait_ = false;
+    WaitStrategy waitStrategy_ = WaitStrategy::BLOCK;
+
     // File descriptor listeners to handle IO events.
     std::map<int32_t, std::shared_ptr<FileDescriptorListener>> listeners_;
 
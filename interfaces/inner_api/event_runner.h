@@ -17,11 +17,14 @@
 #define BASE_EVENTHANDLER_INTERFACES_INNER_API_EVENT_RUNNER_H
 
 #include <atomic>
+#include <memory>
+#include <mutex>
 
 #include "event_queue.h"
 #include "dumper.h"
 #include "event_inner_logger.h"
 #include "inner_event.h"
+#include "latency_histogram.h"
 #include "local_handle_adapter.h"
 
 namespace OHOS {
@@ -37,6 +40,7 @@ enum class Mode: uint32_t {
 enum class ThreadMode: uint32_t {
     NEW_THREAD = 0,    // for new thread mode, event handler create thread
     FFRT,           // for new thread mode, use ffrt
+    POOL,           // run on a bounded pool of threads shared by runners, only while there are due events
 };
 
 class EventRunner final {
@@ -66,12 +70,64 @@ public:
      * Create new 'EventRunner'.
      *
      * @param inNewThread True if create new thread to start the 'EventRunner' automatically.
-     * @param threadMode thread mode, use ffrt or new thread, for inNewThread = true.
+     * @param threadMode thread mode, use ffrt, new thread or the shared pool, for inNewThread = true.
      * @return Returns shared pointer of the new 'EventRunner'.
      */
     static std::shared_ptr<EventRunner> Create(bool inNewThread, ThreadMode threadMode,
  	    EventLockType lockType = EventLockType::STANDARD);
 
+    /**
+     * Create new 'EventRunner' which waits for events with the given strategy.
+     *
+     * @param inNewThread True if create new thread to start the 'EventRunner' automatically.
+     * @param waitStrategy How the runner waits for events, if it is not listening to file descriptors.
+     * @return Returns shared pointer of the new 'EventRunner'.
+     */
+    static std::shared_ptr<EventRunner> Create(bool inNewThread, WaitStrategy waitStrategy,
+        EventLockType lockType = EventLockType::STANDARD);
+
+    /**
+     * Create new 'EventRunner' which waits for events with the given strategy, and start to run in a new thread.
+     *
+     * @param threadName Thread name of the new created thread.
+     * @param waitStrategy How the runner waits for events, if it is not listening to file descriptors.
+     * @return Returns shared pointer of the new 'EventRunner'.
+     */
+    static std::shared_ptr<EventRunner> Create(const std::string &threadName, WaitStrategy waitStrategy,
+        EventLockType lockType = EventLockType::STANDARD);
+
+    /**
+     * Create new 'EventRunner' which waits for events with the given strategy, and start to run in a new thread.
+     * Eliminate ambiguity, while calling like 'EventRunner::Create("threadName", WaitStrategy::FUTEX)'.
+     *
+     * @param threadName Thread name of the new created thread.
+     * @param waitStrategy How the runner waits for events, if it is not listening to file descriptors.
+     * @return Returns shared pointer of the new 'EventRunner'.
+     */
+    static inline std::shared_ptr<EventRunner> Create(const char *threadName, WaitStrategy waitStrategy,
+        EventLockType lockType = EventLockType::STANDARD)
+    {
+        return Create((threadName != nullptr) ? std::string(threadName) : std::string(), waitStrategy, lockType);
+    }
+
+    // Max number of threads of a runner created by 'CreateConcurrent'.
+    static constexpr uint32_t MAX_CONSUMER_NUM = 64;
+
+    /**
+     * Create new 'EventRunner' whose events are handled by several new threads sharing its queue.
+     * Events of one 'EventHandler' are still handled one by one in order, while events of different handlers run in
+     * parallel. Such runners could not listen to file descriptors.
+     * A sync event sent to another handler of the runner is handled on the sending thread, if no other thread is
+     * handling events of that handler, otherwise the sending thread waits for it. So sync events do not use up the
+     * threads, but handlers sending sync events to each other in a cycle still deadlock.
+     *
+     * @param threadName Thread name of the new created threads.
+     * @param consumerNum Number of the new created threads, from 1 to 'MAX_CONSUMER_NUM'.
+     * @return Returns shared pointer of the new 'EventRunner', or nullptr if 'consumerNum' is invalid.
+     */
+    static std::shared_ptr<EventRunner> CreateConcurrent(const std::string &threadName, uint32_t consumerNum,
+        EventLockType lockType = EventLockType::STANDARD);
+
     /**
      * Create new 'EventRunner' and start to run in a new thread.
      *
@@ -89,7 +145,7 @@ public:
      * Create new 'EventRunner' and start to run in a new thread.
      *
      * @param threadName Thread name of the new created thread.
-     * @param threadMode thread mode, use ffrt or new thread.
+     * @param threadMode thread mode, use ffrt, new thread or the shared pool.
      * @return Returns shared pointer of the new 'EventRunner'.
      */
     static std::shared_ptr<EventRunner> Create(const std::string &threadName, ThreadMode threadMode,
@@ -118,7 +174,7 @@ public:
      * Eliminate ambiguity, while calling like 'EventRunner::Create("threadName")'.
      *
      * @param threadName Thread name of the new created thread.
-     * @param threadMode thread mode, use ffrt or new thread.
+     * @param threadMode thread mode, use ffrt, new thread or the shared pool.
      * @return Returns shared pointer of the new 'EventRunner'.
      */
     static inline std::shared_ptr<EventRunner> Create(const char *threadName, ThreadMode threadMode,
@@ -158,6 +214,22 @@ public:
      */
     std::string GetRunnerThreadName() const;
 
+    /**
+     * Enable latency histograms of events distributed by this runner, which are allocated when first enabled.
+     *
+     * @param enable Enable or not, recorded latencies are kept after disabled.
+     */
+    void SetLatencyStatsEnabled(bool enable);
+
+    /**
+     * Get latency percentiles of events distributed by this runner, split by priority of events.
+     * Delivery latency is the time from handle time of an event until it is distributed, distribute latency is the
+     * time spent in distributing it.
+     *
+     * @return Returns the snapshot of latencies, which is empty if latency histograms are never enabled.
+     */
+    LatencySnapshot GetLatencySnapshot() const;
+
     /**
      * Get event queue from event runner.
      * This method only called by 'EventHandler'.
@@ -201,15 +273,17 @@ public:
 
     /**
      * Obtain the ID of the worker thread associated with this EventRunner.
+     * A runner of 'ThreadMode::POOL' has no thread of its own, so 0 is returned.
      *
-     * @return thread id.
+     * @return thread id, or 0 if there is no such thread.
      */
     uint64_t GetThreadId();
 
     /**
      * Obtain the kernel thread ID of the worker thread associated with this EventRunner.
+     * A runner of 'ThreadMode::POOL' has no thread of its own, so 0 is returned.
      *
-     * @return kernel thread id.
+     * @return kernel thread id, or 0 if there is no such thread.
      */
     uint64_t GetKernelThreadId();
 
@@ -404,6 +478,10 @@ private:
     ThreadMode threadMode_ = ThreadMode::NEW_THREAD;
     std::string runnerId_;
     void* env_{nullptr};
+    std::once_flag latencyStatsOnce_;
+    std::unique_ptr<LatencyStats> latencyStats_;
+    std::atomic<bool> latencyStatsCreated_ {false};
+    std::atomic<bool> latencyStatsEnabled_ {false};
 };
 }  // namespace AppExecFwk
 namespace EventHandling = AppExecFwk;
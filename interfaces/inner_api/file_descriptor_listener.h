@@ -133,6 +133,28 @@ public:
     {
         return type_ == LTYPE_VSYNC;
     }
+
+    /**
+     * Dispatch events of the file descriptor from the runner loop directly, instead of posting a task for each
+     * readiness. Events happened before the listener is called are merged into one call.
+     * Not applied to vsync listeners and listeners on daemon waiter.
+     * The listener is still called inside a pooled task of its owner, so 'EventHandler::Current()', history and
+     * watchdog are the same as the posted tasks, and events of the owner are dropped with it.
+     *
+     * @param enable Enable direct dispatch or not.
+     */
+    inline void SetDirectDispatch(bool enable)
+    {
+        directDispatch_ = enable;
+    }
+
+    /**
+     * Check whether the listener is dispatched directly.
+     */
+    inline bool IsDirectDispatch() const
+    {
+        return directDispatch_;
+    }
 protected:
     FileDescriptorListener() = default;
     virtual ~FileDescriptorListener() = default;
@@ -140,6 +162,7 @@ protected:
 private:
     std::weak_ptr<EventHandler> owner_;
     bool isDeamonWaiter_{false};
+    bool directDispatch_{false};
     enum ListenerType type_ = LTYPE_UNKNOW;
 };
 }  // namespace AppExecFwk
@@ -20,11 +20,14 @@
 #include <chrono>
 #include <functional>
 #include <memory>
+#include <new>
 #include <string>
+#include <type_traits>
 #include <typeinfo>
 #include <variant>
 
 #include "nocopyable.h"
+#include "task_callable.h"
 
 namespace OHOS {
 namespace HiviewDFX {
@@ -36,32 +39,43 @@ constexpr static uint32_t TYPE_U32_INDEX = 0u;
 using HiTraceId = OHOS::HiviewDFX::HiTraceId;
 
 class EventHandler;
+class PendingEventStore;
+class EventInbox;
 
 constexpr const char* LINE_SEPARATOR = "\n";
 
+/**
+ * Where an event is sent from.
+ * Only pointers are kept, 'file_' and 'func_' point to string literals of the call site, 'dfxName_' points to a
+ * literal or a string interned by 'Caller::Intern', so capturing a caller never allocates, formatting is deferred
+ * until dump, trace or crash time.
+ */
 struct Caller {
-    std::string file_ {""};
+    const char *file_ {""};
     int         line_ {0};
-    std::string func_ {""};
-    std::string dfxName_ {""};
+    const char *func_ {""};
+    const char *dfxName_ {""};
 #if __has_builtin(__builtin_FILE)
-    Caller(std::string file = __builtin_FILE(), int line = __builtin_LINE(),
-           std::string func = __builtin_FUNCTION())
+    Caller(const char *file = __builtin_FILE(), int line = __builtin_LINE(),
+           const char *func = __builtin_FUNCTION())
         : file_(file), line_(line), func_(func) {}
 #else
     Caller() {}
 #endif
     std::string ToString() const
     {
-        if (file_.empty()) {
+        if (file_ == nullptr || file_[0] == '\0') {
             return std::string("[ ]");
         }
-        size_t split = file_.find_last_of("/\\");
-        if (split == std::string::npos) {
-            split = 0;
+        const char *fileName = file_;
+        for (const char *cur = file_; *cur != '\0'; ++cur) {
+            if (*cur == '/' || *cur == '\\') {
+                fileName = cur + 1;
+            }
         }
-        std::string caller("[" + file_.substr(split + 1) + "(" + func_ + ":" + std::to_string(line_) +
-            dfxName_ + ")]");
+        std::string caller("[");
+        caller.append(fileName).append("(").append(func_).append(":").append(std::to_string(line_))
+            .append(dfxName_).append(")]");
         return caller;
     }
 
@@ -69,8 +83,17 @@ struct Caller {
     {
         file_ = "";
         func_ = "";
+        dfxName_ = "";
         line_ = 0;
     }
+
+    /**
+     * Intern a name which is not a string literal, such as a dfx name, it is kept until the process exits.
+     *
+     * @param name Name to intern.
+     * @return Returns a pointer which could be stored into 'dfxName_', empty string if too many names are interned.
+     */
+    static const char *Intern(const std::string &name);
 };
 
 class InnerEvent final {
@@ -80,6 +103,11 @@ public:
     using Callback = std::function<void()>;
     using Pointer = std::unique_ptr<InnerEvent, void (*)(InnerEvent *)>;
     using EventId = std::variant<uint32_t, std::string>;
+    static constexpr size_t INLINE_PAYLOAD_SIZE = 32;
+    // Callables which are forwarded as TaskCallable, instead of being copied into Callback.
+    template<typename F, typename D = std::decay_t<F>>
+    static constexpr bool IS_FORWARDED_TASK = !std::is_same_v<D, Callback> && !std::is_same_v<D, TaskCallable> &&
+        std::is_invocable_v<D &>;
     class Waiter {
     public:
         Waiter() = default;
@@ -400,6 +428,43 @@ public:
         return event;
     }
 
+    /*
+     * Id of an event passed to 'Emplace', which also captures the caller of 'Emplace' while converted from the id,
+     * since the arguments of the payload leave no room for a default caller argument.
+     */
+    struct EmplaceId {
+        EventId id;
+        Caller caller;
+
+        EmplaceId(uint32_t innerEventId, const Caller &from = {}) : id(innerEventId), caller(from) {}
+
+        template<typename I, typename D = std::decay_t<I>,
+            typename = std::enable_if_t<!std::is_arithmetic_v<D> && !std::is_enum_v<D> &&
+                std::is_constructible_v<EventId, I &&>>>
+        EmplaceId(I &&innerEventId, const Caller &from = {}) : id(std::forward<I>(innerEventId)), caller(from) {}
+    };
+
+    /**
+     * Get InnerEvent instance from pool, and construct a payload of type 'T' in it.
+     * Trivially copyable payloads up to INLINE_PAYLOAD_SIZE bytes are kept inside the event without allocation,
+     * others are kept by a unique pointer, just like the ones passed to 'Get'.
+     * Payloads are matched by the name of 'T', so types in unnamed namespaces of different translation units with
+     * the same name are taken as the same type, do not pass such payloads between translation units.
+     *
+     * @param innerEventId The id of the event, the caller is captured with it.
+     * @param args Arguments to construct the payload.
+     * @return Returns the pointer of InnerEvent instance.
+     */
+    template<typename T, typename... Args>
+    static inline Pointer Emplace(const EmplaceId &innerEventId, Args &&...args)
+    {
+        auto event = Get(innerEventId.id, 0, innerEventId.caller);
+        if (event != nullptr) {
+            event->EmplacePayload<T>(std::forward<Args>(args)...);
+        }
+        return event;
+    }
+
     /**
      * Get InnerEvent instance from pool.
      *
@@ -411,6 +476,30 @@ public:
     static Pointer Get(const Callback &callback, const std::string &name = std::string(),
                        const Caller &caller = {});
 
+    /**
+     * Get InnerEvent instance from pool, the task is moved into the event.
+     *
+     * @param callback Callback for task.
+     * @param name Name of task.
+     * @param caller Caller info of the event, default is caller's file, func and line.
+     * @return Returns the pointer of InnerEvent instance, if callback is invalid, returns nullptr object.
+     */
+    static Pointer Get(TaskCallable &&callback, const std::string &name = std::string(), const Caller &caller = {});
+
+    /**
+     * Get InnerEvent instance from pool, the callable is forwarded into the event without wrapping into Callback.
+     *
+     * @param callback Callable for task, such as a lambda capturing std::unique_ptr.
+     * @param name Name of task.
+     * @param caller Caller info of the event, default is caller's file, func and line.
+     * @return Returns the pointer of InnerEvent instance, if callback is invalid, returns nullptr object.
+     */
+    template<typename F, typename = std::enable_if_t<IS_FORWARDED_TASK<F>>>
+    static inline Pointer Get(F &&callback, const std::string &name = std::string(), const Caller &caller = {})
+    {
+        return Get(TaskCallable(std::forward<F>(callback)), name, caller);
+    }
+
     /**
      * Get InnerEvent instance from pool.
      *
@@ -418,6 +507,38 @@ public:
      */
     static Pointer Get();
 
+    struct PoolStats {
+        // Number of events served from recycled storage.
+        uint64_t hitCount {0};
+        // Number of events which needed a fresh allocation.
+        uint64_t missCount {0};
+        // Number of recycled events currently held by the pool and the thread caches.
+        uint64_t cachedCount {0};
+        // Bytes of memory currently held by the pool and the thread caches.
+        uint64_t bytesHeld {0};
+    };
+
+    /**
+     * Set watermarks of the event pool.
+     *
+     * @param highWatermark Max number of recycled events kept in the shared pool, extra events are freed.
+     * @param lowWatermark Number of recycled events the shared pool is trimmed to while a runner goes idle.
+     * @return Returns false if the low watermark is larger than the high watermark.
+     */
+    static bool SetPoolWatermarks(uint32_t highWatermark, uint32_t lowWatermark);
+
+    /**
+     * Get statistics of the event pool.
+     *
+     * @return Returns hit, miss and holding counters of the event pool.
+     */
+    static PoolStats GetPoolStats();
+
+    /**
+     * Return events cached by current thread to the event pool, and trim the pool to its low watermark.
+     */
+    static void TrimPool();
+
     /**
      * Get owner of the event.
      *
@@ -600,6 +721,39 @@ public:
         return std::unique_ptr<T, D>(nullptr, nullptr);
     }
 
+    /**
+     * Get payload constructed by 'Emplace'.
+     * Type is checked by an id computed at compile time, it works without RTTI.
+     *
+     * @return Returns pointer of the payload, or nullptr if there is no payload of type 'T'.
+     */
+    template<typename T>
+    T *GetPayload()
+    {
+        constexpr uint64_t typeId = GetPayloadTypeId<T>();
+        if (payloadTypeId_ != typeId) {
+            return nullptr;
+        }
+        if (IsInlinePayload<T>()) {
+            return std::launder(reinterpret_cast<T *>(payload_));
+        }
+        if (smartPtr_ == nullptr) {
+            return nullptr;
+        }
+        return reinterpret_cast<std::unique_ptr<T> *>(smartPtr_)->get();
+    }
+
+    /**
+     * Get payload constructed by 'Emplace'.
+     *
+     * @return Returns pointer of the payload, or nullptr if there is no payload of type 'T'.
+     */
+    template<typename T>
+    const T *GetPayload() const
+    {
+        return const_cast<InnerEvent *>(this)->GetPayload<T>();
+    }
+
     /**
      * Get task name.
      * Make sure {@link #hasTask} returns true.
@@ -617,7 +771,7 @@ public:
      *
      * @return Returns the callback of the task.
      */
-    inline const Callback &GetTaskCallback() const
+    inline const TaskCallable &GetTaskCallback() const
     {
         return taskCallback_;
     }
@@ -637,7 +791,7 @@ public:
      *
      * @return Returns the callback of the task.
      */
-    inline const Callback &GetTask() const
+    inline const TaskCallable &GetTask() const
     {
         return GetTaskCallback();
     }
@@ -688,16 +842,16 @@ public:
     void ReleaseStackId();
 
     /**
-     * Set uniqueId in event.
+     * Set uniqueId in event, taken from a per-process sequence.
      */
     void SetEventUniqueId();
 
     /**
      * Get uniqueId for event.
      *
-     * @return Returns uniqueId for event.
+     * @return Returns uniqueId for event, 0 if it is never set.
      */
-    inline std::string GetEventUniqueId()
+    inline uint64_t GetEventUniqueId() const
     {
         return eventId;
     }
@@ -723,7 +877,7 @@ public:
     /**
      * Set ownerId.
      */
-    inline void SetOwnerId(std::string ownerId)
+    inline void SetOwnerId(uint64_t ownerId)
     {
         ownerId_ = ownerId;
     }
@@ -731,7 +885,7 @@ public:
     /**
      * Get ownerId.
      */
-    inline std::string GetOwnerId()
+    inline uint64_t GetOwnerId() const
     {
         return ownerId_;
     }
@@ -823,11 +977,17 @@ public:
 private:
     using SmartPtrDestructor = void (*)(void *);
 
+    static constexpr uint64_t PAYLOAD_TYPE_ID_OFFSET = 0xcbf29ce484222325ULL;
+    static constexpr uint64_t PAYLOAD_TYPE_ID_PRIME = 0x100000001b3ULL;
+
     InnerEvent() = default;
     ~InnerEvent() = default;
 
     void ClearEvent();
 
+    // Swap what is sent with the event, such as param, object and task, but not the ids, owner and handle time.
+    void SwapContent(InnerEvent &other);
+
     static void WarnSmartPtrCastMismatch();
 
     template<typename T>
@@ -860,6 +1020,39 @@ private:
         }
     }
 
+    template<typename T>
+    static constexpr bool IsInlinePayload()
+    {
+        return (sizeof(T) <= INLINE_PAYLOAD_SIZE) && (alignof(T) <= alignof(std::max_align_t)) &&
+            std::is_trivially_copyable_v<T>;
+    }
+
+    /*
+     * FNV-1a hash of the signature which names 'T', so it is the same in every shared library.
+     * Types in unnamed namespaces are named the same in every translation unit, so their ids may collide.
+     */
+    template<typename T>
+    static constexpr uint64_t GetPayloadTypeId()
+    {
+        uint64_t hash = PAYLOAD_TYPE_ID_OFFSET;
+        for (const char *cur = __PRETTY_FUNCTION__; *cur != '\0'; ++cur) {
+            hash = (hash ^ static_cast<uint8_t>(*cur)) * PAYLOAD_TYPE_ID_PRIME;
+        }
+        return hash;
+    }
+
+    template<typename T, typename... Args>
+    inline void EmplacePayload(Args &&...args)
+    {
+        if constexpr (IsInlinePayload<T>()) {
+            new (payload_) T(std::forward<Args>(args)...);
+        } else {
+            auto object = std::make_unique<T>(std::forward<Args>(args)...);
+            SaveUniquePtr(object);
+        }
+        payloadTypeId_ = GetPayloadTypeId<T>();
+    }
+
     /**
      * if event has trace id ,return trace id, else create span id,
      * store it in event and return.
@@ -920,6 +1113,9 @@ private:
     // Used by event handler to create waiter.
     const std::shared_ptr<Waiter> &CreateWaiter();
 
+    // Used by event handler to wait for sync events, which reuses the waiter of the current thread.
+    const std::shared_ptr<Waiter> &UseThreadWaiter();
+
     // Used by event handler to tell whether event has waiter.
     bool HasWaiter() const;
 
@@ -927,6 +1123,35 @@ private:
     friend class InnerEventPool;
     // Let event handler to access private interface.
     friend class EventHandler;
+    // Let pending event store to index events.
+    friend class PendingEventStore;
+    // Let event inbox to link events.
+    friend class EventInbox;
+
+    // Chain of pending events with the same owner, defined by pending event store.
+    struct PendingChain;
+
+    // Links maintained by the pending event store which holds the event, used to find events by owner.
+    struct PendingLink {
+        PendingChain *ownerChain {nullptr};
+        InnerEvent *ownerPrev {nullptr};
+        InnerEvent *ownerNext {nullptr};
+        // Only events without task are chained by event id.
+        PendingChain *idChain {nullptr};
+        InnerEvent *idPrev {nullptr};
+        InnerEvent *idNext {nullptr};
+        // Position of the event inside the store.
+        size_t slot {0};
+        bool inHeap {false};
+        // Used by event inbox before the event is inserted into a store.
+        InnerEvent *inboxNext {nullptr};
+        void (*inboxDeleter)(InnerEvent *) {nullptr};
+        // Key to find the event while a later one with the same key is sent, if the event is coalesced.
+        uint64_t coalesceKey {0};
+        bool coalesced {false};
+        // Find the event by its unique id, if a task handle is returned for it.
+        bool withHandle {false};
+    };
 
     std::weak_ptr<EventHandler> owner_;
     TimePoint handleTime_;
@@ -944,8 +1169,12 @@ private:
     void *smartPtr_{nullptr};
     SmartPtrDestructor smartPtrDtor_{nullptr};
 
+    // Payload constructed by 'Emplace', kept in 'payload_' if it is small, otherwise kept in 'smartPtr_'.
+    uint64_t payloadTypeId_{0};
+    alignas(std::max_align_t) unsigned char payload_[INLINE_PAYLOAD_SIZE];
+
     // Task callback and its name.
-    Callback taskCallback_;
+    TaskCallable taskCallback_;
     std::string taskName_;
 
     // Task event caller info
@@ -957,8 +1186,8 @@ private:
     // use to store hitrace Id
     std::shared_ptr<HiTraceId> hiTraceId_;
 
-    // use to store event unique Id
-    std::string eventId;
+    // use to store event unique Id, rendered as string only while dumping or logging
+    uint64_t eventId {0};
 
     uint32_t emitterId_ = 0;
 
@@ -968,13 +1197,16 @@ private:
 
     bool isBarrier_ = false;
 
-    std::string ownerId_;
+    // Id of the handler which sends the event, 0 if not sent by a handler.
+    uint64_t ownerId_ {0};
 
     int64_t delayTime_ = 0;
 
     bool isEnhanced_ = false;
 
     uint64_t stackId_ = 0;
+
+    PendingLink pendingLink_;
 };
 }  // namespace AppExecFwk
 }  // namespace OHOS
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BASE_EVENTHANDLER_INTERFACES_INNER_API_LATENCY_HISTOGRAM_H
+#define BASE_EVENTHANDLER_INTERFACES_INNER_API_LATENCY_HISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+// Percentiles of latencies recorded into a histogram, in nanoseconds.
+struct LatencySummary {
+    uint64_t count {0};
+    uint64_t p50 {0};
+    uint64_t p90 {0};
+    uint64_t p99 {0};
+    uint64_t p999 {0};
+    uint64_t max {0};
+};
+
+/*
+ * Log-linear histogram of latencies, which may be recorded by any thread without lock.
+ * Every power of 2 is split into 8 linear buckets, so that a percentile is at most 12.5% larger than the real one.
+ */
+class LatencyHistogram final {
+public:
+    LatencyHistogram();
+    ~LatencyHistogram() = default;
+    DISALLOW_COPY_AND_MOVE(LatencyHistogram);
+
+    /**
+     * Record a latency.
+     *
+     * @param nanoseconds Latency in nanoseconds, negative values are recorded as 0.
+     */
+    void Record(int64_t nanoseconds);
+
+    /**
+     * Get percentiles of recorded latencies, concurrent recording may or may not be included.
+     *
+     * @return Returns the percentiles.
+     */
+    LatencySummary GetSummary() const;
+
+private:
+    static constexpr uint32_t SUB_BUCKET_BITS = 3;
+    static constexpr uint32_t SUB_BUCKET_NUM = 1u << SUB_BUCKET_BITS;
+    // Latencies of 2^37 ns (about 137 seconds) or longer fall into the last bucket.
+    static constexpr uint32_t MAX_EXPONENT = 36;
+    static constexpr uint32_t BUCKET_NUM = (MAX_EXPONENT - SUB_BUCKET_BITS + 2) * SUB_BUCKET_NUM;
+
+    static uint32_t GetBucketIndex(uint64_t value);
+    static uint64_t GetBucketLowerBound(uint32_t index);
+    uint64_t GetPercentile(const std::array<uint64_t, BUCKET_NUM> &buckets, uint64_t count, double percentile) const;
+
+    std::array<std::atomic<uint64_t>, BUCKET_NUM> buckets_;
+    std::atomic<uint64_t> max_ {0};
+};
+
+// Latencies of dispatched events, split by priority of events.
+struct LatencySnapshot {
+    static constexpr uint32_t PRIORITY_NUM = 5;
+
+    // Indexed by value of EventQueue::Priority. Time from handle time of an event until it is distributed.
+    std::array<LatencySummary, PRIORITY_NUM> delivery;
+    // Indexed by value of EventQueue::Priority. Time spent in distributing an event.
+    std::array<LatencySummary, PRIORITY_NUM> distribute;
+};
+
+// Latency histograms of an event runner or event handler.
+class LatencyStats final {
+public:
+    LatencyStats() = default;
+    ~LatencyStats() = default;
+    DISALLOW_COPY_AND_MOVE(LatencyStats);
+
+    /**
+     * Record latencies of a distributed event.
+     *
+     * @param priority Priority of the event, events with invalid priority are ignored.
+     * @param deliveryNanoseconds Time from handle time of the event until it is distributed.
+     * @param distributeNanoseconds Time spent in distributing the event.
+     */
+    void Record(int32_t priority, int64_t deliveryNanoseconds, int64_t distributeNanoseconds);
+
+    /**
+     * Get percentiles of all priorities.
+     *
+     * @return Returns the snapshot.
+     */
+    LatencySnapshot GetSnapshot() const;
+
+private:
+    std::array<LatencyHistogram, LatencySnapshot::PRIORITY_NUM> delivery_;
+    std::array<LatencyHistogram, LatencySnapshot::PRIORITY_NUM> distribute_;
+};
+}  // namespace AppExecFwk
+}  // namespace OHOS
+
+#endif  // #ifndef BASE_EVENTHANDLER_INTERFACES_INNER_API_LATENCY_HISTOGRAM_H
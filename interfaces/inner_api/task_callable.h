@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BASE_EVENTHANDLER_INTERFACES_INNER_API_TASK_CALLABLE_H
+#define BASE_EVENTHANDLER_INTERFACES_INNER_API_TASK_CALLABLE_H
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace OHOS {
+namespace AppExecFwk {
+/*
+ * Move-only holder of a task, which is called without arguments.
+ * Callables up to INLINE_SIZE bytes with a noexcept move constructor are kept inside the holder, others are kept on
+ * heap. Unlike std::function, move-only callables are accepted, such as lambdas capturing std::unique_ptr.
+ */
+class TaskCallable final {
+public:
+    static constexpr size_t INLINE_SIZE = 48;
+    static constexpr size_t INLINE_ALIGN = alignof(std::max_align_t);
+
+    TaskCallable() noexcept = default;
+    TaskCallable(std::nullptr_t) noexcept {}
+
+    template<typename F, typename D = std::decay_t<F>,
+        typename = std::enable_if_t<!std::is_same_v<D, TaskCallable> && std::is_invocable_v<D &>>>
+    TaskCallable(F &&callable)
+    {
+        if (IsEmpty(callable)) {
+            return;
+        }
+        if constexpr (IS_INLINE<D>) {
+            new (storage_) D(std::forward<F>(callable));
+        } else {
+            *reinterpret_cast<D **>(storage_) = new D(std::forward<F>(callable));
+        }
+        ops_ = &OPS<D>;
+    }
+
+    TaskCallable(TaskCallable &&other) noexcept
+    {
+        MoveFrom(other);
+    }
+
+    TaskCallable &operator=(TaskCallable &&other) noexcept
+    {
+        if (this != &other) {
+            Reset();
+            MoveFrom(other);
+        }
+        return *this;
+    }
+
+    TaskCallable &operator=(std::nullptr_t) noexcept
+    {
+        Reset();
+        return *this;
+    }
+
+    TaskCallable(const TaskCallable &) = delete;
+    TaskCallable &operator=(const TaskCallable &) = delete;
+
+    ~TaskCallable()
+    {
+        Reset();
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return ops_ != nullptr;
+    }
+
+    /**
+     * Call the task, which must not be empty.
+     */
+    void operator()() const
+    {
+        ops_->invoke(storage_);
+    }
+
+    /**
+     * Destroy the task, and make the holder empty.
+     */
+    void Reset() noexcept
+    {
+        if (ops_ != nullptr) {
+            ops_->destroy(storage_);
+            ops_ = nullptr;
+        }
+    }
+
+    /**
+     * Check whether the task is kept inside the holder.
+     *
+     * @return Returns false if the task is kept on heap or the holder is empty.
+     */
+    bool IsInline() const noexcept
+    {
+        return (ops_ != nullptr) && ops_->isInline;
+    }
+
+private:
+    struct Ops {
+        void (*invoke)(void *storage);
+        // Move the task from 'src' to 'dst', and destroy the one in 'src'.
+        void (*relocate)(void *dst, void *src) noexcept;
+        void (*destroy)(void *storage) noexcept;
+        bool isInline;
+    };
+
+    template<typename D>
+    static constexpr bool IS_INLINE = (sizeof(D) <= INLINE_SIZE) && (alignof(D) <= INLINE_ALIGN) &&
+        std::is_nothrow_move_constructible_v<D>;
+
+    template<typename T>
+    struct IsFunction : std::false_type {};
+    template<typename R, typename... Args>
+    struct IsFunction<std::function<R(Args...)>> : std::true_type {};
+
+    template<typename D>
+    static bool IsEmpty(const D &callable) noexcept
+    {
+        if constexpr (std::is_pointer_v<D> || std::is_member_pointer_v<D> || IsFunction<D>::value) {
+            return !callable;
+        } else {
+            return false;
+        }
+    }
+
+    template<typename D>
+    static D &Target(void *storage) noexcept
+    {
+        if constexpr (IS_INLINE<D>) {
+            return *std::launder(reinterpret_cast<D *>(storage));
+        } else {
+            return **reinterpret_cast<D **>(storage);
+        }
+    }
+
+    template<typename D>
+    static void Invoke(void *storage)
+    {
+        std::invoke(Target<D>(storage));
+    }
+
+    template<typename D>
+    static void Relocate(void *dst, void *src) noexcept
+    {
+        if constexpr (IS_INLINE<D>) {
+            D &source = Target<D>(src);
+            new (dst) D(std::move(source));
+            source.~D();
+        } else {
+            *reinterpret_cast<D **>(dst) = *reinterpret_cast<D **>(src);
+        }
+    }
+
+    template<typename D>
+    static void Destroy(void *storage) noexcept
+    {
+        if constexpr (IS_INLINE<D>) {
+            Target<D>(storage).~D();
+        } else {
+            delete *reinterpret_cast<D **>(storage);
+        }
+    }
+
+    template<typename D>
+    static constexpr Ops OPS = { Invoke<D>, Relocate<D>, Destroy<D>, IS_INLINE<D> };
+
+    void MoveFrom(TaskCallable &other) noexcept
+    {
+        if (other.ops_ != nullptr) {
+            other.ops_->relocate(storage_, other.storage_);
+            ops_ = other.ops_;
+            other.ops_ = nullptr;
+        }
+    }
+
+    alignas(INLINE_ALIGN) mutable unsigned char storage_[INLINE_SIZE];
+    const Ops *ops_ {nullptr};
+};
+}  // namespace AppExecFwk
+}  // namespace OHOS
+
+#endif  // #ifndef BASE_EVENTHANDLER_INTERFACES_INNER_API_TASK_CALLABLE_H
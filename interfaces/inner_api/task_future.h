@@ -0,0 +1,333 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BASE_EVENTHANDLER_INTERFACES_INNER_API_TASK_FUTURE_H
+#define BASE_EVENTHANDLER_INTERFACES_INNER_API_TASK_FUTURE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "event_handler_errors.h"
+#include "nocopyable.h"
+#include "task_callable.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+class EventHandler;
+
+/*
+ * Result of a task posted by 'EventHandler::PostSyncTaskWithResult' or 'EventHandler::PostTaskForResult'.
+ * It holds either the value returned by the task, or the error code telling why the task did not run.
+ */
+template<typename R>
+class TaskResult final {
+public:
+    explicit TaskResult(ErrCode error) : error_(error) {}
+    template<typename... Args>
+    explicit TaskResult(std::in_place_t, Args &&...args) : value_(std::in_place, std::forward<Args>(args)...) {}
+    ~TaskResult() = default;
+    TaskResult(TaskResult &&) = default;
+    TaskResult &operator=(TaskResult &&) = default;
+
+    inline bool HasValue() const
+    {
+        return value_.has_value();
+    }
+
+    inline ErrCode GetError() const
+    {
+        return error_;
+    }
+
+    /**
+     * Get the value returned by the task, only valid if 'HasValue' returns true.
+     *
+     * @return Returns the value returned by the task.
+     */
+    inline R &GetValue()
+    {
+        return *value_;
+    }
+
+    inline const R &GetValue() const
+    {
+        return *value_;
+    }
+
+    inline explicit operator bool() const
+    {
+        return HasValue();
+    }
+
+private:
+    std::optional<R> value_;
+    ErrCode error_ {ERR_OK};
+};
+
+template<>
+class TaskResult<void> final {
+public:
+    explicit TaskResult(ErrCode error) : error_(error) {}
+    explicit TaskResult(std::in_place_t) {}
+    ~TaskResult() = default;
+    TaskResult(TaskResult &&) = default;
+    TaskResult &operator=(TaskResult &&) = default;
+
+    inline bool HasValue() const
+    {
+        return error_ == ERR_OK;
+    }
+
+    inline ErrCode GetError() const
+    {
+        return error_;
+    }
+
+    inline explicit operator bool() const
+    {
+        return HasValue();
+    }
+
+private:
+    ErrCode error_ {ERR_OK};
+};
+
+/*
+ * Shared state of a task future, without the result value.
+ * A single atomic word tells whether the result is ready, whether a continuation is attached and whether a thread
+ * is blocked on it, so the result is handed over with no lock and at most one futex wake up.
+ */
+class TaskFutureState {
+public:
+    TaskFutureState() = default;
+    ~TaskFutureState() = default;
+    DISALLOW_COPY_AND_MOVE(TaskFutureState);
+
+    /**
+     * Publish the result, wake up the waiting thread and schedule the continuation if any.
+     * Only called once, by the promise, after the value has been stored.
+     *
+     * @param error ERR_OK if the value has been stored, otherwise the reason why the task did not run.
+     */
+    void Complete(ErrCode error);
+
+    /**
+     * Block until the result is published.
+     */
+    void Wait();
+
+    /**
+     * Attach the continuation, it is scheduled at once if the result is already published.
+     *
+     * @param handler Handler to post the continuation to, or nullptr to run it on the completing thread.
+     * @param continuation Continuation to run.
+     */
+    void SetContinuation(const std::shared_ptr<EventHandler> &handler, TaskCallable &&continuation);
+
+    inline bool IsReady() const
+    {
+        return (word_.load(std::memory_order_acquire) & READY) != 0;
+    }
+
+    inline ErrCode GetError() const
+    {
+        return error_;
+    }
+
+private:
+    static constexpr uint32_t READY = 1U << 0;
+    static constexpr uint32_t CONTINUED = 1U << 1;
+    static constexpr uint32_t PARKED = 1U << 2;
+
+    void ScheduleContinuation();
+
+    std::atomic<uint32_t> word_ {0};
+    ErrCode error_ {ERR_OK};
+    std::shared_ptr<EventHandler> handler_;
+    TaskCallable continuation_;
+};
+
+template<typename R>
+struct TaskFutureStorage : public TaskFutureState {
+    std::optional<R> value;
+
+    inline TaskResult<R> TakeResult()
+    {
+        if (value.has_value()) {
+            return TaskResult<R>(std::in_place, std::move(*value));
+        }
+        return TaskResult<R>(GetError());
+    }
+};
+
+template<>
+struct TaskFutureStorage<void> : public TaskFutureState {
+    inline TaskResult<void> TakeResult()
+    {
+        return (GetError() == ERR_OK) ? TaskResult<void>(std::in_place) : TaskResult<void>(GetError());
+    }
+};
+
+/*
+ * Producer side of a task future, it is moved into the posted task.
+ * If it is destroyed without a value, for example the task is removed before running, the future completes with
+ * 'EVENT_HANDLER_ERR_TASK_NOT_RUN'.
+ */
+template<typename R>
+class TaskPromise final {
+public:
+    TaskPromise() = default;
+    explicit TaskPromise(const std::shared_ptr<TaskFutureStorage<R>> &storage) : storage_(storage) {}
+    TaskPromise(TaskPromise &&other) noexcept : storage_(std::move(other.storage_)) {}
+    TaskPromise &operator=(TaskPromise &&other) noexcept
+    {
+        if (this != &other) {
+            SetError(EVENT_HANDLER_ERR_TASK_NOT_RUN);
+            storage_ = std::move(other.storage_);
+        }
+        return *this;
+    }
+    TaskPromise(const TaskPromise &) = delete;
+    TaskPromise &operator=(const TaskPromise &) = delete;
+
+    ~TaskPromise()
+    {
+        SetError(EVENT_HANDLER_ERR_TASK_NOT_RUN);
+    }
+
+    template<typename... Args>
+    inline void SetValue(Args &&...args)
+    {
+        if (!storage_) {
+            return;
+        }
+        if constexpr (!std::is_void_v<R>) {
+            storage_->value.emplace(std::forward<Args>(args)...);
+        }
+        storage_->Complete(ERR_OK);
+        storage_.reset();
+    }
+
+    inline void SetError(ErrCode error)
+    {
+        if (!storage_) {
+            return;
+        }
+        storage_->Complete(error);
+        storage_.reset();
+    }
+
+private:
+    std::shared_ptr<TaskFutureStorage<R>> storage_;
+};
+
+/*
+ * Consumer side of a task posted by 'EventHandler::PostTaskForResult'.
+ * The result lives in a single allocation shared with the promise, it can be waited for, or handed to a
+ * continuation scheduled onto a chosen handler. The result is taken only once, either by 'Get' or by 'Then'.
+ */
+template<typename R>
+class TaskFuture final {
+public:
+    TaskFuture() = default;
+    explicit TaskFuture(const std::shared_ptr<TaskFutureStorage<R>> &storage) : storage_(storage) {}
+    ~TaskFuture() = default;
+    TaskFuture(TaskFuture &&) = default;
+    TaskFuture &operator=(TaskFuture &&) = default;
+    TaskFuture(const TaskFuture &) = delete;
+    TaskFuture &operator=(const TaskFuture &) = delete;
+
+    /**
+     * Create the shared state, and the promise to complete it.
+     *
+     * @param promise Promise of the created future.
+     * @return Returns the created future.
+     */
+    static inline TaskFuture Create(TaskPromise<R> &promise)
+    {
+        auto storage = std::make_shared<TaskFutureStorage<R>>();
+        promise = TaskPromise<R>(storage);
+        return TaskFuture(storage);
+    }
+
+    inline bool IsValid() const
+    {
+        return static_cast<bool>(storage_);
+    }
+
+    inline bool IsReady() const
+    {
+        return storage_ && storage_->IsReady();
+    }
+
+    /**
+     * Block until the task has run or has been dropped.
+     */
+    inline void Wait() const
+    {
+        if (storage_) {
+            storage_->Wait();
+        }
+    }
+
+    /**
+     * Wait for the task and take its result, the future becomes invalid.
+     *
+     * @return Returns the result of the task.
+     */
+    inline TaskResult<R> Get()
+    {
+        if (!storage_) {
+            return TaskResult<R>(EVENT_HANDLER_ERR_INVALID_PARAM);
+        }
+        storage_->Wait();
+        auto storage = std::move(storage_);
+        return storage->TakeResult();
+    }
+
+    /**
+     * Run the continuation with the result of the task once it is ready, the future becomes invalid.
+     * If the target handler fails to accept the continuation, it is dropped.
+     *
+     * @param handler Handler to post the continuation to, or nullptr to run it on the thread completing the task.
+     * @param continuation Callable invoked with 'TaskResult<R>&&'.
+     * @return Returns false if the future is invalid.
+     */
+    template<typename F>
+    inline bool Then(const std::shared_ptr<EventHandler> &handler, F &&continuation)
+    {
+        if (!storage_) {
+            return false;
+        }
+        auto storage = std::move(storage_);
+        TaskFutureState &state = *storage;
+        state.SetContinuation(handler, TaskCallable(
+            [storage = std::move(storage), continuation = std::forward<F>(continuation)]() mutable {
+                continuation(storage->TakeResult());
+            }));
+        return true;
+    }
+
+private:
+    std::shared_ptr<TaskFutureStorage<R>> storage_;
+};
+}  // namespace AppExecFwk
+}  // namespace OHOS
+
+#endif  // #ifndef BASE_EVENTHANDLER_INTERFACES_INNER_API_TASK_FUTURE_H
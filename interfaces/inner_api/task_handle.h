@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BASE_EVENTHANDLER_INTERFACES_INNER_API_TASK_HANDLE_H
+#define BASE_EVENTHANDLER_INTERFACES_INNER_API_TASK_HANDLE_H
+
+#include <cstdint>
+#include <memory>
+
+#include "event_queue.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+/*
+ * Handle of a posted task, returned by 'EventHandler::PostTaskWithHandle'.
+ * The event queue indexes the task by its unique id, so that cancelling it does not scan the queue or compare names.
+ * A default constructed handle, or a handle of a task sent to a queue without handle support, such as the FFRT
+ * queue, refers to no pending task.
+ */
+class TaskHandle final {
+public:
+    TaskHandle() = default;
+    TaskHandle(const std::weak_ptr<EventQueue> &queue, uint64_t eventUniqueId) : queue_(queue),
+        eventUniqueId_(eventUniqueId) {}
+    ~TaskHandle() = default;
+
+    /**
+     * Remove the task if it is still pending, a running task is not interrupted.
+     *
+     * @return Returns true if the task is removed.
+     */
+    inline bool Cancel() const
+    {
+        auto queue = queue_.lock();
+        return queue && queue->CancelByHandle(eventUniqueId_);
+    }
+
+    /**
+     * Check whether the task is still waiting to be distributed.
+     *
+     * @return Returns true if the task is pending.
+     */
+    inline bool IsPending() const
+    {
+        auto queue = queue_.lock();
+        return queue && queue->IsPendingByHandle(eventUniqueId_);
+    }
+
+    /**
+     * Move the pending task into another priority, it keeps its handle time.
+     *
+     * @param priority New priority of the task.
+     * @return Returns true if the task is pending and moved.
+     */
+    inline bool Reprioritize(EventQueue::Priority priority) const
+    {
+        auto queue = queue_.lock();
+        return queue && queue->ReprioritizeByHandle(eventUniqueId_, priority);
+    }
+
+    inline uint64_t GetEventUniqueId() const
+    {
+        return eventUniqueId_;
+    }
+
+    inline explicit operator bool() const
+    {
+        return eventUniqueId_ != 0;
+    }
+
+private:
+    std::weak_ptr<EventQueue> queue_;
+    uint64_t eventUniqueId_ {0};
+};
+}  // namespace AppExecFwk
+}  // namespace OHOS
+
+#endif  // #ifndef BASE_EVENTHANDLER_INTERFACES_INNER_API_TASK_HANDLE_H
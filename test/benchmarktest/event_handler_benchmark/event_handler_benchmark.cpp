@@ -0,0 +1,742 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <dirent.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include "epoll_io_waiter.h"
+#include "event_handler.h"
+#include "event_handler_coroutine.h"
+#include "event_queue_base.h"
+#include "event_runner.h"
+#include "file_descriptor_listener.h"
+#include "inner_event.h"
+#include "std_lock.h"
+#include "sync_waiter.h"
+
+using namespace OHOS;
+using namespace OHOS::AppExecFwk;
+
+namespace {
+const int64_t FAR_DELAY_MS = 1000000;
+const uint32_t TARGET_EVENT_ID = 1;
+const uint32_t FILLER_EVENT_ID = 2;
+const int64_t ROUND_TRIPS = 100;
+const int64_t TASKS_PER_ROUND_TRIP = 2;
+const int64_t HANDLER_NUM = 2;
+const std::string DEFAULT_OUTPUT = "--benchmark_out=eventhandler_benchmark.json";
+const std::string DEFAULT_FORMAT = "--benchmark_out_format=json";
+
+using Clock = std::chrono::steady_clock;
+
+double ElapsedSeconds(Clock::time_point start)
+{
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/*
+ * Block the benchmark thread until another thread signals, the wake up of the benchmark thread is part of the latency
+ * for all variants, so they are still comparable.
+ */
+class Completion {
+public:
+    void Reset()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        done_ = false;
+    }
+
+    void Signal()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        done_ = true;
+        condition_.notify_one();
+    }
+
+    void Wait()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        condition_.wait(lock, [this]() { return done_; });
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    bool done_ {false};
+};
+
+/*
+ * EventQueueBase::Insert followed by GetEvent on one thread, arg 0 is the number of delayed events kept pending.
+ */
+void QueueInsertAndGetEvent(benchmark::State &state)
+{
+    auto runner = EventRunner::Create(false);
+    auto handler = std::make_shared<EventHandler>(runner);
+    EventQueueBase queue(EventLockType::STANDARD);
+    queue.Prepare();
+    auto now = InnerEvent::Clock::now();
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        auto event = InnerEvent::Get(FILLER_EVENT_ID);
+        event->SetOwner(handler);
+        event->SetHandleTime(now + std::chrono::milliseconds(FAR_DELAY_MS + i));
+        queue.Insert(event);
+    }
+
+    for (auto _ : state) {
+        auto event = InnerEvent::Get(TARGET_EVENT_ID);
+        event->SetOwner(handler);
+        event->SetHandleTime(InnerEvent::Clock::now());
+        queue.Insert(event);
+        benchmark::DoNotOptimize(queue.GetEvent());
+    }
+    state.SetItemsProcessed(state.iterations());
+    queue.RemoveAll();
+}
+
+/*
+ * Two runners post a task to each other, every iteration is ROUND_TRIPS round trips.
+ */
+void PostTaskPingPong(benchmark::State &state)
+{
+    auto pingHandler = std::make_shared<EventHandler>(EventRunner::Create(true));
+    auto pongHandler = std::make_shared<EventHandler>(EventRunner::Create(true));
+    Completion completion;
+    int64_t remaining = 0;
+    std::function<void()> ping;
+    std::function<void()> pong = [&]() { pingHandler->PostTask(ping); };
+    ping = [&]() {
+        if (--remaining <= 0) {
+            completion.Signal();
+            return;
+        }
+        pongHandler->PostTask(pong);
+    };
+
+    for (auto _ : state) {
+        completion.Reset();
+        remaining = ROUND_TRIPS;
+        pongHandler->PostTask(pong);
+        completion.Wait();
+    }
+    state.SetItemsProcessed(state.iterations() * ROUND_TRIPS * TASKS_PER_ROUND_TRIP);
+    pingHandler->GetEventRunner()->Stop();
+    pongHandler->GetEventRunner()->Stop();
+}
+
+/*
+ * Same as PostTaskPingPong, with both runners waiting with the wait strategy of arg 0.
+ * Each task is posted when the other runner has just started waiting, which is where spinning pays off.
+ */
+void WaitStrategyPingPong(benchmark::State &state)
+{
+    auto strategy = static_cast<WaitStrategy>(state.range(0));
+    auto pingHandler = std::make_shared<EventHandler>(EventRunner::Create(true, strategy));
+    auto pongHandler = std::make_shared<EventHandler>(EventRunner::Create(true, strategy));
+    Completion completion;
+    int64_t remaining = 0;
+    std::function<void()> ping;
+    std::function<void()> pong = [&]() { pingHandler->PostTask(ping); };
+    ping = [&]() {
+        if (--remaining <= 0) {
+            completion.Signal();
+            return;
+        }
+        pongHandler->PostTask(pong);
+    };
+
+    for (auto _ : state) {
+        completion.Reset();
+        remaining = ROUND_TRIPS;
+        pongHandler->PostTask(pong);
+        completion.Wait();
+    }
+    state.SetItemsProcessed(state.iterations() * ROUND_TRIPS * TASKS_PER_ROUND_TRIP);
+    pingHandler->GetEventRunner()->Stop();
+    pongHandler->GetEventRunner()->Stop();
+}
+
+class EmptyEventHandler : public EventHandler {
+public:
+    explicit EmptyEventHandler(const std::shared_ptr<EventRunner> &runner) : EventHandler(runner)
+    {}
+    ~EmptyEventHandler() override = default;
+
+    void ProcessEvent(const InnerEvent::Pointer &event) override
+    {
+        benchmark::DoNotOptimize(event->GetInnerEventId());
+    }
+};
+
+/*
+ * SendSyncEvent from the benchmark thread to a runner, the time is the full round trip.
+ */
+void SendSyncEventRoundTrip(benchmark::State &state)
+{
+    auto runner = EventRunner::Create(true);
+    auto handler = std::make_shared<EmptyEventHandler>(runner);
+    for (auto _ : state) {
+        handler->SendSyncEvent(TARGET_EVENT_ID);
+    }
+    state.SetItemsProcessed(state.iterations());
+    runner->Stop();
+}
+
+// Waiter used by sync events before SyncWaiter, as the reference.
+class ConditionWaiter final : public InnerEvent::Waiter {
+public:
+    void Wait() final
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!finished_) {
+            ++waitingCount_;
+            condition_.wait(lock);
+            --waitingCount_;
+        }
+    }
+
+    void Notify() final
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        finished_ = true;
+        if (waitingCount_ > 0) {
+            condition_.notify_all();
+        }
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    uint32_t waitingCount_ {0};
+    bool finished_ {false};
+};
+
+/*
+ * A task posted to a runner notifies the waiter which the benchmark thread blocks on, like sync events do.
+ * Arg 0 selects a new ConditionWaiter for each task, or one SyncWaiter reused by all tasks.
+ */
+void SyncWaiterRoundTrip(benchmark::State &state)
+{
+    auto runner = EventRunner::Create(true);
+    auto handler = std::make_shared<EventHandler>(runner);
+    bool reuseSyncWaiter = (state.range(0) != 0);
+    auto syncWaiter = std::make_shared<SyncWaiter>();
+    for (auto _ : state) {
+        std::shared_ptr<InnerEvent::Waiter> waiter;
+        if (reuseSyncWaiter) {
+            syncWaiter->Reset();
+            waiter = syncWaiter;
+        } else {
+            waiter = std::make_shared<ConditionWaiter>();
+        }
+        handler->PostTask([waiter]() { waiter->Notify(); });
+        waiter->Wait();
+    }
+    state.SetItemsProcessed(state.iterations());
+    runner->Stop();
+}
+
+int64_t CountThreads()
+{
+    DIR *dir = opendir("/proc/self/task");
+    if (dir == nullptr) {
+        return 0;
+    }
+    int64_t count = 0;
+    for (struct dirent *entry = readdir(dir); entry != nullptr; entry = readdir(dir)) {
+        count += (entry->d_name[0] != '.') ? 1 : 0;
+    }
+    closedir(dir);
+    return count;
+}
+
+int64_t ResidentKiloBytes()
+{
+    std::ifstream statm("/proc/self/statm");
+    int64_t size = 0;
+    int64_t resident = 0;
+    statm >> size >> resident;
+    return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+/*
+ * Create many idle runners, each with one handler, and ping them in turn from the benchmark thread.
+ * Arg 0 selects the thread mode, arg 1 the number of runners. Threads and resident memory added by the runners are
+ * reported as counters, the time per iteration is the wakeup round trip of an idle runner. Workers of the shared pool
+ * are started once per process, so only the first pooled run counts them.
+ */
+void RunnerScale(benchmark::State &state)
+{
+    auto threadMode = static_cast<ThreadMode>(state.range(0));
+    auto runnerNum = static_cast<size_t>(state.range(1));
+    int64_t threadsBefore = CountThreads();
+    int64_t residentBefore = ResidentKiloBytes();
+    std::vector<std::shared_ptr<EventRunner>> runners;
+    std::vector<std::shared_ptr<EventHandler>> handlers;
+    for (size_t i = 0; i < runnerNum; ++i) {
+        runners.emplace_back(EventRunner::Create("RunnerScale", threadMode));
+        handlers.emplace_back(std::make_shared<EventHandler>(runners.back()));
+    }
+    state.counters["threads"] = static_cast<double>(CountThreads() - threadsBefore);
+    state.counters["rss_kb"] = static_cast<double>(ResidentKiloBytes() - residentBefore);
+
+    SyncWaiter waiter;
+    size_t next = 0;
+    for (auto _ : state) {
+        waiter.Reset();
+        handlers[next]->PostTask([&waiter]() { waiter.Notify(); });
+        waiter.Wait();
+        next = (next + 1) % runnerNum;
+    }
+    state.SetItemsProcessed(state.iterations());
+    handlers.clear();
+    for (auto &runner : runners) {
+        runner->Stop();
+    }
+    runners.clear();
+    // Threads of stopped runners exit asynchronously, wait for them so that the next run counts only its own.
+    const int32_t maxDrainRounds = 1000;
+    for (int32_t i = 0; (i < maxDrainRounds) && (CountThreads() > threadsBefore); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+const int32_t CONCURRENT_HANDLER_NUM = 64;
+const int32_t CONCURRENT_TASKS_PER_ITERATION = 1024;
+const uint32_t CONCURRENT_TASK_WORK = 2000;
+
+// Some cpu work of each task, so that the handling time outweighs the queue.
+uint64_t SpinWork(uint32_t rounds)
+{
+    uint64_t value = rounds;
+    for (uint32_t i = 0; i < rounds; ++i) {
+        value = value * 6364136223846793005ULL + 1442695040888963407ULL;
+        benchmark::DoNotOptimize(value);
+    }
+    return value;
+}
+
+/*
+ * Tasks of many handlers are posted to one runner with several threads, each task is serialized only with the tasks
+ * of its handler. Arg 0 is the number of threads, the throughput should scale with it up to the number of cpus.
+ */
+void ConcurrentRunnerScaling(benchmark::State &state)
+{
+    auto runner = EventRunner::CreateConcurrent("Scaling", static_cast<uint32_t>(state.range(0)));
+    std::vector<std::shared_ptr<EventHandler>> handlers;
+    for (int32_t i = 0; i < CONCURRENT_HANDLER_NUM; ++i) {
+        handlers.emplace_back(std::make_shared<EventHandler>(runner));
+    }
+    SyncWaiter finished;
+    std::atomic<int32_t> remaining {0};
+    auto task = [&finished, &remaining]() {
+        benchmark::DoNotOptimize(SpinWork(CONCURRENT_TASK_WORK));
+        if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            finished.Notify();
+        }
+    };
+    for (auto _ : state) {
+        finished.Reset();
+        remaining.store(CONCURRENT_TASKS_PER_ITERATION, std::memory_order_relaxed);
+        for (int32_t i = 0; i < CONCURRENT_TASKS_PER_ITERATION; ++i) {
+            handlers[i % CONCURRENT_HANDLER_NUM]->PostTask(task);
+        }
+        finished.Wait();
+    }
+    state.SetItemsProcessed(state.iterations() * CONCURRENT_TASKS_PER_ITERATION);
+    handlers.clear();
+    runner->Stop();
+}
+
+#ifdef EVENT_HANDLER_COROUTINE_SUPPORT
+const int32_t ASYNC_CHAIN_STEPS = 16;
+
+// Each step of the chain is a nested lambda posted as Callback, which is the way chains are written without coroutines.
+void NestedTaskChain(const std::shared_ptr<EventHandler> &handler, int32_t step, SyncWaiter &finished)
+{
+    if (step == ASYNC_CHAIN_STEPS) {
+        finished.Notify();
+        return;
+    }
+    handler->PostTask(EventHandler::Callback([handler, step, &finished]() {
+        NestedTaskChain(handler, step + 1, finished);
+    }));
+}
+
+EventCoroutine CoroutineChain(std::shared_ptr<EventHandler> handler, SyncWaiter &finished)
+{
+    for (int32_t step = 0; step < ASYNC_CHAIN_STEPS; ++step) {
+        co_await handler->Schedule();
+    }
+    finished.Notify();
+}
+
+// Run a chain of async steps on the runner thread, by nested tasks or by a coroutine.
+void AsyncChain(benchmark::State &state)
+{
+    auto runner = EventRunner::Create(true);
+    auto handler = std::make_shared<EventHandler>(runner);
+    bool useCoroutine = (state.range(0) != 0);
+    SyncWaiter finished;
+    for (auto _ : state) {
+        finished.Reset();
+        if (useCoroutine) {
+            CoroutineChain(handler, finished);
+        } else {
+            NestedTaskChain(handler, 0, finished);
+        }
+        finished.Wait();
+    }
+    state.SetItemsProcessed(state.iterations() * ASYNC_CHAIN_STEPS);
+    runner->Stop();
+}
+#endif
+
+enum class ResultBy {
+    CAPTURE,
+    SYNC_RESULT,
+    FUTURE,
+};
+
+// Hand back a value from the runner thread, by a captured reference, a sync result or a future.
+void TaskResultRoundTrip(benchmark::State &state)
+{
+    auto runner = EventRunner::Create(true);
+    auto handler = std::make_shared<EventHandler>(runner);
+    auto resultBy = static_cast<ResultBy>(state.range(0));
+    int64_t value = 0;
+    for (auto _ : state) {
+        switch (resultBy) {
+            case ResultBy::CAPTURE:
+                handler->PostSyncTask([&value]() { ++value; });
+                break;
+            case ResultBy::SYNC_RESULT:
+                value = handler->PostSyncTaskWithResult([value]() { return value + 1; }).GetValue();
+                break;
+            case ResultBy::FUTURE:
+                value = handler->PostTaskForResult([value]() { return value + 1; }).Get().GetValue();
+                break;
+        }
+    }
+    benchmark::DoNotOptimize(value);
+    state.SetItemsProcessed(state.iterations());
+    runner->Stop();
+}
+
+enum class RemoveBy {
+    OWNER,
+    ID,
+    NAME,
+};
+
+/*
+ * Arg 0 is the number of pending events, half of them are owned by the handler to remove from.
+ * Only one event matches when removing by id or name, which is the common case.
+ */
+void BenchmarkRemove(benchmark::State &state, RemoveBy removeBy)
+{
+    auto runner = EventRunner::Create(false);
+    auto handler = std::make_shared<EventHandler>(runner);
+    auto otherHandler = std::make_shared<EventHandler>(runner);
+    const int64_t depth = state.range(0);
+    const std::string targetName = "target";
+    for (auto _ : state) {
+        state.PauseTiming();
+        for (int64_t i = 0; i < depth; ++i) {
+            auto &owner = (i % HANDLER_NUM == 0) ? handler : otherHandler;
+            if (removeBy == RemoveBy::NAME) {
+                owner->PostTask([]() {}, (i == depth / HANDLER_NUM) ? targetName : std::string(),
+                    FAR_DELAY_MS);
+            } else {
+                owner->SendEvent((i == depth / HANDLER_NUM) ? TARGET_EVENT_ID : FILLER_EVENT_ID,
+                    0, FAR_DELAY_MS);
+            }
+        }
+        state.ResumeTiming();
+
+        switch (removeBy) {
+            case RemoveBy::OWNER:
+                handler->RemoveAllEvents();
+                break;
+            case RemoveBy::ID:
+                handler->RemoveEvent(TARGET_EVENT_ID);
+                break;
+            case RemoveBy::NAME:
+                handler->RemoveTask(targetName);
+                break;
+            default:
+                break;
+        }
+
+        state.PauseTiming();
+        handler->RemoveAllEvents();
+        otherHandler->RemoveAllEvents();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void RemoveByOwner(benchmark::State &state)
+{
+    BenchmarkRemove(state, RemoveBy::OWNER);
+}
+
+void RemoveById(benchmark::State &state)
+{
+    BenchmarkRemove(state, RemoveBy::ID);
+}
+
+void RemoveByName(benchmark::State &state)
+{
+    BenchmarkRemove(state, RemoveBy::NAME);
+}
+
+/*
+ * Time from EpollIoWaiter::NotifyOne on the benchmark thread until the waiting thread returns from WaitFor.
+ */
+void EpollWakeupLatency(benchmark::State &state)
+{
+    EpollIoWaiter waiter;
+    if (!waiter.Init()) {
+        state.SkipWithError("failed to init epoll");
+        return;
+    }
+    StdLock lock;
+    bool waiting = false;
+    bool stopped = false;
+    Clock::time_point notifyTime;
+    std::atomic<int64_t> wokenNanoseconds {-1};
+    std::thread waitThread([&]() {
+        UniqueLockBase waitLock(lock);
+        while (!stopped) {
+            waiting = true;
+            waiter.WaitFor(waitLock, -1);
+            if (!waiting) {
+                auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - notifyTime);
+                wokenNanoseconds.store(latency.count(), std::memory_order_release);
+            }
+        }
+    });
+
+    for (auto _ : state) {
+        wokenNanoseconds.store(-1, std::memory_order_relaxed);
+        while (true) {
+            // 'waiting' is set under the lock before WaitFor, which counts the waiter before unlocking.
+            UniqueLockBase notifyLock(lock);
+            if (waiting) {
+                waiting = false;
+                notifyTime = Clock::now();
+                waiter.NotifyOne();
+                break;
+            }
+            notifyLock.unlock();
+            std::this_thread::yield();
+        }
+        int64_t latency = -1;
+        while ((latency = wokenNanoseconds.load(std::memory_order_acquire)) < 0) {
+            std::this_thread::yield();
+        }
+        state.SetIterationTime(std::chrono::duration<double>(std::chrono::nanoseconds(latency)).count());
+    }
+
+    {
+        UniqueLockBase stopLock(lock);
+        stopped = true;
+        waiting = false;
+    }
+    waiter.NotifyAll();
+    waitThread.join();
+}
+
+class EventFdListener : public FileDescriptorListener {
+public:
+    explicit EventFdListener(Completion &completion) : completion_(completion)
+    {}
+    ~EventFdListener() override = default;
+
+    void OnReadable(int32_t fileDescriptor) override
+    {
+        uint64_t value = 0;
+        (void)read(fileDescriptor, &value, sizeof(value));
+        completion_.Signal();
+    }
+
+private:
+    Completion &completion_;
+};
+
+/*
+ * Time from writing an eventfd until its listener is called on the runner, arg 0 enables direct dispatch.
+ */
+void FileDescriptorDispatch(benchmark::State &state)
+{
+    auto runner = EventRunner::Create(true);
+    auto handler = std::make_shared<EventHandler>(runner);
+    int32_t fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    Completion completion;
+    auto listener = std::make_shared<EventFdListener>(completion);
+    listener->SetDirectDispatch(state.range(0) != 0);
+    if (handler->AddFileDescriptorListener(fd, FILE_DESCRIPTOR_INPUT_EVENT, listener, "FdDispatchBenchmark") !=
+        ERR_OK) {
+        state.SkipWithError("failed to add listener");
+        close(fd);
+        return;
+    }
+
+    const uint64_t one = 1;
+    for (auto _ : state) {
+        completion.Reset();
+        auto start = Clock::now();
+        (void)write(fd, &one, sizeof(one));
+        completion.Wait();
+        state.SetIterationTime(ElapsedSeconds(start));
+    }
+    handler->RemoveFileDescriptorListener(fd);
+    runner->Stop();
+    close(fd);
+}
+
+/*
+ * The same path as an emitter: events are sent to a shared handler, which calls the callbacks subscribed to the id.
+ * The napi and ani layers of emitter are left out.
+ */
+class EmitterEventHandler : public EventHandler {
+public:
+    using EmitterCallback = std::function<void(const std::shared_ptr<std::string> &)>;
+
+    explicit EmitterEventHandler(const std::shared_ptr<EventRunner> &runner) : EventHandler(runner)
+    {}
+    ~EmitterEventHandler() override = default;
+
+    void On(uint32_t eventId, const EmitterCallback &callback)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        callbacks_[eventId].push_back(callback);
+    }
+
+    void Emit(uint32_t eventId, const std::shared_ptr<std::string> &data)
+    {
+        SendEvent(InnerEvent::Get(eventId, data), 0, Priority::LOW);
+    }
+
+    void ProcessEvent(const InnerEvent::Pointer &event) override
+    {
+        std::vector<EmitterCallback> callbacks;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = callbacks_.find(event->GetInnerEventId());
+            if (it == callbacks_.end()) {
+                return;
+            }
+            callbacks = it->second;
+        }
+        auto data = event->GetSharedObject<std::string>();
+        for (const auto &callback : callbacks) {
+            callback(data);
+        }
+    }
+
+private:
+    std::mutex mutex_;
+    std::map<uint32_t, std::vector<EmitterCallback>> callbacks_;
+};
+
+/*
+ * Time from emit on the benchmark thread until the subscribed callback is called.
+ */
+void EmitToCallback(benchmark::State &state)
+{
+    auto runner = EventRunner::Create(true);
+    auto emitter = std::make_shared<EmitterEventHandler>(runner);
+    Completion completion;
+    emitter->On(TARGET_EVENT_ID, [&completion](const std::shared_ptr<std::string> &data) {
+        benchmark::DoNotOptimize(data);
+        completion.Signal();
+    });
+    auto data = std::make_shared<std::string>("benchmark");
+    for (auto _ : state) {
+        completion.Reset();
+        auto start = Clock::now();
+        emitter->Emit(TARGET_EVENT_ID, data);
+        completion.Wait();
+        state.SetIterationTime(ElapsedSeconds(start));
+    }
+    runner->Stop();
+}
+}  // unnamed namespace
+
+BENCHMARK(QueueInsertAndGetEvent)->Arg(0)->Arg(64)->Arg(4096);
+BENCHMARK(PostTaskPingPong)->UseRealTime();
+BENCHMARK(WaitStrategyPingPong)
+    ->Arg(static_cast<int64_t>(WaitStrategy::BLOCK))
+    ->Arg(static_cast<int64_t>(WaitStrategy::SPIN_THEN_PARK))
+    ->Arg(static_cast<int64_t>(WaitStrategy::FUTEX))
+    ->UseRealTime();
+BENCHMARK(SendSyncEventRoundTrip)->UseRealTime();
+BENCHMARK(SyncWaiterRoundTrip)->Arg(0)->Arg(1)->UseRealTime();
+BENCHMARK(TaskResultRoundTrip)->Arg(0)->Arg(1)->Arg(2)->UseRealTime();
+#ifdef EVENT_HANDLER_COROUTINE_SUPPORT
+BENCHMARK(AsyncChain)->Arg(0)->Arg(1)->UseRealTime();
+#endif
+BENCHMARK(RunnerScale)
+    ->ArgsProduct({{static_cast<int64_t>(ThreadMode::NEW_THREAD), static_cast<int64_t>(ThreadMode::POOL)},
+        {10, 100, 1000}})
+    ->UseRealTime();
+BENCHMARK(ConcurrentRunnerScaling)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+BENCHMARK(RemoveByOwner)->Arg(16)->Arg(256)->Arg(4096);
+BENCHMARK(RemoveById)->Arg(16)->Arg(256)->Arg(4096);
+BENCHMARK(RemoveByName)->Arg(16)->Arg(256)->Arg(4096);
+BENCHMARK(EpollWakeupLatency)->UseManualTime();
+BENCHMARK(FileDescriptorDispatch)->Arg(0)->Arg(1)->UseManualTime();
+BENCHMARK(EmitToCallback)->UseManualTime();
+
+/*
+ * Results are written to eventhandler_benchmark.json unless '--benchmark_out' is given, so that runs of two builds
+ * can be compared with the compare.py tool of google benchmark.
+ */
+int main(int argc, char **argv)
+{
+    std::vector<char *> args(argv, argv + argc);
+    bool hasOutput = false;
+    for (int i = 1; i < argc; ++i) {
+        hasOutput = hasOutput || (strncmp(argv[i], "--benchmark_out=", strlen("--benchmark_out=")) == 0);
+    }
+    if (!hasOutput) {
+        args.push_back(const_cast<char *>(DEFAULT_OUTPUT.c_str()));
+        args.push_back(const_cast<char *>(DEFAULT_FORMAT.c_str()));
+    }
+    int count = static_cast<int>(args.size());
+    benchmark::Initialize(&count, args.data());
+    if (benchmark::ReportUnrecognizedArguments(count, args.data())) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "event_handler.h"
+#include "event_queue.h"
+#include "event_runner.h"
+
+using namespace OHOS::AppExecFwk;
+
+namespace {
+const int MAX_THREAD_NUM = 8;
+const double PERCENTILE_99 = 0.99;
+
+std::shared_ptr<EventHandler> CreateHandler(bool inboxEnabled)
+{
+    auto runner = EventRunner::Create(true);
+    runner->GetEventQueue()->SetInboxEnabled(inboxEnabled);
+    return std::make_shared<EventHandler>(runner);
+}
+
+std::shared_ptr<EventHandler> g_lockedHandler = CreateHandler(false);
+std::shared_ptr<EventHandler> g_inboxHandler = CreateHandler(true);
+
+/*
+ * Several threads keep posting tasks to one runner, which is busy running them at the same time.
+ * Arg 0 inserts events under the queue lock, arg 1 inserts events through the inbox.
+ */
+void MultiProducerPostTask(benchmark::State &state)
+{
+    auto &handler = (state.range(0) == 0) ? g_lockedHandler : g_inboxHandler;
+    std::vector<int64_t> latencies;
+    latencies.reserve(state.max_iterations);
+    for (auto _ : state) {
+        auto start = std::chrono::steady_clock::now();
+        handler->PostTask([]() {});
+        auto end = std::chrono::steady_clock::now();
+        latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    }
+    if (state.thread_index() == 0) {
+        // Wait for the runner to catch up, so that the backlog does not leak into the next run.
+        handler->PostSyncTask([]() {});
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (!latencies.empty()) {
+        auto p99 = latencies.begin() + static_cast<int64_t>((latencies.size() - 1) * PERCENTILE_99);
+        std::nth_element(latencies.begin(), p99, latencies.end());
+        state.counters["p99_enqueue_ns"] = benchmark::Counter(*p99, benchmark::Counter::kAvgThreads);
+    }
+}
+}  // unnamed namespace
+
+BENCHMARK(MultiProducerPostTask)->Arg(0)->Arg(1)->ThreadRange(1, MAX_THREAD_NUM)->UseRealTime();
+
+BENCHMARK_MAIN();
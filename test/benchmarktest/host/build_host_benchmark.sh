@@ -0,0 +1,64 @@
+#!/bin/bash
+# Copyright (c) 2026 Huawei Device Co., Ltd.
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Build benchmarks of libeventhandler on a plain Linux host, with the stand-in headers in 'include'.
+# Google benchmark must be installed, ffrt is not used.
+#
+# Usage: build_host_benchmark.sh [output dir] [benchmark dir under test/benchmarktest ...]
+# Example: build_host_benchmark.sh out event_handler_benchmark && out/event_handler_benchmark
+
+set -e
+
+HOST_DIR=$(cd "$(dirname "$0")" && pwd)
+ROOT_DIR=$(cd "${HOST_DIR}/../../.." && pwd)
+OUT_DIR=${1:-${ROOT_DIR}/out/host_benchmark}
+shift || true
+BENCHMARKS=${*:-event_handler_benchmark}
+
+CXX=${CXX:-c++}
+CXXFLAGS="-std=c++20 -O2 -g -Wno-attributes -include ${HOST_DIR}/include/host_compat.h -I${HOST_DIR}/include \
+    -I${ROOT_DIR}/interfaces/inner_api -I${ROOT_DIR}/frameworks/eventhandler/include ${CXXFLAGS}"
+
+mkdir -p "${OUT_DIR}/obj" "${OUT_DIR}/src"
+# Same sources as the device library, except the ffrt queue.
+SOURCES=$(sed -n 's|.*"${frameworks_path}/\(eventhandler/src/[a-z_]*\.cpp\)",|\1|p' \
+    "${ROOT_DIR}/frameworks/eventhandler/inner_api_sources.gni" | grep -v event_queue_ffrt)
+OBJECTS=""
+PIDS=""
+for source in ${SOURCES}; do
+    name=$(basename "${source}" .cpp)
+    # gcc rejects attributes after the declarator of a function definition, which clang of the device accepts.
+    sed 's/__attribute__((no_sanitize("cfi")))//' "${ROOT_DIR}/frameworks/${source}" > "${OUT_DIR}/src/${name}.cpp"
+    object="${OUT_DIR}/obj/${name}.o"
+    ${CXX} ${CXXFLAGS} -iquote "$(dirname "${ROOT_DIR}/frameworks/${source}")" -c "${OUT_DIR}/src/${name}.cpp" \
+        -o "${object}" &
+    PIDS="${PIDS} $!"
+    OBJECTS="${OBJECTS} ${object}"
+done
+# A bare 'wait' always succeeds, so wait for each compile to catch the failed ones.
+FAILED=0
+for pid in ${PIDS}; do
+    wait "${pid}" || FAILED=1
+done
+if [ "${FAILED}" -ne 0 ]; then
+    echo "failed to compile the eventhandler sources" >&2
+    exit 1
+fi
+ar rcs "${OUT_DIR}/libeventhandler_host.a" ${OBJECTS}
+
+for benchmark in ${BENCHMARKS}; do
+    ${CXX} ${CXXFLAGS} "${ROOT_DIR}"/test/benchmarktest/"${benchmark}"/*.cpp "${OUT_DIR}/libeventhandler_host.a" \
+        -lbenchmark -lpthread -o "${OUT_DIR}/${benchmark}"
+    echo "built ${OUT_DIR}/${benchmark}"
+done
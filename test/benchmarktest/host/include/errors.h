@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BASE_EVENTHANDLER_TEST_BENCHMARKTEST_HOST_ERRORS_H
+#define BASE_EVENTHANDLER_TEST_BENCHMARKTEST_HOST_ERRORS_H
+
+// Stand-in for the error codes of c_utils on a plain Linux host.
+namespace OHOS {
+using ErrCode = int;
+
+enum {
+    SUBSYS_APPEXECFWK = 3,
+};
+
+enum {
+    APPEXECFWK_MODULE_EVENT_HANDLER = 1,
+};
+
+constexpr ErrCode ERR_OK = 0;
+
+constexpr ErrCode ErrCodeOffset(unsigned int subsystem, unsigned int module = 0)
+{
+    return (subsystem << 21) | (module << 16);
+}
+}  // namespace OHOS
+
+#endif  // #ifndef BASE_EVENTHANDLER_TEST_BENCHMARKTEST_HOST_ERRORS_H
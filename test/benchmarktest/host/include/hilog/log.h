@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BASE_EVENTHANDLER_TEST_BENCHMARKTEST_HOST_HILOG_LOG_H
+#define BASE_EVENTHANDLER_TEST_BENCHMARKTEST_HOST_HILOG_LOG_H
+
+#include <cstdio>
+
+// Stand-in for hilog on a plain Linux host, only errors are printed so that logging does not skew the results.
+typedef enum { LOG_APP = 0, LOG_INIT = 1, LOG_CORE = 3 } LogType;
+typedef enum { LOG_DEBUG = 3, LOG_INFO = 4, LOG_WARN = 5, LOG_ERROR = 6, LOG_FATAL = 7 } LogLevel;
+
+inline bool HiLogIsLoggable(unsigned int, const char *, LogLevel level)
+{
+    return level >= LOG_ERROR;
+}
+
+#define HILOG_IMPL(type, level, domain, tag, fmt, ...) \
+    (HiLogIsLoggable(domain, tag, level) ? fprintf(stderr, "[%s] " fmt "\n", tag, ##__VA_ARGS__) : 0)
+
+#endif  // #ifndef BASE_EVENTHANDLER_TEST_BENCHMARKTEST_HOST_HILOG_LOG_H
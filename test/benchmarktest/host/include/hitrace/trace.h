@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BASE_EVENTHANDLER_TEST_BENCHMARKTEST_HOST_HITRACE_TRACE_H
+#define BASE_EVENTHANDLER_TEST_BENCHMARKTEST_HOST_HITRACE_TRACE_H
+
+#include <cstdint>
+
+// Stand-in for hitrace on a plain Linux host, trace chains are never valid.
+#define HITRACE_FLAG_INCLUDE_ASYNC 1
+
+enum HiTraceTracepointType {
+    HITRACE_TP_CS = 0,
+    HITRACE_TP_CR = 1,
+    HITRACE_TP_SS = 2,
+    HITRACE_TP_SR = 3,
+    HITRACE_TP_GENERAL = 4,
+};
+
+namespace OHOS {
+namespace HiviewDFX {
+class HiTraceId {
+public:
+    bool IsValid() const
+    {
+        return false;
+    }
+
+    bool IsFlagEnabled(int) const
+    {
+        return false;
+    }
+
+    uint64_t GetChainId() const
+    {
+        return 0;
+    }
+};
+
+class HiTraceChain {
+public:
+    static HiTraceId GetId()
+    {
+        return HiTraceId();
+    }
+
+    static HiTraceId CreateSpan()
+    {
+        return HiTraceId();
+    }
+
+    static void SetId(const HiTraceId &)
+    {}
+
+    static void ClearId()
+    {}
+
+    template<typename... Args>
+    static void Tracepoint(HiTraceTracepointType, const HiTraceId &, const char *, Args...)
+    {}
+};
+}  // namespace HiviewDFX
+}  // namespace OHOS
+
+#endif  // #ifndef BASE_EVENTHANDLER_TEST_BENCHMARKTEST_HOST_HITRACE_TRACE_H
@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BASE_EVENTHANDLER_TEST_BENCHMARKTEST_HOST_HOST_COMPAT_H
+#define BASE_EVENTHANDLER_TEST_BENCHMARKTEST_HOST_HOST_COMPAT_H
+
+#include <cstdint>
+
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// Bionic and musl extensions used by libeventhandler, which glibc does not have. Forced in with '-include'.
+extern "C" {
+inline int fdsan_close_with_tag(int fd, uint64_t)
+{
+    return close(fd);
+}
+
+inline void fdsan_exchange_owner_tag(int, uint64_t, uint64_t)
+{}
+
+inline pid_t getproctid()
+{
+    return static_cast<pid_t>(syscall(SYS_gettid));
+}
+}
+
+typedef void (*ffrt_poller_cb)(void *data, uint32_t event);
+
+#endif  // #ifndef BASE_EVENTHANDLER_TEST_BENCHMARKTEST_HOST_HOST_COMPAT_H
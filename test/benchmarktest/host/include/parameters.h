@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BASE_EVENTHANDLER_TEST_BENCHMARKTEST_HOST_PARAMETERS_H
+#define BASE_EVENTHANDLER_TEST_BENCHMARKTEST_HOST_PARAMETERS_H
+
+#include <string>
+
+// Stand-in for system parameters on a plain Linux host, default values are always used.
+namespace OHOS {
+namespace system {
+template<typename T>
+inline T GetIntParameter(const std::string &, T defaultValue)
+{
+    return defaultValue;
+}
+
+template<typename T>
+inline T GetIntParameter(const std::string &, T defaultValue, T, T)
+{
+    return defaultValue;
+}
+
+inline bool GetBoolParameter(const std::string &, bool defaultValue)
+{
+    return defaultValue;
+}
+
+inline std::string GetParameter(const std::string &, const std::string &defaultValue)
+{
+    return defaultValue;
+}
+}  // namespace system
+}  // namespace OHOS
+
+#endif  // #ifndef BASE_EVENTHANDLER_TEST_BENCHMARKTEST_HOST_PARAMETERS_H
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BASE_EVENTHANDLER_TEST_BENCHMARKTEST_HOST_SECUREC_H
+#define BASE_EVENTHANDLER_TEST_BENCHMARKTEST_HOST_SECUREC_H
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+// Stand-in for bounds_checking_function on a plain Linux host.
+#define EOK 0
+
+inline int memset_s(void *dest, size_t destMax, int c, size_t count)
+{
+    if (count > destMax) {
+        return -1;
+    }
+    memset(dest, c, count);
+    return EOK;
+}
+
+inline int memcpy_s(void *dest, size_t destMax, const void *src, size_t count)
+{
+    if (count > destMax) {
+        return -1;
+    }
+    memcpy(dest, src, count);
+    return EOK;
+}
+
+inline int strcpy_s(char *dest, size_t destMax, const char *src)
+{
+    if (strlen(src) >= destMax) {
+        return -1;
+    }
+    memcpy(dest, src, strlen(src) + 1);
+    return EOK;
+}
+
+inline int snprintf_s(char *dest, size_t destMax, size_t, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    int ret = vsnprintf(dest, destMax, format, args);
+    va_end(args);
+    return ret;
+}
+
+inline int sprintf_s(char *dest, size_t destMax, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    int ret = vsnprintf(dest, destMax, format, args);
+    va_end(args);
+    return ret;
+}
+
+#endif  // #ifndef BASE_EVENTHANDLER_TEST_BENCHMARKTEST_HOST_SECUREC_H
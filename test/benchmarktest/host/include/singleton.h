@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BASE_EVENTHANDLER_TEST_BENCHMARKTEST_HOST_SINGLETON_H
+#define BASE_EVENTHANDLER_TEST_BENCHMARKTEST_HOST_SINGLETON_H
+
+#include "nocopyable.h"
+
+// Stand-in for the singleton templates of c_utils on a plain Linux host.
+namespace OHOS {
+#define DECLARE_DELAYED_REF_SINGLETON(MyClass) \
+public:                                        \
+    ~MyClass();                                \
+private:                                       \
+    friend DelayedRefSingleton<MyClass>;       \
+    MyClass();
+
+template<typename T>
+class DelayedRefSingleton {
+public:
+    static T &GetInstance()
+    {
+        // Never destroyed, same as the device implementation which outlives all runners.
+        static T *instance = new T();
+        return *instance;
+    }
+};
+}  // namespace OHOS
+
+#endif  // #ifndef BASE_EVENTHANDLER_TEST_BENCHMARKTEST_HOST_SINGLETON_H
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <random>
+
+#include "inner_event.h"
+#include "pending_event_store.h"
+
+using namespace OHOS::AppExecFwk;
+
+namespace {
+const uint32_t RANDOM_SEED = 20260101;
+const int64_t MAX_DELAY_US = 1000000;
+
+/*
+ * Keep 'pending' events in the store, each iteration picks the first event and inserts it again with a random delay,
+ * which is what a busy timer queue does.
+ */
+void BenchmarkInsertAndPick(benchmark::State &state, PendingEventStore::Type type)
+{
+    auto store = PendingEventStore::Create(type);
+    const int64_t pending = state.range(0);
+    std::mt19937 random(RANDOM_SEED);
+    std::uniform_int_distribution<int64_t> delay(0, MAX_DELAY_US);
+    auto now = InnerEvent::Clock::now();
+    // Fill in handle time order, so that filling does not dominate the setup time of the list store.
+    for (int64_t i = 0; i < pending; ++i) {
+        auto event = InnerEvent::Get(static_cast<uint32_t>(i));
+        event->SetHandleTime(now + std::chrono::microseconds(i * MAX_DELAY_US / pending));
+        store->Insert(event, EventInsertType::AT_END);
+    }
+
+    for (auto _ : state) {
+        auto event = store->PopFront();
+        now = event->GetHandleTime();
+        event->SetHandleTime(now + std::chrono::microseconds(delay(random)));
+        store->Insert(event, EventInsertType::AT_END);
+        benchmark::DoNotOptimize(store->Front());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void ListInsertAndPick(benchmark::State &state)
+{
+    BenchmarkInsertAndPick(state, PendingEventStore::Type::LIST);
+}
+
+void HeapInsertAndPick(benchmark::State &state)
+{
+    BenchmarkInsertAndPick(state, PendingEventStore::Type::HEAP);
+}
+}  // unnamed namespace
+
+BENCHMARK(ListInsertAndPick)->Arg(10)->Arg(1000)->Arg(100000);
+BENCHMARK(HeapInsertAndPick)->Arg(10)->Arg(1000)->Arg(100000);
+
+BENCHMARK_MAIN();
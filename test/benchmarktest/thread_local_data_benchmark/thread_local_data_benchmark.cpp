@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "thread_local_data.h"
+
+using namespace OHOS::AppExecFwk;
+
+namespace {
+const int MAX_THREAD_NUM = 64;
+
+// The previous implementation of ThreadLocalData, kept here as the baseline.
+template<typename T>
+class MutexMapData {
+public:
+    inline T Current() const
+    {
+        std::lock_guard<std::mutex> lock(mapLock_);
+        auto it = dataMap_.find(std::this_thread::get_id());
+        if (it == dataMap_.end()) {
+            return T();
+        }
+        return it->second;
+    }
+
+    inline void Save(const T &data)
+    {
+        std::lock_guard<std::mutex> lock(mapLock_);
+        dataMap_[std::this_thread::get_id()] = data;
+    }
+
+    inline void Discard()
+    {
+        std::lock_guard<std::mutex> lock(mapLock_);
+        (void)dataMap_.erase(std::this_thread::get_id());
+    }
+
+private:
+    mutable std::mutex mapLock_;
+    std::unordered_map<std::thread::id, T> dataMap_;
+};
+
+std::shared_ptr<int> g_runner = std::make_shared<int>(0);
+MutexMapData<std::weak_ptr<int>> g_mutexMapData;
+ThreadLocalData<std::weak_ptr<int>> g_threadLocalData;
+
+/*
+ * Each thread saves its data once, then keeps reading it, which is what EventRunner::Current() does.
+ */
+void MutexMapRead(benchmark::State &state)
+{
+    g_mutexMapData.Save(g_runner);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(g_mutexMapData.Current().lock());
+    }
+    g_mutexMapData.Discard();
+    state.SetItemsProcessed(state.iterations());
+}
+
+void ThreadLocalRead(benchmark::State &state)
+{
+    g_threadLocalData = g_runner;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(static_cast<std::weak_ptr<int>>(g_threadLocalData).lock());
+    }
+    g_threadLocalData = nullptr;
+    state.SetItemsProcessed(state.iterations());
+}
+}  // unnamed namespace
+
+BENCHMARK(MutexMapRead)->ThreadRange(1, MAX_THREAD_NUM)->UseRealTime();
+BENCHMARK(ThreadLocalRead)->ThreadRange(1, MAX_THREAD_NUM)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include "event_handler.h"
+#include "event_queue.h"
+#include "event_runner.h"
+#include "file_descriptor_listener.h"
+
+using namespace OHOS::AppExecFwk;
+
+namespace {
+const int64_t ITERATIONS = 100;
+const int64_t MIN_DELAY_US = 100;
+const int64_t MAX_DELAY_US = 10000;
+const int64_t DELAY_MULTIPLIER = 10;
+const double PERCENTILE_50 = 0.5;
+const double PERCENTILE_99 = 0.99;
+// Upper bounds of lateness buckets, in microseconds.
+const std::vector<int64_t> LATENESS_BUCKETS_US = {50, 200, 1000};
+
+class IdleListener : public FileDescriptorListener {};
+
+/*
+ * The runner listens to an idle eventfd, so that it waits with epoll like the main thread does.
+ * Arg 0 is the delay in microseconds, arg 1 enables high resolution waiting.
+ */
+void DelayedTaskLateness(benchmark::State &state)
+{
+    auto runner = EventRunner::Create(true);
+    auto handler = std::make_shared<EventHandler>(runner);
+    int32_t fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    (void)handler->AddFileDescriptorListener(fd, FILE_DESCRIPTOR_INPUT_EVENT, std::make_shared<IdleListener>(),
+        "TimerPrecisionBenchmark");
+    runner->GetEventQueue()->SetHighResolutionWait(state.range(1) != 0);
+    const std::chrono::microseconds delay(state.range(0));
+
+    std::mutex lock;
+    std::condition_variable condition;
+    bool done = false;
+    std::vector<int64_t> lateness;
+    lateness.reserve(ITERATIONS);
+    for (auto _ : state) {
+        done = false;
+        auto expected = InnerEvent::Clock::now() + delay;
+        handler->PostTask([&]() {
+            auto late = std::chrono::duration_cast<std::chrono::microseconds>(InnerEvent::Clock::now() - expected);
+            std::lock_guard<std::mutex> guard(lock);
+            lateness.push_back(late.count());
+            done = true;
+            condition.notify_one();
+        }, delay);
+        std::unique_lock<std::mutex> guard(lock);
+        condition.wait(guard, [&done]() { return done; });
+    }
+    handler->RemoveAllFileDescriptorListeners();
+    runner->Stop();
+    close(fd);
+
+    if (lateness.empty()) {
+        return;
+    }
+    std::sort(lateness.begin(), lateness.end());
+    auto percentile = [&lateness](double p) {
+        return lateness[static_cast<size_t>((lateness.size() - 1) * p)];
+    };
+    state.counters["p50_late_us"] = percentile(PERCENTILE_50);
+    state.counters["p99_late_us"] = percentile(PERCENTILE_99);
+    state.counters["max_late_us"] = lateness.back();
+    // Fraction of tasks in each lateness bucket.
+    size_t begin = 0;
+    for (int64_t bound : LATENESS_BUCKETS_US) {
+        size_t end = std::lower_bound(lateness.begin(), lateness.end(), bound) - lateness.begin();
+        state.counters["late_lt_" + std::to_string(bound) + "us"] =
+            benchmark::Counter(end - begin, benchmark::Counter::kAvgIterations);
+        begin = end;
+    }
+    state.counters["late_ge_" + std::to_string(LATENESS_BUCKETS_US.back()) + "us"] =
+        benchmark::Counter(lateness.size() - begin, benchmark::Counter::kAvgIterations);
+}
+}  // unnamed namespace
+
+BENCHMARK(DelayedTaskLateness)
+    ->ArgsProduct({benchmark::CreateRange(MIN_DELAY_US, MAX_DELAY_US, DELAY_MULTIPLIER), {0, 1}})
+    ->Iterations(ITERATIONS)->UseRealTime();
+
+BENCHMARK_MAIN();